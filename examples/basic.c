@@ -6,19 +6,24 @@
 
 int main(int argc, char *argv[])
 {
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <file.toml> [output]\n", argv[0]);
+        return 0;
+    }
 
-    char *file = NULL;
-    if (argc > 1)
-        file = argv[1];
-    TomlKey *toml = tomlLoadFile(file);
+    TomlKey *toml = toml_load_file_name(argv[1]);
     if (toml == NULL)
         return 1;
-    // char *buffer = "";
+    // char *buffer = NULL;
     // size_t size = 0;
-    // toml_key_dump(toml, &buffer, &size);
+    // toml_key_dump_buffer(toml, &buffer, &size);
     // printf(buffer);
-    tomlKeyDumpFile(toml, argv[2]);
-    tomlFree(toml);
+    if (argc > 2)
+        toml_key_dump_file_name(toml, argv[2]);
+    else
+        toml_key_dump_file(toml, stdout);
+    toml_free(toml);
     return 0;
 }
 
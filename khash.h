@@ -47,6 +47,12 @@ int main() {
 */
 
 /*
+  Local changes:
+
+    * Memory goes through kcalloc(), kmalloc(), krealloc() and kfree()
+    * kh_resize() returns -1 and kh_put() sets *ret to -1, returning
+      kh_end(), when memory runs out; the table is left as it was
+
   2009-09-26 (0.2.4):
 
     * Improve portability
@@ -116,6 +122,19 @@ typedef unsigned long long khint64_t;
 typedef khint32_t khint_t;
 typedef khint_t khiter_t;
 
+#ifndef kcalloc
+#define kcalloc(N, Z) calloc(N, Z)
+#endif
+#ifndef kmalloc
+#define kmalloc(Z) malloc(Z)
+#endif
+#ifndef krealloc
+#define krealloc(P, Z) realloc(P, Z)
+#endif
+#ifndef kfree
+#define kfree(P) free(P)
+#endif
+
 #define __ac_HASH_PRIME_SIZE 32
 static const khint32_t __ac_prime_list[__ac_HASH_PRIME_SIZE] =
     {
@@ -147,16 +166,16 @@ static const double __ac_HASH_UPPER = 0.77;
   } kh_##name##_t;                                                                                        \
   static inline kh_##name##_t *kh_init_##name()                                                           \
   {                                                                                                       \
-    return (kh_##name##_t *)calloc(1, sizeof(kh_##name##_t));                                             \
+    return (kh_##name##_t *)kcalloc(1, sizeof(kh_##name##_t));                                            \
   }                                                                                                       \
   static inline void kh_destroy_##name(kh_##name##_t *h)                                                  \
   {                                                                                                       \
     if (h)                                                                                                \
     {                                                                                                     \
-      free(h->keys);                                                                                      \
-      free(h->flags);                                                                                     \
-      free(h->vals);                                                                                      \
-      free(h);                                                                                            \
+      kfree(h->keys);                                                                                     \
+      kfree(h->flags);                                                                                    \
+      kfree(h->vals);                                                                                     \
+      kfree(h);                                                                                           \
     }                                                                                                     \
   }                                                                                                       \
   static inline void kh_clear_##name(kh_##name##_t *h)                                                    \
@@ -190,7 +209,7 @@ static const double __ac_HASH_UPPER = 0.77;
     else                                                                                                  \
       return 0;                                                                                           \
   }                                                                                                       \
-  static inline void kh_resize_##name(kh_##name##_t *h, khint_t new_n_buckets)                            \
+  static inline int kh_resize_##name(kh_##name##_t *h, khint_t new_n_buckets)                             \
   {                                                                                                       \
     khint32_t *new_flags = 0;                                                                             \
     khint_t j = 1;                                                                                        \
@@ -203,13 +222,29 @@ static const double __ac_HASH_UPPER = 0.77;
         j = 0;                                                                                            \
       else                                                                                                \
       {                                                                                                   \
-        new_flags = (khint32_t *)malloc(((new_n_buckets >> 4) + 1) * sizeof(khint32_t));                  \
+        new_flags = (khint32_t *)kmalloc(((new_n_buckets >> 4) + 1) * sizeof(khint32_t));                 \
+        if (!new_flags)                                                                                   \
+          return -1;                                                                                      \
         memset(new_flags, 0xaa, ((new_n_buckets >> 4) + 1) * sizeof(khint32_t));                          \
         if (h->n_buckets < new_n_buckets)                                                                 \
         {                                                                                                 \
-          h->keys = (khkey_t *)realloc(h->keys, new_n_buckets * sizeof(khkey_t));                         \
+          khkey_t *new_keys = (khkey_t *)krealloc(h->keys, new_n_buckets * sizeof(khkey_t));              \
+          if (!new_keys)                                                                                  \
+          {                                                                                               \
+            kfree(new_flags);                                                                             \
+            return -1;                                                                                    \
+          }                                                                                               \
+          h->keys = new_keys;                                                                             \
           if (kh_is_map)                                                                                  \
-            h->vals = (khval_t *)realloc(h->vals, new_n_buckets * sizeof(khval_t));                       \
+          {                                                                                               \
+            khval_t *new_vals = (khval_t *)krealloc(h->vals, new_n_buckets * sizeof(khval_t));            \
+            if (!new_vals)                                                                                \
+            {                                                                                             \
+              kfree(new_flags);                                                                           \
+              return -1;                                                                                  \
+            }                                                                                             \
+            h->vals = new_vals;                                                                           \
+          }                                                                                               \
         }                                                                                                 \
       }                                                                                                   \
     }                                                                                                     \
@@ -265,26 +300,31 @@ static const double __ac_HASH_UPPER = 0.77;
       }                                                                                                   \
       if (h->n_buckets > new_n_buckets)                                                                   \
       {                                                                                                   \
-        h->keys = (khkey_t *)realloc(h->keys, new_n_buckets * sizeof(khkey_t));                           \
+        h->keys = (khkey_t *)krealloc(h->keys, new_n_buckets * sizeof(khkey_t));                          \
         if (kh_is_map)                                                                                    \
-          h->vals = (khval_t *)realloc(h->vals, new_n_buckets * sizeof(khval_t));                         \
+          h->vals = (khval_t *)krealloc(h->vals, new_n_buckets * sizeof(khval_t));                        \
       }                                                                                                   \
-      free(h->flags);                                                                                     \
+      kfree(h->flags);                                                                                    \
       h->flags = new_flags;                                                                               \
       h->n_buckets = new_n_buckets;                                                                       \
       h->n_occupied = h->size;                                                                            \
       h->upper_bound = (khint_t)(h->n_buckets * __ac_HASH_UPPER + 0.5);                                   \
     }                                                                                                     \
+    return 0;                                                                                             \
   }                                                                                                       \
   static inline khint_t kh_put_##name(kh_##name##_t *h, khkey_t key, int *ret)                            \
   {                                                                                                       \
     khint_t x;                                                                                            \
     if (h->n_occupied >= h->upper_bound)                                                                  \
     {                                                                                                     \
-      if (h->n_buckets > (h->size << 1))                                                                  \
-        kh_resize_##name(h, h->n_buckets - 1);                                                            \
-      else                                                                                                \
-        kh_resize_##name(h, h->n_buckets + 1);                                                            \
+      int resized = h->n_buckets > (h->size << 1)                                                         \
+                        ? kh_resize_##name(h, h->n_buckets - 1)                                           \
+                        : kh_resize_##name(h, h->n_buckets + 1);                                          \
+      if (resized < 0)                                                                                    \
+      {                                                                                                   \
+        *ret = -1;                                                                                        \
+        return h->n_buckets;                                                                              \
+      }                                                                                                   \
     }                                                                                                     \
     {                                                                                                     \
       khint_t inc, k, i, site, last;                                                                      \
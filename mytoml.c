@@ -52,15 +52,64 @@
 // [SECTION] INCLUDES
 //-------------------------------------------------------------------------
 
+// expose POSIX/BSD extensions (strdup, mmap flags, madvise) on strict C
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
 #include "mytoml.h"
 
+#include <float.h>   // for FLT_EVAL_METHOD
+#include <limits.h>  // for USHRT_MAX INT_MAX
 #include <math.h>    //
-#include <stdarg.h>  //
 #include <stdbool.h> //
+#include <stddef.h>  // for offsetof
+#include <stdint.h>  // for UINT32_MAX uintptr_t int64_t
 #include <stdio.h>   // for printf
 #include <stdlib.h>  // for realloc
 #include <string.h>  // for strdup strlen
-#include <time.h>    //
+
+#if MYTOML_PLATFORM_IS(LINUX) || MYTOML_PLATFORM_IS(APPLE)
+#include <sys/stat.h> // for fstat
+#endif
+
+#if MYTOML_USE_MMAP && (MYTOML_PLATFORM_IS(LINUX) || MYTOML_PLATFORM_IS(APPLE))
+#include <fcntl.h>    // for open
+#include <sys/mman.h> // for mmap madvise
+#include <unistd.h>   // for close
+#endif
+
+// pipes are read a byte at a time, take the stream lock once per refill
+// rather than once per byte
+#if MYTOML_PLATFORM_IS(LINUX) || MYTOML_PLATFORM_IS(APPLE)
+#define _mytoml_lock_file(F) flockfile(F)
+#define _mytoml_getc(F) getc_unlocked(F)
+#define _mytoml_unlock_file(F) funlockfile(F)
+#elif MYTOML_PLATFORM_IS(WINDOWS)
+#define _mytoml_lock_file(F) _lock_file(F)
+#define _mytoml_getc(F) _getc_nolock(F)
+#define _mytoml_unlock_file(F) _unlock_file(F)
+#else
+#define _mytoml_lock_file(F) ((void)(F))
+#define _mytoml_getc(F) getc(F)
+#define _mytoml_unlock_file(F) ((void)(F))
+#endif
+
+#if MYTOML_USE_SIMD && defined(__x86_64__) && \
+    (MYTOML_COMPILER_IS(GCC) || MYTOML_COMPILER_IS(CLANG))
+#define MYTOML_SIMD_X86 1
+#include <immintrin.h> // for SSE2 AVX2
+#else
+#define MYTOML_SIMD_X86 0
+#endif
+
+// khash allocates through the document arena, see `_mytoml_kmalloc`
+#define kcalloc(N, Z) _mytoml_kcalloc(N, Z)
+#define kmalloc(Z) _mytoml_kmalloc(Z)
+#define krealloc(P, Z) _mytoml_krealloc(P, Z)
+#define kfree(P) _mytoml_kfree(P)
+
+#include "khash.h"
 
 #pragma region Internal
 
@@ -114,51 +163,125 @@
   } while (0)
 
 /**
- * @def CHECK_DATETIME
- * @brief Macro to check date and time.
- * @param VAR variable to check.
- * @param LEN expected variable lenght.
- * @note returns NULL from the location where it is called.
+ * @def MYTOML_STREAM_HISTORY
+ * @brief Bytes kept in front of a refilled stream window.
+ * @note Must cover the `prev` and `prev_prev` tokens before the cursor.
  */
-#define CHECK_DATETIME(VAR, LEN, ...)                  \
-  do                                                   \
-  {                                                    \
-    RETURN_IF_FAILED(strlen(VAR) == LEN, __VA_ARGS__); \
-    num = strtoul(VAR, &end, 10);                      \
-    RETURN_IF_FAILED(end == VAR + LEN, __VA_ARGS__);   \
-  } while (0)
+#define MYTOML_STREAM_HISTORY 64
 
 /**
- * @def CHECK_DATE
- * @brief Macro to check date.
- * @note This macro is used in check/validate year, month and day.
+ * @def MYTOML_ARRAY_MIN_CAPACITY
+ * @brief Slots allocated for an array when its first value is added.
+ * @note Capacity doubles every time the array fills up. Must be a power of
+ * two, the capacity is worked out from the length.
  */
-#define CHECK_DATE()                           \
-  do                                           \
-  {                                            \
-    CHECK_DATETIME(year, 4, "invalid year\n"); \
-    time->tm_year = num - 1900;                \
-    CHECK_DATETIME(mon, 2, "invalid month\n"); \
-    time->tm_mon = num - 1;                    \
-    CHECK_DATETIME(mday, 2, "invalid day\n");  \
-    time->tm_mday = num;                       \
-  } while (0)
+#define MYTOML_ARRAY_MIN_CAPACITY 4
 
 /**
- * @def CHECK_TIME
- * @brief Macro to check time.
- * @note This macro is used in check/validate hour, minute and seconds.
+ * @def MYTOML_FLOAT_MIN_POW10
+ * @brief Smallest decimal exponent with an entry in the power of five table.
+ * @note Anything below rounds to zero, whatever the digits.
  */
-#define CHECK_TIME()                            \
-  do                                            \
-  {                                             \
-    CHECK_DATETIME(hour, 2, "invalid hour\n");  \
-    time->tm_hour = num;                        \
-    CHECK_DATETIME(min, 2, "invalid minute\n"); \
-    time->tm_min = num;                         \
-    CHECK_DATETIME(sec, 2, "invalid second\n"); \
-    time->tm_sec = num;                         \
-  } while (0)
+#define MYTOML_FLOAT_MIN_POW10 -342
+
+/**
+ * @def MYTOML_FLOAT_MAX_POW10
+ * @brief Largest decimal exponent with an entry in the power of five table.
+ * @note Anything above overflows to infinity.
+ */
+#define MYTOML_FLOAT_MAX_POW10 308
+
+/**
+ * @def MYTOML_FLOAT_DECIMAL_DIGITS
+ * @brief Digits kept by the exact decimal conversion of a float.
+ * @note A double can need 767 significant digits to round correctly, past
+ * those only whether a digit is zero matters.
+ */
+#define MYTOML_FLOAT_DECIMAL_DIGITS 800
+
+/**
+ * @def MYTOML_FLOAT_FORMAT_MIN_POW10
+ * @brief Smallest power of ten the float formatter scales by.
+ */
+#define MYTOML_FLOAT_FORMAT_MIN_POW10 -292
+
+/**
+ * @def MYTOML_FLOAT_FORMAT_MAX_POW10
+ * @brief Largest power of ten the float formatter scales by.
+ */
+#define MYTOML_FLOAT_FORMAT_MAX_POW10 324
+
+/**
+ * @def MYTOML_NUMBER_FORMAT_SIZE
+ * @brief Bytes to hold any integer or float the serializer writes.
+ */
+#define MYTOML_NUMBER_FORMAT_SIZE 32
+
+/**
+ * @def MYTOML_DATETIME_FORMAT_SIZE
+ * @brief Bytes to hold any datetime the serializer writes.
+ */
+#define MYTOML_DATETIME_FORMAT_SIZE 40
+
+/**
+ * @def MYTOML_SCRATCH_MIN_CAPACITY
+ * @brief Bytes allocated for the parser scratch buffer on first use.
+ * @note Capacity doubles every time a value does not fit.
+ */
+#define MYTOML_SCRATCH_MIN_CAPACITY 256
+
+/**
+ * @def MYTOML_ARENA_ALIGN
+ * @brief Alignment of every arena allocation.
+ */
+#define MYTOML_ARENA_ALIGN 16
+
+/**
+ * @def MYTOML_ARENA_ROUND
+ * @brief Round `N` up to a multiple of `MYTOML_ARENA_ALIGN`.
+ */
+#define MYTOML_ARENA_ROUND(N) \
+  (((N) + MYTOML_ARENA_ALIGN - 1) & ~(size_t)(MYTOML_ARENA_ALIGN - 1))
+
+/**
+ * @def MYTOML_FROZEN_MAGIC
+ * @brief First bytes of a frozen document.
+ */
+#define MYTOML_FROZEN_MAGIC "MTF1"
+
+/**
+ * @def MYTOML_FROZEN_VERSION
+ * @brief Layout of a frozen document, bumped when it changes.
+ * @note Documents without the field count as version 1.
+ */
+#define MYTOML_FROZEN_VERSION 2
+
+/**
+ * @def MYTOML_FROZEN_MAX_DEPTH
+ * @brief Deepest nesting of arrays and tables in a frozen document.
+ * @details Bounds the recursion of `toml_freeze` and `toml_frozen_load`.
+ */
+#define MYTOML_FROZEN_MAX_DEPTH 1024
+
+/**
+ * @def MYTOML_FROZEN_ALIGN
+ * @brief Alignment of every piece of a frozen document.
+ */
+#define MYTOML_FROZEN_ALIGN 8
+
+/**
+ * @def MYTOML_THREAD_LOCAL
+ * @brief Storage class for per-thread parser state.
+ */
+#if defined(__cplusplus) && __cplusplus >= 201103L
+#define MYTOML_THREAD_LOCAL thread_local
+#elif MYTOML_COMPILER_IS(MSVC)
+#define MYTOML_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define MYTOML_THREAD_LOCAL _Thread_local
+#else
+#define MYTOML_THREAD_LOCAL __thread
+#endif
 
 //-----------------------------------------------------------------------------
 // [SECTION] Data Structures
@@ -172,13 +295,14 @@
 
 /*
     Struct `tokenizer` handles the input stream
-    by reading and returning tokens for the parser.
-    However, this currently returns each character
-    as a token. It allows each state of the parser
-    to determine if it is an acceptable token, and
-    stop parsing as soon as it is not.
-
-    TODO: Refactor to parse tokens instead of characters
+    by reading and returning characters for the parser.
+    The lexer sits on top of it and scans whole tokens
+    (whitespace, newlines, comments, bare keys, simple
+    strings and number spans) straight from the input
+    buffer, so the parser dispatches once per token and
+    skips over it in one step. Escaped and multi-line
+    strings, numbers and datetimes are still read one
+    character at a time.
 */
 
 /**
@@ -195,6 +319,21 @@ typedef enum InputType
 
 } InputType;
 
+/**
+ * @enum InputStorage
+ * @brief Enumerates who owns the memory behind an input buffer.
+ * @details Used to decide how the buffer is released once parsing is done.
+ */
+typedef enum InputStorage
+{
+
+  S_BUFFER,   /**< Heap buffer owned by the tokenizer */
+  S_MAPPED,   /**< Memory-mapped file owned by the tokenizer */
+  S_BORROWED, /**< Caller-owned buffer, never written to or freed */
+  S_CHUNKED   /**< Refillable window over `file.pointer`, owned by the tokenizer */
+
+} InputStorage;
+
 /**
  * @name Parser Input type
  * @{
@@ -214,11 +353,85 @@ typedef struct Input
     FILE *pointer;    /**< The `FILE*` file input pointer. */
   } file;
 
-  char *stream; /**< Pointer for storing the input buffer */
+  const char *stream;   /**< Pointer for storing the input buffer */
+  size_t length;        /**< The number of bytes in `stream` */
+  size_t base;          /**< Input offset of `stream[0]` (chunked input) */
+  InputStorage storage; /**< Who owns the memory behind `stream` */
+  bool owns_file;       /**< Whether `file.pointer` is closed with the tokenizer */
+  size_t capacity;      /**< The number of bytes allocated for `stream` */
+  bool eof;             /**< Whether `file.pointer` has no more input */
+  bool failed;          /**< Whether reading `file.pointer` failed */
+  bool regular;         /**< Whether `file.pointer` is a regular file */
+  size_t limit;         /**< The maximum input size in bytes, 0 for none */
 } Input;
 
 /** @} */
 
+/**
+ * @name Key hash tables
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif //__cplusplus
+
+  /** khash allocation hooks, see `kcalloc` and friends. */
+  void *_mytoml_kcalloc(size_t n, size_t size);
+  void *_mytoml_kmalloc(size_t size);
+  void *_mytoml_krealloc(void *ptr, size_t size);
+  void _mytoml_kfree(void *ptr);
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
+/** X31 hash of `len` bytes of `s`, same as `kh_str_hash_func`. */
+static inline khint_t _mytoml_id_hash_bytes(const char *s, size_t len)
+{
+  khint_t h = 0;
+  for (size_t i = 0; i < len; i++)
+    h = (h << 5) - h + (khint_t)(unsigned char)s[i];
+  return h;
+}
+
+/** Hash of `id`, computed once when the id was created. */
+static inline khint_t _mytoml_id_hash(TomlId id) { return id.hash; }
+
+/**
+ * Whether `a` and `b` hold the same bytes. Interned ids match on the
+ * pointer alone, the byte compare is only reached by outside lookups.
+ */
+static inline bool _mytoml_id_equal(TomlId a, TomlId b)
+{
+  return a.str == b.str || (a.hash == b.hash && a.len == b.len &&
+                            memcmp(a.str, b.str, a.len) == 0);
+}
+
+/**
+ * @brief Map from id to subkey, see `TomlKeyTable`.
+ */
+KHASH_INIT(id, TomlId, TomlKey *, 1, _mytoml_id_hash, _mytoml_id_equal)
+
+/**
+ * @brief Set of the key ids seen so far in a document.
+ */
+KHASH_INIT(atom, TomlId, char, 0, _mytoml_id_hash, _mytoml_id_equal)
+
+/**
+ * @struct TomlKeyTable
+ * @brief Subkeys of a key once its small table is full.
+ * @details Wraps the khash table so the public header does not depend
+ * on khash.
+ */
+struct TomlKeyTable_t
+{
+  khash_t(id) table; /**< Subkeys by id. */
+};
+
+/** @} */
+
 /**
  * @name Parser Input type
  * @{
@@ -231,20 +444,134 @@ typedef struct Input
 typedef struct Tokenizer
 {
   Input input;
-  int cursor;                      /**< The location in the input buffer */
+  size_t cursor;                   /**< The location in the input buffer */
   char token;                      /**< The last read in token */
   char prev;                       /**< The token read in before `token` */
   char prev_prev;                  /**< The token read in before `prev` */
   bool is_null;                    /**< Boolean to indicate if `token` is non-NULL */
-  bool newline;                    /**< To keep track if we are on a newline */
-  int line;                        /**< The current line number in the stream */
-  int col;                         /**< The current column number in the stream */
-  int lines[MYTOML_MAX_NUM_LINES]; /**, The array where index=line and
-                                      lines[index]=length */
+  bool newline;                    /**< To keep track if a key may be indented */
+  int line;                        /**< The number of lines that ended before
+                                      the input window */
+  size_t line_start;               /**< The offset of the last line that
+                                      started before the input window */
+  khash_t(atom) * atoms;           /**< Interned key ids of the document */
+  char *scratch;                   /**< Buffer values are unescaped into,
+                                      reused from one value to the next */
+  size_t scratch_cap;              /**< Bytes allocated for `scratch` */
 } Tokenizer;
 
 /** @} */
 
+/**
+ * @name Lexer token type
+ * @{
+ */
+
+/**
+ * @enum TokenType
+ * @brief Enumerates the tokens produced by the lexer.
+ */
+typedef enum TokenType
+{
+
+  T_END,            /**< End of the input */
+  T_WHITESPACE,     /**< A run of spaces and tabs */
+  T_NEWLINE,        /**< `\n` or `\r\n` */
+  T_COMMENT,        /**< `#` up to the first control character */
+  T_BARE,           /**< A run of bare key characters */
+  T_BASIC_STRING,   /**< A single-line basic string without escapes */
+  T_LITERAL_STRING, /**< A single-line literal string */
+  T_NUMBER,         /**< A number, date or time */
+  T_PUNCT           /**< Any other single character */
+
+} TokenType;
+
+/**
+ * @struct Token
+ * @brief A span of the input scanned by the lexer.
+ * @note Strings include their quotes.
+ */
+typedef struct Token
+{
+  TokenType type; /**< The kind of token */
+  size_t start;   /**< Input offset of the first byte */
+  size_t len;     /**< The number of bytes in the token */
+} Token;
+
+/**
+ * @enum ScanType
+ * @brief Enumerates the runs the lexer can skip with a scanner.
+ */
+typedef enum ScanType
+{
+
+  SCAN_BLANK,          /**< Stops at the first non-blank */
+  SCAN_COMMENT,        /**< Stops at the first control character */
+  SCAN_BASIC_STRING,   /**< Also stops at `"` and `\\` */
+  SCAN_LITERAL_STRING, /**< Also stops at `'` */
+  SCAN_COUNT
+
+} ScanType;
+
+/**
+ * @brief A scanner returns the first byte in `[p, e)` that ends its run,
+ * or `e` if there is none.
+ */
+typedef const char *(*Scanner)(const char *p, const char *e);
+
+/** @} */
+
+/**
+ * @name Character classes
+ * @{
+ */
+
+/**
+ * @enum CharClass
+ * @brief Enumerates the characters the parser dispatches on.
+ * @note Stored in the low 4 bits of the character table.
+ */
+typedef enum CharClass
+{
+
+  C_OTHER,         /**< Anything without a class of its own */
+  C_BLANK,         /**< ` ` and `\t` */
+  C_NEWLINE,       /**< `\n` */
+  C_RETURN,        /**< `\r` */
+  C_COMMENT,       /**< `#` */
+  C_BRACKET,       /**< `[` opens a table or an array */
+  C_BRACE,         /**< `{` opens an inline table */
+  C_BASIC_QUOTE,   /**< `"` */
+  C_LITERAL_QUOTE, /**< `'` */
+  C_DIGIT,         /**< `0`-`9` */
+  C_SIGN,          /**< `+` and `-` */
+  C_BOOL,          /**< `t` and `f` start `true` and `false` */
+  C_SPECIAL,       /**< `i` and `n` start `inf` and `nan` */
+  C_BARE           /**< The other bare key letters and `_` */
+
+} CharClass;
+
+/**
+ * @enum CharFlag
+ * @brief Enumerates the character sets a character can belong to.
+ * @note Stored above the class in the character table.
+ */
+typedef enum CharFlag
+{
+
+  CF_BARE = 0x010,            /**< Bare key character */
+  CF_NUMBER = 0x020,          /**< Number, date or time character */
+  CF_CONTROL = 0x040,         /**< Control character outside strings */
+  CF_CONTROL_MULTI = 0x080,   /**< Control character in multi-line strings */
+  CF_CONTROL_LITERAL = 0x100, /**< Control character in literal strings */
+  CF_HEX = 0x200,             /**< `A`-`F` and `a`-`f` */
+  CF_BASIC_STOP = 0x400,      /**< Ends a plain run in a basic string */
+  CF_LITERAL_STOP = 0x800     /**< Ends a plain run in a literal string */
+
+} CharFlag;
+
+/** @} */
+
 /**
  * @name Number data type
  * @{
@@ -263,29 +590,131 @@ typedef struct Number
   TomlValueType type; /**< */
   int precision;      /**<  */
   bool scientific;    /**<  */
+  int64_t integer;    /**< Value of a TOML_INT */
 } Number;
 
 /** @} */
 
 /**
- * @name Datetime data type
+ * @name Arena data types
+ * @{
+ */
+
+/**
+ * @struct ArenaBlock
+ * @brief One chunk of arena memory, its data follows the header.
+ */
+typedef struct ArenaBlock
+{
+  struct ArenaBlock *next; /**< Next block in the chain. */
+  size_t size;             /**< Usable bytes after the header. */
+  size_t used;             /**< Bytes handed out so far. */
+} ArenaBlock;
+
+/**
+ * @struct TomlArena
+ * @brief Chain of blocks, the head is the one currently being filled.
+ * @note The arena itself lives at the start of its first block.
+ */
+struct TomlArena_t
+{
+  ArenaBlock *head;        /**< Block new allocations are bumped from. */
+  TomlAllocator allocator; /**< Where the blocks come from. */
+  size_t reserved;         /**< Bytes of all blocks, headers included. */
+  size_t ids;              /**< Ids interned into the arena. */
+  size_t id_bytes;         /**< Bytes taken by those ids. */
+};
+
+/**
+ * @union KAllocHeader
+ * @brief Header in front of every khash allocation.
+ * @details Tells `_mytoml_kfree` and `_mytoml_krealloc` whether the block
+ * came from an arena or from the C heap.
+ */
+typedef union KAllocHeader
+{
+  struct
+  {
+    size_t size; /**< Requested size in bytes. */
+    bool arena;  /**< Whether the block belongs to an arena. */
+  } info;
+  long double align; /**< Keeps the payload aligned for any type. */
+} KAllocHeader;
+
+/** @} */
+
+/**
+ * @name Float data types
+ * @{
+ */
+
+/**
+ * @struct FloatDecimal
+ * @brief Decimal number the exact float conversion works on.
+ * @details Holds `0.d[0]d[1]...d[nd - 1] * 10^dp`. Multiplying and dividing
+ * it by powers of two brings it to the 53 bits of a double, which is slow
+ * but exact, so it only runs when the 64-bit paths cannot decide.
+ */
+typedef struct FloatDecimal
+{
+  int nd;         /**< Digits used in `d`. */
+  int dp;         /**< Position of the decimal point. */
+  bool truncated; /**< Whether nonzero digits were dropped past `d`. */
+  unsigned char d[MYTOML_FLOAT_DECIMAL_DIGITS + 20]; /**< Digit values, most
+                                                        significant first,
+                                                        with room for the
+                                                        carries of a shift. */
+} FloatDecimal;
+
+/** @} */
+
+/**
+ * @name Frozen data types
  * @{
  */
 
 /**
- * @struct Datetime
- * @brief Represent a generic type for a parsed datetime values.
- * number can be either integer or floating-point.
- * It also stores the matching format, again for compliance testing.
- * @note Used for DATETIME, DATELOCAL, TIMELOCAL and DATETIMELOCAL value types.
+ * @struct TomlFrozen
+ * @brief Header at the start of a frozen document.
+ * @details Every offset in the document is counted from here.
+ */
+struct TomlFrozen_t
+{
+  char magic[4];       /**< `MYTOML_FROZEN_MAGIC`. */
+  khint32_t version;   /**< `MYTOML_FROZEN_VERSION`. */
+  khint32_t size;      /**< Bytes in the document, header included. */
+  TomlFrozenNode root; /**< Root table. */
+};
+
+/**
+ * @struct FrozenEntry
+ * @brief One key of a frozen table.
+ * @details A table starts with its index: the number of bits `b` the
+ * entries are bucketed by, then `2^b + 1` positions where the entries of
+ * each bucket start. The entries follow, sorted by `hash`, so the top `b`
+ * bits of a hash give the only bucket its key can be in.
+ */
+typedef struct FrozenEntry
+{
+  khint32_t hash;       /**< `_mytoml_frozen_mix` of the key id hash. */
+  khint32_t key;        /**< Offset of the key bytes, followed by a NUL. */
+  khint32_t key_len;    /**< Length of the key in bytes. */
+  TomlFrozenNode value; /**< Value stored under the key. */
+} FrozenEntry;
+
+/**
+ * @struct FrozenBuilder
+ * @brief Growable buffer a frozen document is written into.
+ * @details Pieces are addressed by offset while writing since the buffer
+ * moves when it grows.
  */
-typedef struct Datetime
+typedef struct FrozenBuilder
 {
-  struct tm *dt;                       /**  */
-  TomlValueType type;                  /**  */
-  char format[MYTOML_MAX_DATE_FORMAT]; /**  */
-  int millis;                          /**  */
-} Datetime;
+  char *data;   /**< Document written so far. */
+  size_t size;  /**< Bytes used. */
+  size_t cap;   /**< Bytes allocated. */
+  size_t depth; /**< Arrays and tables being written. */
+} FrozenBuilder;
 
 /** @} */
 
@@ -304,12 +733,20 @@ extern "C"
   // [SECTION] Declarations
   //-----------------------------------------------------------------------------
 
-  // Helper function to append formatted text to a string buffer
-  void _mytoml_append_to_buffer(char **buffer, size_t *size, const char *format,
-                                ...);
+  /*
+      Function `_mytoml_buffer_grow` makes the dump `buffer` of
+      `size` bytes `len` bytes longer and keeps it NUL terminated.
+      Returns where the new bytes go, or NULL when out of memory.
+  */
+  char *_mytoml_buffer_grow(char **buffer, size_t *size, size_t len);
+
+  void _mytoml_append_bytes(char **buffer, size_t *size, const char *s,
+                            size_t len);
 
-  static inline void _mytoml_string_dump(const char *s, char **buffer,
-                                         size_t *size);
+  void _mytoml_append_string(char **buffer, size_t *size, const char *s);
+
+  static inline void _mytoml_string_dump(const char *s, size_t len,
+                                         char **buffer, size_t *size);
 
   //-----------------------------------------------------------------------------
   // [SECTION] Myjson Tokenizer
@@ -337,6 +774,42 @@ extern "C"
   */
   bool _mytoml_tokenizer_load_input(Tokenizer *tok);
 
+  /*
+      Function `_mytoml_tokenizer_scratch` makes room for `size`
+      bytes and a NUL in the scratch buffer of `tok`, doubling
+      it as needed. Returns the buffer, which moves when it
+      grows, or NULL when out of memory.
+  */
+  char *_mytoml_tokenizer_scratch(Tokenizer *tok, size_t size);
+
+  /*
+      Function `_mytoml_tokenizer_refill` reads the next chunk of a
+      `S_CHUNKED` input into the window. It keeps the bytes from
+      `MYTOML_STREAM_HISTORY` before the current character onwards,
+      so the previous tokens and lexed tokens are never split,
+      growing the window if a token does not fit. Reading stops
+      after a newline so parsing is never blocked waiting for a
+      full chunk.
+  */
+  void _mytoml_tokenizer_refill(Tokenizer *tok);
+
+  /*
+      Function `_mytoml_tokenizer_fill` makes sure the byte at input
+      `offset` is in the window, refilling chunked input as needed.
+      Returns false once the input is exhausted.
+  */
+  bool _mytoml_tokenizer_fill(Tokenizer *tok, size_t offset);
+
+  /*
+      Function `_mytoml_tokenizer_map_input` maps a regular file
+      named by the input straight from the page cache, so it is
+      parsed without copying it into a buffer. It returns false
+      if the file cannot be mapped (e.g. it is not a regular
+      file, it is empty or the platform has no mmap), in which
+      case the caller falls back to reading it into a buffer.
+  */
+  bool _mytoml_tokenizer_map_input(Tokenizer *tok);
+
   /*
       Function `_mytoml_tokenizer_next_token` reads the next character from the
       input stream. It then stores it in the `token` attribute.
@@ -349,19 +822,39 @@ extern "C"
   int _mytoml_tokenizer_next_token(Tokenizer *tok);
 
   /*
-      Function `_mytoml_tokenizer_backtrace` is used to move the `cursor` back in
-      the input stream. This allows look-ahead operations to make
-      parsing decisions. For example, let's say we want to decide
-      whether to parse something as a date or a number. To know if
-      there is a `-` a few chars ahead, we call `_mytoml_tokenizer_next_token`.
-      However, in the case that there isn't, we need to go back
-      to where we were and re-parse it as a number. This function
-      takes an argument `count` and backtracks that many characters.
-      To maintain the values of `prev` and `prev_prev`, this goes
-      back 2 extra characters and calls `_mytoml_tokenizer_next_token` twice to
-      re-populate them.
+      Function `_mytoml_tokenizer_peek` returns the character `n`
+      places after the current one without moving the tokenizer,
+      or '\0' past the end of the input. This allows look-ahead
+      operations to make parsing decisions, e.g. whether a quote
+      closes a multi-line string, without rewinding the cursor.
+  */
+  char _mytoml_tokenizer_peek(Tokenizer *tok, size_t n);
+
+  /*
+      Function `_mytoml_tokenizer_position` computes the 0-based
+      line and 1-based column of input `offset`. Positions are not
+      tracked while parsing, they are derived from the input only
+      when an error needs to be reported.
+  */
+  void _mytoml_tokenizer_position(Tokenizer *tok, size_t offset, int *line,
+                                  int *col);
+
+  /*
+      Function `_mytoml_tokenizer_advance` moves the tokenizer
+      `count` characters forward in one step. It leaves the
+      tokenizer in the same state as `count` calls to
+      `_mytoml_tokenizer_next_token`, but the characters it skips
+      must already be in the input window (i.e. they were just
+      scanned by the lexer).
+  */
+  void _mytoml_tokenizer_advance(Tokenizer *tok, size_t count);
+
+  /*
+      Function `_mytoml_tokenizer_byte_at` returns the character at
+      input `offset` without moving the tokenizer, or '\0' past
+      the end of the input.
   */
-  void _mytoml_tokenizer_backtrace(Tokenizer *tok, int count);
+  char _mytoml_tokenizer_byte_at(Tokenizer *tok, size_t offset);
 
   /*
       Function `_mytoml_tokenizer_has_token` returns true if the boolean attribute
@@ -392,22 +885,116 @@ extern "C"
   void _mytoml_tokenizer_delete(Tokenizer *tok);
 
   //-----------------------------------------------------------------------------
-  // [SECTION] Myjson Value
+  // [SECTION] Myjson Lexer
+  //-----------------------------------------------------------------------------
+
+  /*
+      Function `_mytoml_lexer_next` scans the token that starts at
+      the current character into `t` and returns its type. It does
+      not move the tokenizer, so callers can look at the token and
+      then skip it with `_mytoml_tokenizer_advance`. Strings that
+      need more than a copy (escapes, multi-line, invalid) come
+      back as a single `T_PUNCT` quote.
+  */
+  TokenType _mytoml_lexer_next(Tokenizer *tok, Token *t);
+
+  /*
+      Function `_mytoml_lexer_number` scans the number, date or
+      time that starts at the current character into `t`.
+  */
+  TokenType _mytoml_lexer_number(Tokenizer *tok, Token *t);
+
+  /*
+      Function `_mytoml_lexer_run` returns the input offset of the
+      first character at or after `offset` for which `accept`
+      returns false.
+  */
+  size_t _mytoml_lexer_run(Tokenizer *tok, size_t offset, bool (*accept)(char));
+
+  /*
+      Function `_mytoml_lexer_scan` is `_mytoml_lexer_run` for the
+      runs in `ScanType`. It uses the widest scanner the CPU
+      supports.
+  */
+  size_t _mytoml_lexer_scan(Tokenizer *tok, size_t offset, ScanType type);
+
+  /*
+      Function `_mytoml_lexer_text` returns a pointer to the first
+      character of `t`. It is valid until the tokenizer moves
+      past the token.
+  */
+  const char *_mytoml_lexer_text(Tokenizer *tok, const Token *t);
+
+  //-----------------------------------------------------------------------------
+  // [SECTION] Myjson Allocator
+  //-----------------------------------------------------------------------------
+
+  /*
+      Functions `_mytoml_malloc`, `_mytoml_calloc`, `_mytoml_realloc`
+      and `_mytoml_free` allocate through the allocator of the parse
+      running on this thread, or through the global allocator set
+      with `toml_set_allocator` otherwise. Every allocation of the
+      library goes through them.
+  */
+  void *_mytoml_malloc(size_t size);
+
+  void *_mytoml_calloc(size_t n, size_t size);
+
+  void *_mytoml_realloc(void *ptr, size_t size);
+
+  void _mytoml_free(void *ptr);
+
+  //-----------------------------------------------------------------------------
+  // [SECTION] Myjson Arena
   //-----------------------------------------------------------------------------
 
   /*
-      Function `_mytoml_value_delete` frees up all the memory
-      that is associated with value `v`.
+      Function `_mytoml_arena_new` allocates the first block of a
+      new arena from `allocator` and places the arena itself at
+      its start. Returns NULL when out of memory.
+  */
+  TomlArena *_mytoml_arena_new(const TomlAllocator *allocator);
+
+  /*
+      Function `_mytoml_arena_alloc` bumps `size` zeroed bytes out
+      of `arena`, aligned to `MYTOML_ARENA_ALIGN`. A new block is
+      chained in when the head is full, and large requests get a
+      block of their own so the head is not wasted.
+  */
+  void *_mytoml_arena_alloc(TomlArena *arena, size_t size);
+
+  /*
+      Function `_mytoml_arena_delete` frees every block of `arena`,
+      including the one the arena lives in, with the allocator the
+      arena was created with.
+  */
+  void _mytoml_arena_delete(TomlArena *arena);
+
+  /*
+      Function `_mytoml_alloc` returns `size` zeroed bytes from the
+      arena of the document being parsed on this thread, or from
+      the C heap when no parse is running.
   */
-  void _mytoml_value_delete(TomlValue *v);
+  void *_mytoml_alloc(size_t size);
+
+  //-----------------------------------------------------------------------------
+  // [SECTION] Myjson Value
+  //-----------------------------------------------------------------------------
 
   /*
-      Function `_mytoml_value_new_array` allocates a buffer for an
-      array of `TomlValue` and returns a pointer to it.
-      This is stored in the `arr` attribute.
+      Function `_mytoml_value_new_array` allocates an empty array
+      value. Its `arr` buffer is only allocated once the first
+      value is pushed.
   */
   TomlValue *_mytoml_value_new_array();
 
+  /*
+      Function `_mytoml_value_array_push` appends `v` to the `arr`
+      attribute of `array`, doubling its capacity when it is full.
+      Returns false when out of memory.
+  */
+  bool _mytoml_value_array_push(TomlValue *array, TomlValue *v);
+
   /*
       Function `_mytoml_value_new_table` takes a key `k` as
       it's argument which can contain one or many key
@@ -422,19 +1009,23 @@ extern "C"
   /*
       Functions `_mytoml_value_new_string`, `_mytoml_value_new_datetime` and
      `_mytoml_value_new_number` allocates some memory for each of these datatypes
-      respectively. It then copies over the passed in data
-      into the `data` attribute of the value. Finally, like
-      the other functions, it returns a pointer to the newly
+      respectively. Numbers, booleans and datetimes are stored inline
+      in the value, string bytes are placed right behind it in the
+      same allocation. The type of a datetime follows from its flags.
+      Like the other functions, it returns a pointer to the newly
       allocated value.
   */
   TomlValue *_mytoml_value_new_string(const char *s);
 
-  TomlValue *_mytoml_value_new_datetime(struct tm *dt, TomlValueType type,
-                                        char *format, int millis);
+  TomlValue *_mytoml_value_new_stringn(const char *s, size_t len);
+
+  TomlValue *_mytoml_value_new_datetime(const TomlDatetime *dt);
 
   TomlValue *_mytoml_value_new_number(double *d, TomlValueType type,
                                       size_t precision, bool scientific);
 
+  TomlValue *_mytoml_value_new_integer(int64_t i);
+
   //-----------------------------------------------------------------------------
   // [SECTION] Myjson Key
   //-----------------------------------------------------------------------------
@@ -443,31 +1034,49 @@ extern "C"
       Function `_mytoml_value_new_key` allocates memory to create
       a new key/node in the AST. It takes the key type
       as an argument and initializes everything else
-      to NULL and idx to 0. Returns a pointer to the
+      to NULL. Returns a pointer to the
       newly allocated key.
   */
   TomlKey *_mytoml_value_new_key(TomlKeyType type);
 
   /*
-      Function `_mytoml_value_delete_key` frees up all the memory allocated
-      by this key. It first recursively frees up all the
-      memory allocated by the keys in `children` if any. Then
-      it frees up all the memory allocated by `value` if any.
-      Finally, it frees up the memory allocated by itself.
+      Function `_mytoml_value_new_id` copies `len` bytes of `s` into
+      the document arena, followed by a NUL, and returns them as
+      an id with its hash. `str` is NULL when out of memory or
+      when `len` does not fit the 32-bit length of an id.
   */
-  void _mytoml_value_delete_key(TomlKey *key);
+  TomlId _mytoml_value_new_id(const char *s, size_t len);
 
   /*
-      Function `_mytoml_value_has_sub_key` checks if a `key` has a `subkey`
-      in its list of `children` by iterating through it
-      and matching against the `id`. Returns a pointer
-      to the key if it exists, else returns NULL.
+      Function `_mytoml_value_id_append` appends `len` bytes of `s`
+      to an id being built one piece at a time, doubling its
+      buffer `cap` when it is full. Start from `{"", 0, 0}` with a
+      `cap` of 0. The hash is left for `_mytoml_parser_intern_id`.
+      Returns false when out of memory or past a 32-bit length.
   */
-  TomlKey *_mytoml_value_has_sub_key(TomlKey *key, TomlKey *subkey);
+  bool _mytoml_value_id_append(TomlId *id, size_t *cap, const char *s,
+                               size_t len);
 
   /*
-      Function `_mytoml_value_add_sub_key` tries to add `subkey` in the
-      list of `children` of `key`. There are checks to do
+      Function `_mytoml_value_has_sub_key` checks if a `key` has a subkey
+      with identifier `id`, comparing hashes of its small table
+      or probing its hash table. Returns a pointer to the
+      subkey if it exists, else returns NULL.
+  */
+  TomlKey *_mytoml_value_has_sub_key(const TomlKey *key, TomlId id);
+
+  /*
+      Function `_mytoml_value_put_sub_key` stores `subkey` in the
+      subkeys of `key` without checking for an existing one.
+      The small table is allocated on the first subkey and
+      promoted to a hash table once it is full. Returns
+      `subkey`, or NULL when out of memory.
+  */
+  TomlKey *_mytoml_value_put_sub_key(TomlKey *key, TomlKey *subkey);
+
+  /*
+      Function `_mytoml_value_add_sub_key` tries to add `subkey` in the
+      list of `children` of `key`. There are checks to do
       memory initialization as well. If a `subkey` is already
       there in `children`, then the `_mytoml_value_keys_compatible` function
       is used to check if the new key is "compatible" with
@@ -487,6 +1096,71 @@ extern "C"
   */
   bool _mytoml_value_keys_compatible(TomlKeyType existing, TomlKeyType current);
 
+  //-----------------------------------------------------------------------------
+  // [SECTION] Myjson Stats
+  //-----------------------------------------------------------------------------
+
+  /*
+      Function `_mytoml_stats_key` adds `key`, its subkey table,
+      its value and every key below it to `stats`.
+  */
+  void _mytoml_stats_key(const TomlKey *key, TomlMemoryStats *stats);
+
+  /*
+      Function `_mytoml_stats_value` adds `value` and everything
+      it holds to `stats`, using the sizes it was allocated with.
+  */
+  void _mytoml_stats_value(const TomlValue *value, TomlMemoryStats *stats);
+
+  //-----------------------------------------------------------------------------
+  // [SECTION] Myjson Frozen
+  //-----------------------------------------------------------------------------
+
+  /*
+      Function `_mytoml_frozen_reserve` appends `size` zeroed bytes
+      to the document in `b`, aligned to `MYTOML_FROZEN_ALIGN`,
+      and stores their offset in `off`. Returns false when out
+      of memory or past the 32-bit offsets of a document.
+  */
+  bool _mytoml_frozen_reserve(FrozenBuilder *b, size_t size, khint32_t *off);
+
+  /*
+      Function `_mytoml_frozen_key` writes `key` into the node at
+      offset `node`: its value if it has one, else its subkeys
+      as a table. Returns false when out of memory.
+  */
+  bool _mytoml_frozen_key(FrozenBuilder *b, const TomlKey *key,
+                          khint32_t node);
+
+  /*
+      Function `_mytoml_frozen_table` writes the subkeys of `key`
+      as a table into the node at offset `node`: a bucket index,
+      the entries sorted by hash and the key bytes, then the
+      values below them. Returns false when out of memory.
+  */
+  bool _mytoml_frozen_table(FrozenBuilder *b, const TomlKey *key,
+                            khint32_t node);
+
+  /*
+      Function `_mytoml_frozen_value` writes `value` into the node
+      at offset `node`, along with the string bytes, elements,
+      table or datetime it holds. Returns false when out of
+      memory.
+  */
+  bool _mytoml_frozen_value(FrozenBuilder *b, const TomlValue *value,
+                            khint32_t node);
+
+  /*
+      Function `_mytoml_frozen_check` walks `node` of `doc` in the
+      order `_mytoml_frozen_value` wrote it. Every piece has to
+      start where the one before it ended, `end` on entry, and
+      every key, string, bucket and hash has to be the one the
+      builder would have written. Moves `end` past the pieces of
+      `node` and returns false at the first one that is not.
+  */
+  bool _mytoml_frozen_check(const TomlFrozen *doc, const TomlFrozenNode *node,
+                            size_t *end, size_t depth);
+
   //-----------------------------------------------------------------------------
   // [SECTION] Myjson Parser Utils
   //-----------------------------------------------------------------------------
@@ -527,7 +1201,94 @@ extern "C"
   bool _mytoml_is_literal_string_start(char c);
   bool _mytoml_is_date(int year, int month, int day);
   bool _mytoml_is_number_end(char c, const char *end);
-  bool _mytoml_is_valid_datetime(struct tm *datetime);
+  bool _mytoml_is_comment_char(char c);
+  bool _mytoml_is_number_char(char c);
+  bool _mytoml_is_basic_string_char(char c);
+  bool _mytoml_is_literal_string_char(char c);
+
+  /*
+      Functions `_mytoml_datetime_days` and `_mytoml_datetime_civil`
+      convert between a date of the proleptic Gregorian calendar,
+      months counted from 1, and the days since 1970-01-01.
+  */
+  int32_t _mytoml_datetime_days(int year, int month, int day);
+
+  void _mytoml_datetime_civil(int32_t days, int *year, int *month, int *day);
+
+  /*
+      Function `_mytoml_char_class` returns the class the parser
+      dispatches on for `c`, and `_mytoml_char_has` returns true
+      if `c` is in every set of `flags`. Both are a single load
+      from a 256-entry table.
+  */
+  CharClass _mytoml_char_class(char c);
+  bool _mytoml_char_has(char c, unsigned flags);
+
+  //-----------------------------------------------------------------------------
+  // [SECTION] Myjson Float
+  //-----------------------------------------------------------------------------
+
+  /*
+      Function `_mytoml_float_from_decimal` computes the double
+      nearest to `w * 10^q` with the Eisel-Lemire algorithm.
+      Returns false in the rare cases a 128-bit product cannot
+      decide the rounding, which are left to
+      `_mytoml_float_parse_decimal`.
+  */
+  bool _mytoml_float_from_decimal(uint64_t w, int q, bool negative, double *d);
+
+  /*
+      Function `_mytoml_float_parse_span` converts the float in
+      the `len` bytes at `s` in place, skipping `_` separators,
+      and fills `n` the way `_mytoml_parser_parse_number` does.
+      Past 19 significant digits the rest are dropped, and the
+      result kept when rounding up the last digit kept gives the
+      same double. Returns false for integers and anything that
+      is not a well formed float, left to the validating parser.
+  */
+  bool _mytoml_float_parse_span(const char *s, size_t len, double *d, Number *n);
+
+  /*
+      Function `_mytoml_float_parse_decimal` converts the decimal
+      float in the `len` bytes at `s`, skipping `_` separators,
+      to the nearest double whatever its number of digits. It
+      does not depend on the locale. Returns false when `s` is
+      not all a number.
+  */
+  bool _mytoml_float_parse_decimal(const char *s, size_t len, double *d);
+
+  //-----------------------------------------------------------------------------
+  // [SECTION] Myjson Number Format
+  //-----------------------------------------------------------------------------
+
+  /*
+      Function `_mytoml_float_to_decimal` finds the shortest
+      `digits * 10^exp` that reads back as the finite, non-zero
+      `f` with the Schubfach algorithm, the closest one when
+      there are several.
+  */
+  void _mytoml_float_to_decimal(double f, uint64_t *digits, int *exp);
+
+  /*
+      Functions `_mytoml_format_int` and `_mytoml_format_float`
+      write a number to `out`, which holds at least
+      MYTOML_NUMBER_FORMAT_SIZE bytes, and return how many bytes
+      they wrote. Floats come out in their shortest round trip
+      form with a point or an exponent, exponents for
+      `scientific` ones and those far from 1.
+  */
+  size_t _mytoml_format_int(int64_t i, char *out);
+
+  size_t _mytoml_format_float(double f, bool scientific, char *out);
+
+  /*
+      Function `_mytoml_format_datetime` writes `dt` in RFC 3339
+      form to `out`, which holds at least
+      MYTOML_DATETIME_FORMAT_SIZE bytes, and returns how many bytes
+      it wrote. The fraction of a second keeps the digits it was
+      written with.
+  */
+  size_t _mytoml_format_datetime(const TomlDatetime *dt, char *out);
 
   //-----------------------------------------------------------------------------
   // [SECTION] Myjson Parser Key
@@ -558,6 +1319,25 @@ extern "C"
                                              TomlKeyType branch,
                                              TomlKeyType leaf);
 
+  /*
+      Function `_mytoml_parser_key_end` finishes a key once its
+      `id` has been read. It skips whitespace and creates a key
+      of type `branch` if a `.` follows or `leaf` if `end`
+      follows, without consuming either.
+  */
+  TomlKey *_mytoml_parser_key_end(Tokenizer *tok, TomlId id, char end,
+                                  TomlKeyType branch, TomlKeyType leaf);
+
+  /*
+      Function `_mytoml_parser_intern_id` returns the id of the
+      document equal to `len` bytes of `s`, copying them into the
+      arena the first time they are seen. Ids returned for equal
+      bytes share their `str`, so repeated keys like those of an
+      array of tables are stored and hashed once. `str` is NULL
+      when out of memory.
+  */
+  TomlId _mytoml_parser_intern_id(Tokenizer *tok, const char *s, size_t len);
+
   /*
       Functions `_mytoml_parser_parse_key`, `_mytoml_parser_parse_table` and
       `_mytoml_parser_parse_array_table` tries to parse a TOML
@@ -593,6 +1373,25 @@ extern "C"
   TomlKey *_mytoml_parser_parse_key_value(Tokenizer *tok, TomlKey *key,
                                           TomlKey *root);
 
+  /*
+      Function `_mytoml_parser_parse_document` does the work of
+      `_mytoml_parser_parse_input` once the allocator of the parse
+      is in place.
+  */
+  TomlKey *_mytoml_parser_parse_document(Input input, const char *name);
+
+  /*
+      Function `_mytoml_parser_parse_input` parses a whole TOML
+      document from `input`. It loads the input, creates the
+      `root` key, repeatedly calls `_mytoml_parser_parse_key_value`
+      until the input is exhausted and releases the tokenizer.
+      `options` may be NULL for the defaults, `name` is only
+      used to report where an error happened. Returns the
+      `root` key, or NULL on failure.
+  */
+  TomlKey *_mytoml_parser_parse_input(Input input, const TomlOptions *options,
+                                      const char *name);
+
   //-----------------------------------------------------------------------------
   // [SECTION] Myjson Parser Value
   //-----------------------------------------------------------------------------
@@ -621,24 +1420,68 @@ extern "C"
 
   int _mytoml_parser_parse_escape(Tokenizer *tok, char *escaped, int len);
 
-  int _mytoml_parser_parse_unicode(Tokenizer *tok, char *escaped, int len);
+  /*
+      Function `_mytoml_parser_parse_unicode` reads the `digits` hex
+      digits of a `\u` or `\U` escape and writes the code point to
+      `escaped` as UTF-8. Returns the bytes written, 0 on error.
+  */
+  int _mytoml_parser_parse_unicode(Tokenizer *tok, char *escaped, int len,
+                                   int digits);
 
-  char *_mytoml_parser_parse_basic_string(Tokenizer *tok, char *value,
+  /*
+      Functions `_mytoml_parser_parse_basic_string` and
+      `_mytoml_parser_parse_literal_string` unescape a string into
+      the scratch buffer of `tok`, starting after its opening
+      quotes. They return the buffer, NUL terminated, with the
+      length of the string in `len`, or NULL on error.
+  */
+  char *_mytoml_parser_parse_basic_string(Tokenizer *tok, size_t *len,
                                           bool multi);
 
-  char *_mytoml_parser_parse_literal_string(Tokenizer *tok, char *value,
+  char *_mytoml_parser_parse_literal_string(Tokenizer *tok, size_t *len,
                                             bool multi);
 
   double _mytoml_parser_parse_lnf_nan(Tokenizer *tok, bool negative);
 
-  double _mytoml_parser_parse_base_unit(Tokenizer *tok, int base, char *value,
-                                        const char *num_end);
+  /*
+      Function `_mytoml_parser_parse_int64` converts the `len`
+      characters at `s`, an optional sign then digits of `base`,
+      into `out`. Returns false when a character is not a digit
+      or the value does not fit in an int64_t.
+  */
+  bool _mytoml_parser_parse_int64(const char *s, size_t len, int base,
+                                  int64_t *out);
+
+  bool _mytoml_parser_parse_base_unit(Tokenizer *tok, int base,
+                                      const char *num_end, int64_t *out);
 
-  Number *_mytoml_parser_parse_number(Tokenizer *tok, char *value, double *d,
+  /*
+      Function `_mytoml_parser_parse_number` parses an integer
+      into `n->integer` or a float into `d`, `n->type` tells
+      which. Returns `n`, or NULL on error.
+  */
+  Number *_mytoml_parser_parse_number(Tokenizer *tok, double *d,
                                       const char *num_end, Number *n);
 
-  Datetime *_mytoml_parser_parse_datetime(Tokenizer *tok, char *value,
-                                          const char *num_end, struct tm *time);
+  /*
+      Function `_mytoml_parser_parse_datetime_span` reads the
+      date, time or datetime in the `len` bytes at `s` into
+      `dt`. Digits of the fraction past nanoseconds are dropped.
+      The shape is told from fixed positions and the digit groups are
+      checked a word at a time. Returns false when the bytes
+      are not an RFC 3339 date, time or datetime.
+  */
+  bool _mytoml_parser_parse_datetime_span(const char *s, size_t len,
+                                          TomlDatetime *dt);
+
+  /*
+      Function `_mytoml_parser_parse_datetime` parses the datetime
+      at the cursor into `dt` and moves past it. Returns `dt`, or
+      NULL on error.
+  */
+  TomlDatetime *_mytoml_parser_parse_datetime(Tokenizer *tok,
+                                              const char *num_end,
+                                              TomlDatetime *dt);
 
   TomlValue *_mytoml_parser_parse_array(Tokenizer *tok, TomlValue *arr);
 
@@ -659,54 +1502,96 @@ extern "C"
   // [SECTION] Definations
   //-----------------------------------------------------------------------------
 
-  void _mytoml_append_to_buffer(char **buffer, size_t *size, const char *format,
-                                ...)
+  char *_mytoml_buffer_grow(char **buffer, size_t *size, size_t len)
   {
-    va_list args;
-    va_start(args, format);
-    size_t needed = vsnprintf(NULL, 0, format, args) + 1;
-    va_end(args);
+    char *grown = (char *)_mytoml_realloc(*buffer, *size + len + 1);
+    RETURN_IF_FAILED(grown, "failed to grow dump buffer\n");
+    *buffer = grown;
+    char *at = grown + *size;
+    *size += len;
+    grown[*size] = '\0';
+    return at;
+  }
 
-    *buffer = (char *)realloc(*buffer, *size + needed);
-    va_start(args, format);
-    vsnprintf(*buffer + *size, needed, format, args);
-    va_end(args);
+  void _mytoml_append_bytes(char **buffer, size_t *size, const char *s,
+                            size_t len)
+  {
+    char *at = _mytoml_buffer_grow(buffer, size, len);
+    if (at)
+      memcpy(at, s, len);
+  }
 
-    *size += needed - 1;
+  void _mytoml_append_string(char **buffer, size_t *size, const char *s)
+  {
+    _mytoml_append_bytes(buffer, size, s, strlen(s));
   }
 
-  static inline void _mytoml_string_dump(const char *s, char **buffer,
-                                         size_t *size)
+  static inline void _mytoml_string_dump(const char *s, size_t len,
+                                         char **buffer, size_t *size)
   {
-    for (const char *c = s; *c != '\0'; c++)
+    // measure the escaped string first to grow the buffer once
+    size_t out = len;
+    for (size_t i = 0; i < len; i++)
+    {
+      unsigned char ch = (unsigned char)s[i];
+      if (ch == '"' || ch == '\\' || ch == '\b' || ch == '\n' || ch == '\r' ||
+          ch == '\t' || ch == '\f')
+        out += 1;
+      else if (ch < 0x20)
+        out += 5;
+    }
+    char *p = _mytoml_buffer_grow(buffer, size, out);
+    if (!p)
+      return;
+    if (out == len)
+    {
+      memcpy(p, s, len);
+      return;
+    }
+    for (size_t i = 0; i < len; i++)
     {
-      switch (*c)
+      unsigned char ch = (unsigned char)s[i];
+      char escape = 0;
+      switch (ch)
       {
       case '\b':
-        _mytoml_append_to_buffer(buffer, size, "\\b");
-        continue;
+        escape = 'b';
+        break;
       case '\n':
-        _mytoml_append_to_buffer(buffer, size, "\\n");
-        continue;
+        escape = 'n';
+        break;
       case '\r':
-        _mytoml_append_to_buffer(buffer, size, "\\r");
-        continue;
+        escape = 'r';
+        break;
       case '\t':
-        _mytoml_append_to_buffer(buffer, size, "\\t");
-        continue;
+        escape = 't';
+        break;
       case '\f':
-        _mytoml_append_to_buffer(buffer, size, "\\f");
-        continue;
+        escape = 'f';
+        break;
       case '\\':
-        _mytoml_append_to_buffer(buffer, size, "\\\\");
-        continue;
       case '"':
-        _mytoml_append_to_buffer(buffer, size, "\\\"");
-        continue;
+        escape = (char)ch;
+        break;
       default:
         break;
       }
-      _mytoml_append_to_buffer(buffer, size, "%c", *c);
+      if (escape)
+      {
+        *p++ = '\\';
+        *p++ = escape;
+      }
+      else if (ch < 0x20)
+      {
+        memcpy(p, "\\u00", 4);
+        p[4] = "0123456789abcdef"[ch >> 4];
+        p[5] = "0123456789abcdef"[ch & 0xF];
+        p += 6;
+      }
+      else
+      {
+        *p++ = (char)ch;
+      }
     }
   }
 
@@ -716,53 +1601,53 @@ extern "C"
 
   Tokenizer *_mytoml_new_tokenizer(Input input)
   {
-    Tokenizer *tok = (Tokenizer *)calloc(1, sizeof(Tokenizer));
+    Tokenizer *tok = (Tokenizer *)_mytoml_calloc(1, sizeof(Tokenizer));
+    RETURN_IF_FAILED(tok, "failed to allocate tokenizer\n");
+    khash_t(atom) *atoms = kh_init(atom);
+    FUNC_IF_FAILED(atoms, _mytoml_free, tok);
+    RETURN_IF_FAILED(atoms, "failed to allocate key pool\n");
     tok->input = input;
     tok->cursor = 0;
     tok->token = '\0';
     tok->prev = '\0';
     tok->prev_prev = '\0';
     tok->line = 0;
-    tok->col = 0;
+    tok->line_start = 0;
     tok->is_null = true;
-    memset(tok->lines, 0, MYTOML_MAX_NUM_LINES);
+    tok->atoms = atoms;
+    tok->scratch = NULL;
+    tok->scratch_cap = 0;
     return tok;
   }
 
+  char *_mytoml_tokenizer_scratch(Tokenizer *tok, size_t size)
+  {
+    if (size < tok->scratch_cap)
+      return tok->scratch;
+    size_t cap = tok->scratch_cap ? tok->scratch_cap : MYTOML_SCRATCH_MIN_CAPACITY;
+    while (cap <= size)
+      cap *= 2;
+    char *scratch = (char *)_mytoml_realloc(tok->scratch, cap);
+    RETURN_IF_FAILED(scratch, "failed to grow scratch buffer\n");
+    tok->scratch = scratch;
+    tok->scratch_cap = cap;
+    return scratch;
+  }
+
   int _mytoml_tokenizer_next_token(Tokenizer *tok)
   {
     tok->prev_prev = tok->prev;
     tok->prev = tok->token;
     if (tok->is_null || tok->cursor == 0)
     {
-      tok->token = tok->input.stream[tok->cursor++];
-      // if we parsed some non-whitespace character since we saw
-      // the newline, then we aren't on a newline anymore
-      if (tok->newline && tok->prev && tok->prev != ' ' && tok->prev != '\t' &&
-          tok->prev != '\n')
-      {
-        tok->newline = false;
-      }
-      if (tok->token == '\n')
-      {
-        tok->newline = true;
-      }
-      if (tok->prev == '\n')
-      {
-        if (tok->line < MYTOML_MAX_NUM_LINES)
-        {
-          tok->lines[tok->line] = tok->col;
-        }
-        tok->line++;
-        tok->col = 0;
-      }
-      else
+      // the input is length delimited, so reading past its end
+      // yields a '\0' token instead of relying on a sentinel
+      bool end = !_mytoml_tokenizer_fill(tok, tok->cursor);
+      tok->token =
+          end ? '\0' : tok->input.stream[tok->cursor - tok->input.base];
+      tok->cursor++;
+      if (end)
       {
-        tok->col++;
-      }
-      if (tok->token == EOF)
-      {
-        tok->token = '\0';
         tok->is_null = false;
       }
       return 1;
@@ -770,31 +1655,210 @@ extern "C"
     return 0;
   }
 
-  void _mytoml_tokenizer_backtrace(Tokenizer *tok, int count)
+  char _mytoml_tokenizer_peek(Tokenizer *tok, size_t n)
+  {
+    return _mytoml_tokenizer_byte_at(tok, tok->cursor - 1 + n);
+  }
+
+  void _mytoml_tokenizer_position(Tokenizer *tok, size_t offset, int *line,
+                                  int *col)
+  {
+    Input *in = &tok->input;
+    size_t end = in->base + in->length;
+    offset = offset < in->base ? in->base : (offset > end ? end : offset);
+    int n = tok->line;
+    size_t start = tok->line_start;
+    const char *p = in->stream;
+    const char *e = in->stream + (offset - in->base);
+    for (const char *nl = p; (nl = (const char *)memchr(nl, '\n', e - nl));
+         nl++)
+    {
+      n++;
+      start = in->base + (size_t)(nl - p) + 1;
+    }
+    *line = n;
+    *col = (int)(offset - start) + 1;
+  }
+
+  void _mytoml_tokenizer_advance(Tokenizer *tok, size_t count)
+  {
+    if (count == 0)
+    {
+      return;
+    }
+    Input *in = &tok->input;
+    size_t from = tok->cursor - 1;
+    const char *e = in->stream + (from - in->base) + count;
+
+    tok->prev_prev = count > 1 ? e[-2] : tok->prev;
+    tok->prev = e[-1];
+    tok->cursor += count;
+    bool end = !_mytoml_tokenizer_fill(tok, from + count);
+    tok->token = end ? '\0' : in->stream[from + count - in->base];
+    if (end)
+    {
+      tok->is_null = false;
+    }
+  }
+
+  char _mytoml_tokenizer_byte_at(Tokenizer *tok, size_t offset)
+  {
+    if (!_mytoml_tokenizer_fill(tok, offset))
+    {
+      return '\0';
+    }
+    return tok->input.stream[offset - tok->input.base];
+  }
+
+  bool _mytoml_tokenizer_map_input(Tokenizer *tok)
+  {
+#if MYTOML_USE_MMAP && (MYTOML_PLATFORM_IS(LINUX) || MYTOML_PLATFORM_IS(APPLE))
+    // look before opening: opening and closing a fifo would drop its
+    // writer before the buffered read opens it again
+    struct stat st;
+    if (stat(tok->input.file.name, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+      return false;
+    }
+    int fd = open(tok->input.file.name, O_RDONLY);
+    if (fd < 0)
+    {
+      return false;
+    }
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 ||
+        (tok->input.limit && (size_t)st.st_size > tok->input.limit))
+    {
+      close(fd);
+      return false;
+    }
+
+    int flags = MAP_PRIVATE;
+#if MYTOML_MMAP_POPULATE && defined(MAP_POPULATE)
+    flags |= MAP_POPULATE;
+#endif
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, flags, fd, 0);
+    // the mapping keeps its own reference to the file
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+      return false;
+    }
+#if MYTOML_MMAP_SEQUENTIAL
+    madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+
+    tok->input.stream = (const char *)map;
+    tok->input.length = (size_t)st.st_size;
+    tok->input.storage = S_MAPPED;
+    return true;
+#else
+    (void)tok;
+    return false;
+#endif
+  }
+
+  void _mytoml_tokenizer_refill(Tokenizer *tok)
   {
-    int pre_count = count + 2;
-    if (count > 0 && tok->cursor > pre_count)
+    Input *in = &tok->input;
+    char *window = (char *)in->stream;
+
+    // slide everything from a little before the current character
+    // to the front, so the token being lexed stays contiguous and
+    // the previous tokens can still be read
+    size_t end = in->base + in->length;
+    size_t from = tok->cursor > MYTOML_STREAM_HISTORY + 1
+                      ? tok->cursor - 1 - MYTOML_STREAM_HISTORY
+                      : 0;
+    from = from < in->base ? in->base : (from > end ? end : from);
+    // count the lines we drop, so positions can still be derived
+    const char *drop = window + (from - in->base);
+    for (const char *nl = window;
+         (nl = (const char *)memchr(nl, '\n', drop - nl)); nl++)
+    {
+      tok->line++;
+      tok->line_start = in->base + (size_t)(nl - window) + 1;
+    }
+    size_t keep = end - from;
+    memmove(window, window + (from - in->base), keep);
+    in->base = from;
+    in->length = keep;
+
+    // a token longer than the window grows it instead of being split
+    if (keep > in->capacity / 2)
     {
-      tok->cursor -= pre_count;
-      tok->is_null = true;
-      int col = tok->col;
-      while (tok->line >= 0 && pre_count > col)
+      char *grown = (char *)_mytoml_realloc(window, in->capacity * 2);
+      if (grown == NULL)
       {
-        pre_count -= col;
-        col = tok->lines[--tok->line];
+        LOG_ERR("could not allocate input buffer\n");
+        in->eof = true;
+        in->failed = true;
+        return;
       }
-      tok->col = col - pre_count;
-      if (tok->line < 0)
-        tok->line = 0;
-      if (tok->col < 0)
-        tok->col = 0;
-      _mytoml_tokenizer_next_token(tok);
-      _mytoml_tokenizer_next_token(tok);
+      window = grown;
+      in->stream = grown;
+      in->capacity *= 2;
+    }
+
+    // never read more than one byte past the limit
+    size_t room = in->capacity - in->length;
+    if (in->limit)
+    {
+      size_t left = in->limit + 1 - (in->base + in->length);
+      room = left < room ? left : room;
+    }
+    bool ended;
+    if (in->regular)
+    {
+      // regular files are all there already, read a whole chunk
+      size_t n = fread(window + in->length, 1, room, in->file.pointer);
+      in->length += n;
+      ended = n < room;
     }
     else
     {
-      LOG_ERR("not enough characters to _mytoml_tokenizer_backtrace %d\n", count);
+      // stop at the end of a line, so parsing can begin on a pipe
+      // or socket while the producer is still writing to it
+      int c = 0;
+      const size_t full = in->length + room;
+      FILE *file = in->file.pointer;
+      _mytoml_lock_file(file);
+      while (in->length < full && c != '\n' && (c = _mytoml_getc(file)) != EOF)
+      {
+        window[in->length++] = (char)c;
+      }
+      _mytoml_unlock_file(file);
+      ended = c == EOF;
+    }
+
+    if (ended)
+    {
+      in->eof = true;
+      if (ferror(in->file.pointer))
+      {
+        LOG_ERR("could not read input\n");
+        in->failed = true;
+      }
+    }
+    if (in->limit && in->base + in->length > in->limit)
+    {
+      LOG_ERR("input size is too big\n");
+      in->eof = true;
+      in->failed = true;
+    }
+  }
+
+  bool _mytoml_tokenizer_fill(Tokenizer *tok, size_t offset)
+  {
+    Input *in = &tok->input;
+    while (offset - in->base >= in->length)
+    {
+      if (in->storage != S_CHUNKED || in->eof)
+      {
+        return false;
+      }
+      _mytoml_tokenizer_refill(tok);
     }
+    return true;
   }
 
   bool _mytoml_tokenizer_load_input(Tokenizer *tok)
@@ -802,6 +1866,11 @@ extern "C"
     FILE *stream;
     if (tok->input.type == I_STREAM)
     {
+      if (tok->input.limit && tok->input.length > tok->input.limit)
+      {
+        LOG_ERR("input size is too big\n");
+        return false;
+      }
       return true;
     }
     else if (tok->input.type == I_FILE)
@@ -810,32 +1879,47 @@ extern "C"
     }
     else if (tok->input.type == I_File)
     {
+      if (_mytoml_tokenizer_map_input(tok))
+      {
+        return true;
+      }
       stream = fopen(tok->input.file.name, "r");
+      if (stream == NULL)
+      {
+        LOG_ERR("could not open %s\n", tok->input.file.name);
+        return false;
+      }
+      tok->input.owns_file = true;
     }
     else
     {
       stream = stdin;
     }
 
-    fseek(stream, 0L, SEEK_END);
-    long size = ftell(stream);
-    fseek(stream, 0L, SEEK_SET);
-
-    if (size >= MYTOML_MAX_FILE_SIZE)
-    {
-      LOG_ERR("input size is too big\n");
-      return false;
-    }
-
-    char *buffer = (char *)calloc(1, size + 1);
-    if (size > 0 && 1 != fread(buffer, size, 1, stream))
+    // streams are never sized or rewound, so pipes, sockets and
+    // terminals work the same as regular files
+    char *window = (char *)_mytoml_malloc(MYTOML_STREAM_HISTORY +
+                                          MYTOML_STREAM_CHUNK_SIZE);
+    if (window == NULL)
     {
-      LOG_ERR("could not read input\n");
+      LOG_ERR("could not allocate input buffer\n");
+      if (tok->input.owns_file)
+        fclose(stream);
+      tok->input.owns_file = false;
       return false;
     }
-    buffer[size] = EOF;
-    tok->input.stream = buffer;
-#undef MYTOML_MAX_FILE_SIZE
+    tok->input.file.pointer = stream;
+    tok->input.stream = window;
+    tok->input.length = 0;
+    tok->input.base = 0;
+    tok->input.capacity = MYTOML_STREAM_HISTORY + MYTOML_STREAM_CHUNK_SIZE;
+    tok->input.storage = S_CHUNKED;
+    tok->input.regular = false;
+#if MYTOML_PLATFORM_IS(LINUX) || MYTOML_PLATFORM_IS(APPLE)
+    struct stat st;
+    tok->input.regular =
+        fstat(fileno(stream), &st) == 0 && S_ISREG(st.st_mode);
+#endif
     return true;
   }
 
@@ -852,356 +1936,3570 @@ extern "C"
 
   void _mytoml_tokenizer_delete(Tokenizer *tok)
   {
-    free(tok->input.stream);
-    free(tok);
+#if MYTOML_USE_MMAP && (MYTOML_PLATFORM_IS(LINUX) || MYTOML_PLATFORM_IS(APPLE))
+    if (tok->input.storage == S_MAPPED)
+    {
+      munmap((void *)tok->input.stream, tok->input.length);
+    }
+#endif
+    if (tok->input.storage == S_BUFFER || tok->input.storage == S_CHUNKED)
+    {
+      _mytoml_free((void *)tok->input.stream);
+    }
+    if (tok->input.owns_file)
+    {
+      fclose(tok->input.file.pointer);
+    }
+    kh_destroy(atom, tok->atoms);
+    _mytoml_free(tok->scratch);
+    _mytoml_free(tok);
   }
 
   //-----------------------------------------------------------------------------
-  // [SECTION] Myjson Value
+  // [SECTION] Lexer
   //-----------------------------------------------------------------------------
 
-  TomlValue *_mytoml_value_new_string(const char *s)
-  {
-    TomlValue *v = (TomlValue *)calloc(1, sizeof(TomlValue));
-    v->type = TOML_STRING;
-    v->data = calloc(1, strlen(s) + 1);
-    memcpy(v->data, s, strlen(s));
-    return v;
-  }
-
-  TomlValue *_mytoml_value_new_number(double *d, TomlValueType type,
-                                      size_t precision, bool scientific)
-  {
-    TomlValue *v = (TomlValue *)calloc(1, sizeof(TomlValue));
-    v->type = type;
-    v->scientific = scientific;
-    v->precision = precision;
-    v->data = calloc(1, sizeof(double));
-    memcpy(v->data, d, sizeof(double));
-    return v;
-  }
-
-  TomlValue *_mytoml_value_new_datetime(struct tm *dt, TomlValueType type,
-                                        char *format, int millis)
+  size_t _mytoml_lexer_run(Tokenizer *tok, size_t offset, bool (*accept)(char))
   {
-    TomlValue *v = (TomlValue *)calloc(1, sizeof(TomlValue));
-    v->type = type;
-    v->precision = millis;
-    v->data = calloc(1, sizeof(struct tm));
-    memset(v->format, 0, MYTOML_MAX_DATE_FORMAT);
-    if (strlen(format) < MYTOML_MAX_DATE_FORMAT)
+    while (_mytoml_tokenizer_fill(tok, offset))
     {
-      memcpy(v->format, format, strlen(format));
+      const char *p = tok->input.stream + (offset - tok->input.base);
+      const char *e = tok->input.stream + tok->input.length;
+      while (p < e && accept(*p))
+      {
+        p++;
+      }
+      offset = tok->input.base + (size_t)(p - tok->input.stream);
+      if (p < e)
+      {
+        break;
+      }
     }
-    memcpy(v->data, dt, sizeof(struct tm));
-    return v;
+    return offset;
   }
 
-  TomlValue *_mytoml_value_new_array()
+  static const char *_mytoml_scan_scalar(const char *p, const char *e,
+                                         ScanType type)
   {
-    TomlValue *v = (TomlValue *)calloc(1, sizeof(TomlValue));
+    bool (*accept)(char) = _mytoml_is_whitesapce;
+    switch (type)
+    {
+    case SCAN_COMMENT:
+      accept = _mytoml_is_comment_char;
+      break;
+    case SCAN_BASIC_STRING:
+      accept = _mytoml_is_basic_string_char;
+      break;
+    case SCAN_LITERAL_STRING:
+      accept = _mytoml_is_literal_string_char;
+      break;
+    default:
+      break;
+    }
+    while (p < e && accept(*p))
+    {
+      p++;
+    }
+    return p;
+  }
+
+#if MYTOML_SIMD_X86
+
+  // each stride is matched against the bytes that end the run, control
+  // characters are the unsigned bytes up to 0x1F (except tab) and 0x7F
+
+  static inline __attribute__((always_inline)) unsigned
+  _mytoml_sse2_stops(__m128i v, ScanType type)
+  {
+    __m128i mask;
+    if (type == SCAN_BLANK)
+    {
+      mask = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                          _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+      return ~(unsigned)_mm_movemask_epi8(mask) & 0xFFFFu;
+    }
+    mask = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(0x1F)), v);
+    mask = _mm_andnot_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\t')), mask);
+    mask = _mm_or_si128(mask, _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7F)));
+    if (type == SCAN_BASIC_STRING)
+    {
+      mask = _mm_or_si128(mask, _mm_cmpeq_epi8(v, _mm_set1_epi8('"')));
+      mask = _mm_or_si128(mask, _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+    }
+    else if (type == SCAN_LITERAL_STRING)
+    {
+      mask = _mm_or_si128(mask, _mm_cmpeq_epi8(v, _mm_set1_epi8('\'')));
+    }
+    return (unsigned)_mm_movemask_epi8(mask);
+  }
+
+  static inline __attribute__((always_inline)) const char *
+  _mytoml_scan_sse2(const char *p, const char *e, ScanType type)
+  {
+    while (e - p >= 16)
+    {
+      unsigned stops =
+          _mytoml_sse2_stops(_mm_loadu_si128((const __m128i *)p), type);
+      if (stops)
+      {
+        return p + __builtin_ctz(stops);
+      }
+      p += 16;
+    }
+    return _mytoml_scan_scalar(p, e, type);
+  }
+
+  static inline __attribute__((always_inline, target("avx2"))) unsigned
+  _mytoml_avx2_stops(__m256i v, ScanType type)
+  {
+    __m256i mask;
+    if (type == SCAN_BLANK)
+    {
+      mask = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                             _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')));
+      return ~(unsigned)_mm256_movemask_epi8(mask);
+    }
+    mask = _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(0x1F)), v);
+    mask = _mm256_andnot_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')),
+                               mask);
+    mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7F)));
+    if (type == SCAN_BASIC_STRING)
+    {
+      mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')));
+      mask =
+          _mm256_or_si256(mask, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+    }
+    else if (type == SCAN_LITERAL_STRING)
+    {
+      mask =
+          _mm256_or_si256(mask, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\'')));
+    }
+    return (unsigned)_mm256_movemask_epi8(mask);
+  }
+
+  static inline __attribute__((always_inline, target("avx2"))) const char *
+  _mytoml_scan_avx2(const char *p, const char *e, ScanType type)
+  {
+    while (e - p >= 32)
+    {
+      unsigned stops =
+          _mytoml_avx2_stops(_mm256_loadu_si256((const __m256i *)p), type);
+      if (stops)
+      {
+        return p + __builtin_ctz(stops);
+      }
+      p += 32;
+    }
+    return _mytoml_scan_sse2(p, e, type);
+  }
+
+#endif // MYTOML_SIMD_X86
+
+#define MYTOML_SCANNERS(name, attr)                                      \
+  static attr const char *name##_blank(const char *p, const char *e)     \
+  {                                                                      \
+    return name(p, e, SCAN_BLANK);                                       \
+  }                                                                      \
+  static attr const char *name##_comment(const char *p, const char *e)   \
+  {                                                                      \
+    return name(p, e, SCAN_COMMENT);                                     \
+  }                                                                      \
+  static attr const char *name##_basic(const char *p, const char *e)     \
+  {                                                                      \
+    return name(p, e, SCAN_BASIC_STRING);                                \
+  }                                                                      \
+  static attr const char *name##_literal(const char *p, const char *e)   \
+  {                                                                      \
+    return name(p, e, SCAN_LITERAL_STRING);                              \
+  }                                                                      \
+  static const Scanner name##_table[SCAN_COUNT] = {                      \
+      name##_blank, name##_comment, name##_basic, name##_literal}
+
+#if MYTOML_SIMD_X86
+  MYTOML_SCANNERS(_mytoml_scan_sse2, );
+  MYTOML_SCANNERS(_mytoml_scan_avx2, __attribute__((target("avx2"))));
+#else
+  MYTOML_SCANNERS(_mytoml_scan_scalar, );
+#endif
+
+#undef MYTOML_SCANNERS
+
+  static Scanner _mytoml_scanner(ScanType type)
+  {
+#if MYTOML_SIMD_X86
+    // picked on first use; threads racing here compute the same
+    // table, the atomic pointer makes publishing it well defined
+    static const Scanner *table = NULL;
+    const Scanner *t = __atomic_load_n(&table, __ATOMIC_ACQUIRE);
+    if (t == NULL)
+    {
+      __builtin_cpu_init();
+      t = __builtin_cpu_supports("avx2") ? _mytoml_scan_avx2_table
+                                         : _mytoml_scan_sse2_table;
+      __atomic_store_n(&table, t, __ATOMIC_RELEASE);
+    }
+    return t[type];
+#else
+    return _mytoml_scan_scalar_table[type];
+#endif
+  }
+
+  size_t _mytoml_lexer_scan(Tokenizer *tok, size_t offset, ScanType type)
+  {
+    Scanner scan = _mytoml_scanner(type);
+    while (_mytoml_tokenizer_fill(tok, offset))
+    {
+      const char *p = tok->input.stream + (offset - tok->input.base);
+      const char *e = tok->input.stream + tok->input.length;
+      p = scan(p, e);
+      offset = tok->input.base + (size_t)(p - tok->input.stream);
+      if (p < e)
+      {
+        break;
+      }
+    }
+    return offset;
+  }
+
+  const char *_mytoml_lexer_text(Tokenizer *tok, const Token *t)
+  {
+    return tok->input.stream + (t->start - tok->input.base);
+  }
+
+  TokenType _mytoml_lexer_next(Tokenizer *tok, Token *t)
+  {
+    size_t start = tok->cursor - 1;
+    char c = _mytoml_tokenizer_get_token(tok);
+    t->start = start;
+    t->len = 1;
+    t->type = T_PUNCT;
+
+    if (!_mytoml_tokenizer_has_token(tok))
+    {
+      t->type = T_END;
+      t->len = 0;
+    }
+    else if (_mytoml_is_whitesapce(c))
+    {
+      t->type = T_WHITESPACE;
+      t->len = _mytoml_lexer_scan(tok, start + 1, SCAN_BLANK) - start;
+    }
+    else if (_mytoml_is_newline(c))
+    {
+      t->type = T_NEWLINE;
+    }
+    else if (_mytoml_is_return(c))
+    {
+      if (_mytoml_is_newline(_mytoml_tokenizer_byte_at(tok, start + 1)))
+      {
+        t->type = T_NEWLINE;
+        t->len = 2;
+      }
+    }
+    else if (_mytoml_is_comment_start(c))
+    {
+      t->type = T_COMMENT;
+      t->len = _mytoml_lexer_scan(tok, start + 1, SCAN_COMMENT) - start;
+    }
+    else if (_mytoml_is_bare_ascii(c))
+    {
+      t->type = T_BARE;
+      t->len = _mytoml_lexer_run(tok, start + 1, _mytoml_is_bare_ascii) - start;
+    }
+    else if (_mytoml_is_basic_string_start(c) ||
+             _mytoml_is_literal_string_start(c))
+    {
+      // only strings that can be copied verbatim are lexed whole,
+      // `""` followed by a third quote opens a multi-line string
+      bool basic = _mytoml_is_basic_string_start(c);
+      size_t end = _mytoml_lexer_scan(
+          tok, start + 1, basic ? SCAN_BASIC_STRING : SCAN_LITERAL_STRING);
+      if (_mytoml_tokenizer_byte_at(tok, end) == c &&
+          (end > start + 1 || _mytoml_tokenizer_byte_at(tok, end + 1) != c))
+      {
+        t->type = basic ? T_BASIC_STRING : T_LITERAL_STRING;
+        t->len = end + 1 - start;
+      }
+    }
+    return t->type;
+  }
+
+  TokenType _mytoml_lexer_number(Tokenizer *tok, Token *t)
+  {
+    size_t start = tok->cursor - 1;
+    t->type = T_NUMBER;
+    t->start = start;
+    t->len = _mytoml_lexer_run(tok, start, _mytoml_is_number_char) - start;
+    return t->type;
+  }
+
+  //-----------------------------------------------------------------------------
+  // [SECTION] Myjson Allocator
+  //-----------------------------------------------------------------------------
+
+  static void *_mytoml_libc_malloc(size_t size, void *ctx)
+  {
+    (void)ctx;
+    return malloc(size);
+  }
+
+  static void *_mytoml_libc_realloc(void *ptr, size_t size, void *ctx)
+  {
+    (void)ctx;
+    return realloc(ptr, size);
+  }
+
+  static void _mytoml_libc_free(void *ptr, void *ctx)
+  {
+    (void)ctx;
+    free(ptr);
+  }
+
+  static const TomlAllocator _mytoml_allocator_libc = {
+      _mytoml_libc_malloc, _mytoml_libc_realloc, _mytoml_libc_free, NULL};
+
+  // allocator used outside of a parse, see `toml_set_allocator`
+  static TomlAllocator _mytoml_allocator_global = {
+      _mytoml_libc_malloc, _mytoml_libc_realloc, _mytoml_libc_free, NULL};
+
+  // allocator of the parse running on this thread
+  static MYTOML_THREAD_LOCAL const TomlAllocator *_mytoml_allocator_current =
+      NULL;
+
+  static inline const TomlAllocator *_mytoml_allocator(void)
+  {
+    return _mytoml_allocator_current ? _mytoml_allocator_current
+                                     : &_mytoml_allocator_global;
+  }
+
+  void *_mytoml_malloc(size_t size)
+  {
+    const TomlAllocator *a = _mytoml_allocator();
+    return a->malloc_fn(size, a->ctx);
+  }
+
+  void *_mytoml_calloc(size_t n, size_t size)
+  {
+    if (size && n > SIZE_MAX / size)
+      return NULL;
+    void *p = _mytoml_malloc(n * size);
+    if (p)
+      memset(p, 0, n * size);
+    return p;
+  }
+
+  void *_mytoml_realloc(void *ptr, size_t size)
+  {
+    const TomlAllocator *a = _mytoml_allocator();
+    return a->realloc_fn(ptr, size, a->ctx);
+  }
+
+  void _mytoml_free(void *ptr)
+  {
+    const TomlAllocator *a = _mytoml_allocator();
+    if (ptr)
+      a->free_fn(ptr, a->ctx);
+  }
+
+  //-----------------------------------------------------------------------------
+  // [SECTION] Myjson Arena
+  //-----------------------------------------------------------------------------
+
+  // arena of the document being parsed on this thread
+  static MYTOML_THREAD_LOCAL TomlArena *_mytoml_arena_current = NULL;
+
+  static inline char *_mytoml_arena_block_data(ArenaBlock *b)
+  {
+    return (char *)b + MYTOML_ARENA_ROUND(sizeof(ArenaBlock));
+  }
+
+  static ArenaBlock *_mytoml_arena_block_new(const TomlAllocator *a,
+                                             size_t size)
+  {
+    ArenaBlock *b = (ArenaBlock *)a->malloc_fn(
+        MYTOML_ARENA_ROUND(sizeof(ArenaBlock)) + size, a->ctx);
+    RETURN_IF_FAILED(b, "failed to allocate arena block\n");
+    b->next = NULL;
+    b->size = size;
+    b->used = 0;
+    return b;
+  }
+
+  TomlArena *_mytoml_arena_new(const TomlAllocator *allocator)
+  {
+    ArenaBlock *b = _mytoml_arena_block_new(allocator, MYTOML_ARENA_BLOCK_SIZE);
+    if (!b)
+      return NULL;
+    TomlArena *arena = (TomlArena *)_mytoml_arena_block_data(b);
+    b->used = MYTOML_ARENA_ROUND(sizeof(TomlArena));
+    arena->head = b;
+    arena->allocator = *allocator;
+    arena->reserved = MYTOML_ARENA_ROUND(sizeof(ArenaBlock)) + b->size;
+    arena->ids = 0;
+    arena->id_bytes = 0;
+    return arena;
+  }
+
+  void *_mytoml_arena_alloc(TomlArena *arena, size_t size)
+  {
+    size = MYTOML_ARENA_ROUND(size);
+    ArenaBlock *b = arena->head;
+    if (b->size - b->used < size)
+    {
+      if (size > MYTOML_ARENA_BLOCK_SIZE / 4)
+      {
+        ArenaBlock *big = _mytoml_arena_block_new(&arena->allocator, size);
+        if (!big)
+          return NULL;
+        big->used = size;
+        big->next = b->next;
+        b->next = big;
+        arena->reserved += MYTOML_ARENA_ROUND(sizeof(ArenaBlock)) + size;
+        memset(_mytoml_arena_block_data(big), 0, size);
+        return _mytoml_arena_block_data(big);
+      }
+      b = _mytoml_arena_block_new(&arena->allocator, MYTOML_ARENA_BLOCK_SIZE);
+      if (!b)
+        return NULL;
+      b->next = arena->head;
+      arena->head = b;
+      arena->reserved += MYTOML_ARENA_ROUND(sizeof(ArenaBlock)) + b->size;
+    }
+    void *p = _mytoml_arena_block_data(b) + b->used;
+    b->used += size;
+    // blocks come straight from the allocator, so zero each piece
+    // as it is handed out rather than whole blocks up front
+    memset(p, 0, size);
+    return p;
+  }
+
+  void _mytoml_arena_delete(TomlArena *arena)
+  {
+    // the arena lives in one of the blocks it frees
+    TomlAllocator a = arena->allocator;
+    ArenaBlock *b = arena->head;
+    while (b)
+    {
+      ArenaBlock *next = b->next;
+      a.free_fn(b, a.ctx);
+      b = next;
+    }
+  }
+
+  void *_mytoml_alloc(size_t size)
+  {
+    if (_mytoml_arena_current)
+      return _mytoml_arena_alloc(_mytoml_arena_current, size);
+    return _mytoml_calloc(1, size);
+  }
+
+  void *_mytoml_kmalloc(size_t size)
+  {
+    bool arena = _mytoml_arena_current != NULL;
+    KAllocHeader *h =
+        arena ? (KAllocHeader *)_mytoml_arena_alloc(_mytoml_arena_current,
+                                                    sizeof(KAllocHeader) + size)
+              : (KAllocHeader *)_mytoml_malloc(sizeof(KAllocHeader) + size);
+    if (!h)
+      return NULL;
+    h->info.size = size;
+    h->info.arena = arena;
+    return h + 1;
+  }
+
+  void *_mytoml_kcalloc(size_t n, size_t size)
+  {
+    if (size && n > (SIZE_MAX - sizeof(KAllocHeader)) / size)
+      return NULL;
+    void *p = _mytoml_kmalloc(n * size);
+    if (p)
+      memset(p, 0, n * size);
+    return p;
+  }
+
+  void *_mytoml_krealloc(void *ptr, size_t size)
+  {
+    if (!ptr)
+      return _mytoml_kmalloc(size);
+    KAllocHeader *h = (KAllocHeader *)ptr - 1;
+    if (!h->info.arena)
+    {
+      h = (KAllocHeader *)_mytoml_realloc(h, sizeof(KAllocHeader) + size);
+      if (!h)
+        return NULL;
+      h->info.size = size;
+      return h + 1;
+    }
+    // arena blocks cannot grow in place, the old copy is reclaimed with
+    // the rest of the document
+    void *p = _mytoml_kmalloc(size);
+    if (p)
+      memcpy(p, ptr, h->info.size < size ? h->info.size : size);
+    return p;
+  }
+
+  void _mytoml_kfree(void *ptr)
+  {
+    if (!ptr)
+      return;
+    KAllocHeader *h = (KAllocHeader *)ptr - 1;
+    if (!h->info.arena)
+      _mytoml_free(h);
+  }
+
+  //-----------------------------------------------------------------------------
+  // [SECTION] Myjson Value
+  //-----------------------------------------------------------------------------
+
+  TomlValue *_mytoml_value_new_string(const char *s)
+  {
+    return _mytoml_value_new_stringn(s, strlen(s));
+  }
+
+  TomlValue *_mytoml_value_new_stringn(const char *s, size_t len)
+  {
+    TomlValue *v = (TomlValue *)_mytoml_alloc(sizeof(TomlValue) + len + 1);
+    RETURN_IF_FAILED(v, "failed to allocate string\n");
+    v->type = TOML_STRING;
+    v->string = (char *)(v + 1);
+    v->len = len;
+    memcpy(v->string, s, len);
+    return v;
+  }
+
+  TomlValue *_mytoml_value_new_number(double *d, TomlValueType type,
+                                      size_t precision, bool scientific)
+  {
+    TomlValue *v = (TomlValue *)_mytoml_alloc(sizeof(TomlValue));
+    RETURN_IF_FAILED(v, "failed to allocate number\n");
+    v->type = type;
+    v->scientific = scientific;
+    // digits past a double's precision print as zeros anyway
+    v->precision = precision < USHRT_MAX ? precision : USHRT_MAX;
+    if (type == TOML_BOOL)
+    {
+      v->boolean = *d != 0;
+    }
+    else
+    {
+      v->number = *d;
+    }
+    return v;
+  }
+
+  TomlValue *_mytoml_value_new_integer(int64_t i)
+  {
+    TomlValue *v = (TomlValue *)_mytoml_alloc(sizeof(TomlValue));
+    RETURN_IF_FAILED(v, "failed to allocate integer\n");
+    v->type = TOML_INT;
+    v->precision = 0;
+    v->scientific = false;
+    v->integer = i;
+    if (i >= INT_MIN && i <= INT_MAX)
+      v->narrow = (int)i;
+    return v;
+  }
+
+  TomlValue *_mytoml_value_new_datetime(const TomlDatetime *dt)
+  {
+    TomlValue *v = (TomlValue *)_mytoml_alloc(sizeof(TomlValue));
+    RETURN_IF_FAILED(v, "failed to allocate datetime\n");
+    if (dt->flags & MYTOML_DATETIME_OFFSET)
+      v->type = TOML_DATETIME;
+    else if (!(dt->flags & MYTOML_DATETIME_TIME))
+      v->type = TOML_DATELOCAL;
+    else if (!(dt->flags & MYTOML_DATETIME_DATE))
+      v->type = TOML_TIMELOCAL;
+    else
+      v->type = TOML_DATETIMELOCAL;
+    v->precision = 0;
+    v->scientific = false;
+    v->datetime = *dt;
+    return v;
+  }
+
+  TomlValue *_mytoml_value_new_array()
+  {
+    TomlValue *v = (TomlValue *)_mytoml_alloc(sizeof(TomlValue));
+    RETURN_IF_FAILED(v, "failed to allocate array\n");
     v->type = TOML_ARRAY;
-    v->arr =
-        (TomlValue **)calloc(1, sizeof(TomlValue *) * MYTOML_MAX_ARRAY_LENGTH);
+    v->arr = NULL;
     v->len = 0;
     return v;
   }
 
-  TomlValue *_mytoml_value_new_table(TomlKey *k)
+  // slots allocated for an array of `len` values, as it grows from
+  // MYTOML_ARRAY_MIN_CAPACITY by doubling
+  static inline size_t _mytoml_value_array_cap(size_t len)
+  {
+    size_t cap = len ? MYTOML_ARRAY_MIN_CAPACITY : 0;
+    while (cap < len)
+      cap *= 2;
+    return cap;
+  }
+
+  bool _mytoml_value_array_push(TomlValue *array, TomlValue *v)
+  {
+    size_t len = array->len;
+    // full when empty or at a power of two past the first allocation
+    if (!len || (len >= MYTOML_ARRAY_MIN_CAPACITY && !(len & (len - 1))))
+    {
+      // the old buffer is reclaimed with the rest of the document
+      size_t cap = len ? len * 2 : MYTOML_ARRAY_MIN_CAPACITY;
+      TomlValue **arr = (TomlValue **)_mytoml_alloc(sizeof(TomlValue *) * cap);
+      if (!arr)
+        return false;
+      if (len)
+        memcpy(arr, array->arr, sizeof(TomlValue *) * len);
+      array->arr = arr;
+    }
+    array->arr[array->len++] = v;
+    return true;
+  }
+
+  TomlValue *_mytoml_value_new_table(TomlKey *k)
+  {
+    RETURN_IF_FAILED(k, "no keys for inline table\n");
+    TomlValue *v = (TomlValue *)_mytoml_alloc(sizeof(TomlValue));
+    RETURN_IF_FAILED(v, "failed to allocate inline table\n");
+    v->type = TOML_INLINETABLE;
+    TomlKey *h = _mytoml_value_new_key(TOML_KEY);
+    RETURN_IF_FAILED(h, "failed to allocate inline table\n");
+    size_t it = 0;
+    for (TomlKey *sub; (sub = toml_key_next(k, &it));)
+    {
+      RETURN_IF_FAILED(_mytoml_value_add_sub_key(h, sub),
+                       "could not add inline table key %s\n", sub->id.str);
+    }
+    v->table = h;
+    return v;
+  }
+
+  //-----------------------------------------------------------------------------
+  // [SECTION] Myjson Key
+  //-----------------------------------------------------------------------------
+
+  TomlKey *_mytoml_value_new_key(TomlKeyType type)
+  {
+    TomlKey *k = (TomlKey *)_mytoml_alloc(sizeof(TomlKey));
+    RETURN_IF_FAILED(k, "failed to allocate key\n");
+    k->type = type;
+    k->value = NULL;
+    // subkey storage is allocated with the first subkey
+    k->len = 0;
+    k->small = NULL;
+    k->id.str = "";
+    k->id.len = 0;
+    k->id.hash = 0;
+    return k;
+  }
+
+  TomlId _mytoml_value_new_id(const char *s, size_t len)
+  {
+    TomlId id = {NULL, (khint32_t)len, _mytoml_id_hash_bytes(s, len)};
+    char *str = len < UINT32_MAX ? (char *)_mytoml_alloc(len + 1) : NULL;
+    if (str)
+    {
+      memcpy(str, s, len);
+      id.str = str;
+    }
+    return id;
+  }
+
+  bool _mytoml_value_id_append(TomlId *id, size_t *cap, const char *s,
+                               size_t len)
+  {
+    if (len >= UINT32_MAX - id->len)
+      return false;
+    if (id->len + len + 1 > *cap)
+    {
+      // the old buffer is reclaimed with the rest of the document
+      size_t grown = *cap ? *cap * 2 : 16;
+      while (grown < id->len + len + 1)
+        grown *= 2;
+      char *str = (char *)_mytoml_alloc(grown);
+      if (!str)
+        return false;
+      memcpy(str, id->str, id->len);
+      id->str = str;
+      *cap = grown;
+    }
+    char *str = (char *)id->str;
+    memcpy(str + id->len, s, len);
+    id->len += len;
+    str[id->len] = '\0';
+    return true;
+  }
+
+  TomlKey *_mytoml_value_has_sub_key(const TomlKey *key, TomlId id)
+  {
+    if (key->len > MYTOML_SMALL_TABLE_SIZE)
+    {
+      const khash_t(id) *h = &key->subkeys->table;
+      khiter_t k = kh_get(id, h, id);
+      if (k == kh_end(h))
+        return NULL;
+      return kh_value(h, k);
+    }
+    const TomlSmallTable *t = key->small;
+    if (!t)
+      return NULL;
+#if MYTOML_SIMD_X86 && MYTOML_SMALL_TABLE_SIZE % 4 == 0
+    // one bit per slot whose hash matches, slots past `len` masked off
+    __m128i h = _mm_set1_epi32((int)id.hash);
+    unsigned match = 0;
+    for (int i = 0; i < MYTOML_SMALL_TABLE_SIZE; i += 4)
+    {
+      __m128i v = _mm_loadu_si128((const __m128i *)(t->hash + i));
+      __m128i eq = _mm_cmpeq_epi32(v, h);
+      match |= (unsigned)_mm_movemask_ps(_mm_castsi128_ps(eq)) << i;
+    }
+    match &= (unsigned)(((unsigned long long)1 << key->len) - 1);
+    while (match)
+    {
+      int i = __builtin_ctz(match);
+      if (_mytoml_id_equal(t->keys[i]->id, id))
+        return t->keys[i];
+      match &= match - 1;
+    }
+#else
+    for (khint32_t i = 0; i < key->len; i++)
+    {
+      if (t->hash[i] == id.hash && _mytoml_id_equal(t->keys[i]->id, id))
+        return t->keys[i];
+    }
+#endif
+    return NULL;
+  }
+
+  TomlKey *_mytoml_value_put_sub_key(TomlKey *key, TomlKey *subkey)
+  {
+    if (key->len < MYTOML_SMALL_TABLE_SIZE)
+    {
+      if (!key->small)
+      {
+        key->small = (TomlSmallTable *)_mytoml_alloc(sizeof(TomlSmallTable));
+        RETURN_IF_FAILED(key->small, "failed to allocate subkeys\n");
+      }
+      key->small->hash[key->len] = subkey->id.hash;
+      key->small->keys[key->len] = subkey;
+      key->len++;
+      return subkey;
+    }
+    int ret;
+    if (key->len == MYTOML_SMALL_TABLE_SIZE)
+    {
+      // the small table is full, move its keys into a hash table
+      // sized so that it does not have to grow again right away.
+      // The small table was allocated from the document arena and
+      // goes with it, `key->small` is only overwritten once the
+      // hash table holds every key
+      TomlSmallTable *t = key->small;
+      TomlKeyTable *table =
+          (TomlKeyTable *)_mytoml_kcalloc(1, sizeof(TomlKeyTable));
+      RETURN_IF_FAILED(table, "failed to allocate subkeys\n");
+      khash_t(id) *h = &table->table;
+      bool ok = kh_resize(id, h, 4 * MYTOML_SMALL_TABLE_SIZE) == 0;
+      for (int i = 0; ok && i < MYTOML_SMALL_TABLE_SIZE; i++)
+      {
+        khiter_t k = kh_put(id, h, t->keys[i]->id, &ret);
+        ok = ret >= 0;
+        if (ok)
+          kh_value(h, k) = t->keys[i];
+      }
+      FUNC_IF_FAILED(ok, kh_destroy, id, h);
+      RETURN_IF_FAILED(ok, "failed to allocate subkeys\n");
+      key->subkeys = table;
+    }
+    khash_t(id) *h = &key->subkeys->table;
+    khiter_t k = kh_put(id, h, subkey->id, &ret);
+    RETURN_IF_FAILED(ret >= 0, "failed to allocate subkeys\n");
+    kh_value(h, k) = subkey;
+    key->len++;
+    return subkey;
+  }
+
+  TomlKey *_mytoml_value_add_sub_key(TomlKey *key, TomlKey *subkey)
+  {
+    TomlKey *s = _mytoml_value_has_sub_key(key, subkey->id);
+    if (s)
+    {
+      if (_mytoml_value_keys_compatible(s->type, subkey->type))
+      {
+        // re-defining a TABLE as a TABLELEAF
+        // is allowed only once
+        if (subkey->type == TOML_TABLELEAF)
+        {
+          s->type = TOML_TABLELEAF;
+        }
+        return s;
+      }
+      else
+      {
+        RETURN_IF_FAILED(0,
+                         "failed to add subkey\n"
+                         "existing subkey - key: %s type: %d\n"
+                         "new subkey: key: %s type: %d\n",
+                         s->id.str, (int)(s->type), subkey->id.str,
+                         (int)(subkey->type));
+      }
+    }
+    if (key->type == TOML_ARRAYTABLE)
+    {
+      // since an ARRAYTABLE is a list of a map of key-value,
+      // and re-defining an ARRAYTABLE means adding another map
+      // of key-value to the list, we use the `value->arr`
+      // attribute of the key to store each map of key-values
+      return _mytoml_value_add_sub_key(
+          key->value->arr[key->value->len - 1]->table, subkey);
+    }
+    return _mytoml_value_put_sub_key(key, subkey);
+  }
+
+  bool _mytoml_value_keys_compatible(TomlKeyType existing, TomlKeyType current)
+  {
+    // re-definition rules
+    // [existing]
+    // [current]
+
+    // `a = b`
+    // `a = c`
+    if (existing == TOML_KEYLEAF)
+    {
+      return false;
+    }
+    // `[a.b]`
+    // `[a.b]`
+    if (existing == TOML_TABLELEAF && current == TOML_TABLELEAF)
+    {
+      return false;
+    }
+    // `[a.b] or b.c = d`
+    // `[a.b.e] or [b.e]`
+    if ((existing == TOML_TABLELEAF || existing == TOML_KEY) &&
+        current == TOML_TABLE)
+    {
+      return true;
+    }
+    // `[a.b]`
+    // `[a]`
+    if (existing == TOML_TABLE && current == TOML_TABLELEAF)
+    {
+      return true;
+    }
+    // `[[t]]`
+    // `[t.s]`
+    if (existing == TOML_ARRAYTABLE && current == TOML_TABLE)
+    {
+      return true;
+    }
+    if (current == existing)
+    {
+      return true;
+    }
+    return false;
+  }
+
+  //-----------------------------------------------------------------------------
+  // [SECTION] Myjson Stats
+  //-----------------------------------------------------------------------------
+
+  // arena bytes taken by a khash allocation of `size` bytes
+  static inline size_t _mytoml_stats_kalloc(size_t size)
+  {
+    return MYTOML_ARENA_ROUND(sizeof(KAllocHeader) + size);
+  }
+
+  void _mytoml_stats_key(const TomlKey *key, TomlMemoryStats *stats)
+  {
+    stats->key_count++;
+    stats->key_bytes += MYTOML_ARENA_ROUND(sizeof(TomlKey));
+    if (key->len > 0 && key->len <= MYTOML_SMALL_TABLE_SIZE)
+    {
+      stats->small_count++;
+      stats->table_bytes += MYTOML_ARENA_ROUND(sizeof(TomlSmallTable));
+    }
+    else if (key->len > MYTOML_SMALL_TABLE_SIZE)
+    {
+      // the small table it was promoted from is left as slack
+      const khash_t(id) *h = &key->subkeys->table;
+      khint_t n = kh_n_buckets(h);
+      stats->table_count++;
+      stats->bucket_count += n;
+      stats->table_bytes += _mytoml_stats_kalloc(sizeof(*h));
+      if (n)
+      {
+        // same sizes as kh_resize asks for
+        stats->table_bytes +=
+            _mytoml_stats_kalloc(((n >> 4) + 1) * sizeof(khint32_t)) +
+            _mytoml_stats_kalloc(n * sizeof(TomlId)) +
+            _mytoml_stats_kalloc(n * sizeof(TomlKey *));
+      }
+    }
+    size_t it = 0;
+    for (TomlKey *sub; (sub = toml_key_next(key, &it));)
+    {
+      _mytoml_stats_key(sub, stats);
+    }
+    if (key->value)
+    {
+      _mytoml_stats_value(key->value, stats);
+    }
+  }
+
+  void _mytoml_stats_value(const TomlValue *value, TomlMemoryStats *stats)
+  {
+    size_t bytes = MYTOML_ARENA_ROUND(sizeof(TomlValue));
+    switch (value->type)
+    {
+    case TOML_STRING:
+      // the text shares the allocation of the value node
+      stats->string_bytes +=
+          MYTOML_ARENA_ROUND(sizeof(TomlValue) + value->len + 1) - bytes;
+      break;
+    case TOML_ARRAY:
+      if (value->len)
+      {
+        size_t cap = _mytoml_value_array_cap(value->len);
+        bytes += MYTOML_ARENA_ROUND(sizeof(TomlValue *) * cap);
+      }
+      for (size_t i = 0; i < value->len; i++)
+      {
+        _mytoml_stats_value(value->arr[i], stats);
+      }
+      break;
+    case TOML_INLINETABLE:
+      _mytoml_stats_key(value->table, stats);
+      break;
+    default:
+      break;
+    }
+    stats->value_count[value->type]++;
+    stats->value_bytes[value->type] += bytes;
+  }
+
+  //-----------------------------------------------------------------------------
+  // [SECTION] Myjson Frozen
+  //-----------------------------------------------------------------------------
+
+  static inline TomlFrozenNode *_mytoml_frozen_node(FrozenBuilder *b,
+                                                    khint32_t off)
+  {
+    return (TomlFrozenNode *)(b->data + off);
+  }
+
+  // spreads the bits of an id hash so its top bits pick a bucket
+  static inline khint32_t _mytoml_frozen_mix(khint32_t h)
+  {
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+  }
+
+  // bucket bits of a table of `n` keys, small tables are one bucket
+  static inline khint32_t _mytoml_frozen_bits(size_t n)
+  {
+    khint32_t bits = 0;
+    if (n > MYTOML_SMALL_TABLE_SIZE)
+    {
+      while (((size_t)1 << bits) < n)
+        bits++;
+    }
+    return bits;
+  }
+
+  static inline khint32_t _mytoml_frozen_bucket(khint32_t hash, khint32_t bits)
+  {
+    return bits ? hash >> (32 - bits) : 0;
+  }
+
+  // bytes taken by the index in front of the entries of a table
+  static inline size_t _mytoml_frozen_index_size(khint32_t bits)
+  {
+    size_t size = (((size_t)1 << bits) + 2) * sizeof(khint32_t);
+    return (size + MYTOML_FROZEN_ALIGN - 1) &
+           ~(size_t)(MYTOML_FROZEN_ALIGN - 1);
+  }
+
+  static inline const FrozenEntry *
+  _mytoml_frozen_entries(const TomlFrozen *doc, const TomlFrozenNode *table)
+  {
+    const char *index = (const char *)doc + table->off;
+    return (const FrozenEntry *)(index + _mytoml_frozen_index_size(
+                                             *(const khint32_t *)index));
+  }
+
+  // order of the entries of a frozen table, by hash, then by bytes so
+  // the order does not depend on the order keys were parsed in
+  static int _mytoml_frozen_sort(const void *a, const void *b)
+  {
+    const TomlId *ia = &(*(const TomlKey *const *)a)->id;
+    const TomlId *ib = &(*(const TomlKey *const *)b)->id;
+    khint32_t ha = _mytoml_frozen_mix(ia->hash);
+    khint32_t hb = _mytoml_frozen_mix(ib->hash);
+    if (ha != hb)
+      return ha < hb ? -1 : 1;
+    int c = memcmp(ia->str, ib->str, ia->len < ib->len ? ia->len : ib->len);
+    if (c != 0)
+      return c;
+    return ia->len < ib->len ? -1 : ia->len > ib->len;
+  }
+
+  bool _mytoml_frozen_reserve(FrozenBuilder *b, size_t size, khint32_t *off)
+  {
+    size_t start = (b->size + MYTOML_FROZEN_ALIGN - 1) &
+                   ~(size_t)(MYTOML_FROZEN_ALIGN - 1);
+    if (size > UINT32_MAX - start)
+    {
+      LOG_ERR("frozen document does not fit 32-bit offsets\n");
+      return false;
+    }
+    if (start + size > b->cap)
+    {
+      size_t cap = b->cap ? b->cap : 4096;
+      while (cap < start + size)
+        cap *= 2;
+      char *data = (char *)_mytoml_realloc(b->data, cap);
+      if (!data)
+      {
+        LOG_ERR("failed to grow frozen document\n");
+        return false;
+      }
+      b->data = data;
+      b->cap = cap;
+    }
+    memset(b->data + b->size, 0, start + size - b->size);
+    b->size = start + size;
+    *off = (khint32_t)start;
+    return true;
+  }
+
+  bool _mytoml_frozen_key(FrozenBuilder *b, const TomlKey *key,
+                          khint32_t node)
+  {
+    // the value of an array of tables is an array of inline tables
+    if (key->value)
+      return _mytoml_frozen_value(b, key->value, node);
+    return _mytoml_frozen_table(b, key, node);
+  }
+
+  bool _mytoml_frozen_table(FrozenBuilder *b, const TomlKey *key,
+                            khint32_t node)
+  {
+    size_t n = key->len;
+    _mytoml_frozen_node(b, node)->type = TOML_INLINETABLE;
+    if (n == 0)
+      return true;
+    TomlKey **subs = (TomlKey **)_mytoml_malloc(n * sizeof(TomlKey *));
+    RETURN_IF_FAILED(subs, "failed to allocate frozen table\n");
+    size_t it = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+      subs[i] = toml_key_next(key, &it);
+    }
+    qsort(subs, n, sizeof(TomlKey *), _mytoml_frozen_sort);
+
+    // index, entries and key bytes of one table sit together, so a
+    // lookup only touches the values below the key it finds
+    khint32_t index;
+    khint32_t bits = _mytoml_frozen_bits(n);
+    size_t index_size = _mytoml_frozen_index_size(bits);
+    bool ok =
+        _mytoml_frozen_reserve(b, index_size + n * sizeof(FrozenEntry), &index);
+    size_t entries = index + index_size;
+    for (size_t i = 0; ok && i < n; i++)
+    {
+      khint32_t str;
+      ok = _mytoml_frozen_reserve(b, subs[i]->id.len + 1, &str);
+      if (ok)
+      {
+        FrozenEntry *e = (FrozenEntry *)(b->data + entries) + i;
+        memcpy(b->data + str, subs[i]->id.str, subs[i]->id.len);
+        e->hash = _mytoml_frozen_mix(subs[i]->id.hash);
+        e->key = str;
+        e->key_len = subs[i]->id.len;
+      }
+    }
+    if (ok)
+    {
+      khint32_t *start = (khint32_t *)(b->data + index);
+      const FrozenEntry *e = (const FrozenEntry *)(b->data + entries);
+      *start++ = bits;
+      size_t i = 0;
+      for (size_t t = 0; t <= ((size_t)1 << bits); t++)
+      {
+        while (i < n && _mytoml_frozen_bucket(e[i].hash, bits) < t)
+          i++;
+        start[t] = (khint32_t)i;
+      }
+    }
+    if (ok && b->depth == MYTOML_FROZEN_MAX_DEPTH)
+    {
+      LOG_ERR("frozen document nests too deep\n");
+      ok = false;
+    }
+    b->depth++;
+    for (size_t i = 0; ok && i < n; i++)
+    {
+      size_t value =
+          entries + i * sizeof(FrozenEntry) + offsetof(FrozenEntry, value);
+      ok = _mytoml_frozen_key(b, subs[i], (khint32_t)value);
+    }
+    b->depth--;
+    _mytoml_free(subs);
+    if (ok)
+    {
+      TomlFrozenNode *t = _mytoml_frozen_node(b, node);
+      t->len = (khint32_t)n;
+      t->off = index;
+    }
+    return ok;
+  }
+
+  bool _mytoml_frozen_value(FrozenBuilder *b, const TomlValue *value,
+                            khint32_t node)
+  {
+    khint32_t off = 0;
+    switch (value->type)
+    {
+    case TOML_INT:
+      _mytoml_frozen_node(b, node)->integer = value->integer;
+      break;
+    case TOML_FLOAT:
+      _mytoml_frozen_node(b, node)->number = value->number;
+      break;
+    case TOML_BOOL:
+      _mytoml_frozen_node(b, node)->boolean = value->boolean;
+      break;
+    case TOML_STRING:
+      if (!_mytoml_frozen_reserve(b, value->len + 1, &off))
+        return false;
+      memcpy(b->data + off, value->string, value->len);
+      break;
+    case TOML_ARRAY:
+      if (value->len == 0)
+        break;
+      if (b->depth == MYTOML_FROZEN_MAX_DEPTH)
+      {
+        LOG_ERR("frozen document nests too deep\n");
+        return false;
+      }
+      if (!_mytoml_frozen_reserve(b, value->len * sizeof(TomlFrozenNode), &off))
+        return false;
+      b->depth++;
+      for (size_t i = 0; i < value->len; i++)
+      {
+        size_t elem = off + i * sizeof(TomlFrozenNode);
+        if (!_mytoml_frozen_value(b, value->arr[i], (khint32_t)elem))
+          return false;
+      }
+      b->depth--;
+      break;
+    case TOML_DATETIME:
+    case TOML_DATELOCAL:
+    case TOML_TIMELOCAL:
+    case TOML_DATETIMELOCAL:
+      if (!_mytoml_frozen_reserve(b, sizeof(TomlDatetime), &off))
+        return false;
+      memcpy(b->data + off, &value->datetime, sizeof(TomlDatetime));
+      break;
+    case TOML_INLINETABLE:
+      return _mytoml_frozen_table(b, value->table, node);
+    default:
+      break;
+    }
+    TomlFrozenNode *n = _mytoml_frozen_node(b, node);
+    n->type = value->type;
+    if (value->type == TOML_STRING || value->type == TOML_ARRAY)
+      n->len = (khint32_t)value->len;
+    if (off)
+      n->off = off;
+    return true;
+  }
+
+  // whether the `size` bytes at `off` are the next piece after `*end`,
+  // moving `*end` past them
+  static bool _mytoml_frozen_piece(const TomlFrozen *doc, size_t *end,
+                                   khint32_t off, size_t size)
+  {
+    size_t start = (*end + MYTOML_FROZEN_ALIGN - 1) &
+                   ~(size_t)(MYTOML_FROZEN_ALIGN - 1);
+    if (off != start || start > doc->size || size > doc->size - start)
+      return false;
+    *end = start + size;
+    return true;
+  }
+
+  // whether the `len` bytes at `off` are the next piece after `*end`,
+  // followed by a NUL
+  static bool _mytoml_frozen_bytes(const TomlFrozen *doc, size_t *end,
+                                   khint32_t off, khint32_t len)
+  {
+    return _mytoml_frozen_piece(doc, end, off, (size_t)len + 1) &&
+           ((const char *)doc)[off + (size_t)len] == '\0';
+  }
+
+  bool _mytoml_frozen_check(const TomlFrozen *doc, const TomlFrozenNode *node,
+                            size_t *end, size_t depth)
+  {
+    const char *base = (const char *)doc;
+    switch (node->type)
+    {
+    case TOML_INT:
+    case TOML_FLOAT:
+      return true;
+    case TOML_BOOL:
+    {
+      unsigned char byte;
+      memcpy(&byte, &node->boolean, 1);
+      return byte <= 1;
+    }
+    case TOML_STRING:
+      return _mytoml_frozen_bytes(doc, end, node->off, node->len);
+    case TOML_DATETIME:
+    case TOML_DATELOCAL:
+    case TOML_TIMELOCAL:
+    case TOML_DATETIMELOCAL:
+      return _mytoml_frozen_piece(doc, end, node->off, sizeof(TomlDatetime));
+    case TOML_ARRAY:
+    {
+      if (node->len == 0)
+        return true;
+      if (depth == MYTOML_FROZEN_MAX_DEPTH ||
+          node->len > doc->size / sizeof(TomlFrozenNode) ||
+          !_mytoml_frozen_piece(doc, end, node->off,
+                                node->len * sizeof(TomlFrozenNode)))
+        return false;
+      const TomlFrozenNode *elems = (const TomlFrozenNode *)(base + node->off);
+      for (khint32_t i = 0; i < node->len; i++)
+      {
+        if (!_mytoml_frozen_check(doc, &elems[i], end, depth + 1))
+          return false;
+      }
+      return true;
+    }
+    case TOML_INLINETABLE:
+      break;
+    default:
+      return false;
+    }
+
+    khint32_t n = node->len;
+    if (n == 0)
+      return true;
+    khint32_t bits = _mytoml_frozen_bits(n);
+    size_t index_size = _mytoml_frozen_index_size(bits);
+    if (depth == MYTOML_FROZEN_MAX_DEPTH ||
+        n > doc->size / sizeof(FrozenEntry) ||
+        !_mytoml_frozen_piece(doc, end, node->off,
+                              index_size + n * sizeof(FrozenEntry)))
+      return false;
+    const khint32_t *index = (const khint32_t *)(base + node->off);
+    const FrozenEntry *e =
+        (const FrozenEntry *)((const char *)index + index_size);
+    if (index[0] != bits || index[1] != 0 || index[1 + (1u << bits)] != n)
+      return false;
+    // the entries of bucket `t` are the ones its hash bits pick, in
+    // ascending hash order
+    for (khint32_t t = 0; t < (1u << bits); t++)
+    {
+      if (index[2 + t] < index[1 + t] || index[2 + t] > n)
+        return false;
+      for (khint32_t i = index[1 + t]; i < index[2 + t]; i++)
+      {
+        if (_mytoml_frozen_bucket(e[i].hash, bits) != t ||
+            (i > 0 && e[i].hash < e[i - 1].hash))
+          return false;
+      }
+    }
+    for (khint32_t i = 0; i < n; i++)
+    {
+      if (!_mytoml_frozen_bytes(doc, end, e[i].key, e[i].key_len) ||
+          e[i].hash != _mytoml_frozen_mix(_mytoml_id_hash_bytes(
+                           base + e[i].key, e[i].key_len)))
+        return false;
+    }
+    for (khint32_t i = 0; i < n; i++)
+    {
+      if (!_mytoml_frozen_check(doc, &e[i].value, end, depth + 1))
+        return false;
+    }
+    return true;
+  }
+
+  //-----------------------------------------------------------------------------
+  // [SECTION] Myjson Parser Utils
+  //-----------------------------------------------------------------------------
+
+  // the class of every byte in the low 4 bits and its `CharFlag`s above,
+  // bytes past 0x7F are neither bare nor control characters
+#define MYTOML_CHAR_CONTROL                                                    \
+  (CF_CONTROL | CF_CONTROL_MULTI | CF_CONTROL_LITERAL | CF_BASIC_STOP |        \
+   CF_LITERAL_STOP)
+#define MYTOML_CHAR_DIGIT (C_DIGIT | CF_BARE | CF_NUMBER)
+#define MYTOML_CHAR_LETTER (C_BARE | CF_BARE | CF_NUMBER)
+#define MYTOML_CHAR_HEX (MYTOML_CHAR_LETTER | CF_HEX)
+  static const unsigned short _mytoml_char_table[256] = {
+      // control characters, tab and the newlines aside
+      [0x00] = MYTOML_CHAR_CONTROL, [0x01] = MYTOML_CHAR_CONTROL,
+      [0x02] = MYTOML_CHAR_CONTROL, [0x03] = MYTOML_CHAR_CONTROL,
+      [0x04] = MYTOML_CHAR_CONTROL, [0x05] = MYTOML_CHAR_CONTROL,
+      [0x06] = MYTOML_CHAR_CONTROL, [0x07] = MYTOML_CHAR_CONTROL,
+      [0x08] = MYTOML_CHAR_CONTROL, [0x0B] = MYTOML_CHAR_CONTROL,
+      [0x0C] = MYTOML_CHAR_CONTROL, [0x0E] = MYTOML_CHAR_CONTROL,
+      [0x0F] = MYTOML_CHAR_CONTROL, [0x10] = MYTOML_CHAR_CONTROL,
+      [0x11] = MYTOML_CHAR_CONTROL, [0x12] = MYTOML_CHAR_CONTROL,
+      [0x13] = MYTOML_CHAR_CONTROL, [0x14] = MYTOML_CHAR_CONTROL,
+      [0x15] = MYTOML_CHAR_CONTROL, [0x16] = MYTOML_CHAR_CONTROL,
+      [0x17] = MYTOML_CHAR_CONTROL, [0x18] = MYTOML_CHAR_CONTROL,
+      [0x19] = MYTOML_CHAR_CONTROL, [0x1A] = MYTOML_CHAR_CONTROL,
+      [0x1B] = MYTOML_CHAR_CONTROL, [0x1C] = MYTOML_CHAR_CONTROL,
+      [0x1D] = MYTOML_CHAR_CONTROL, [0x1E] = MYTOML_CHAR_CONTROL,
+      [0x1F] = MYTOML_CHAR_CONTROL, [0x7F] = MYTOML_CHAR_CONTROL,
+      // whitespace and punctuation
+      ['\t'] = C_BLANK,
+      ['\n'] = C_NEWLINE | CF_CONTROL | CF_BASIC_STOP | CF_LITERAL_STOP,
+      ['\r'] = C_RETURN | CF_CONTROL | CF_CONTROL_LITERAL | CF_BASIC_STOP |
+               CF_LITERAL_STOP,
+      [' '] = C_BLANK,
+      ['"'] = C_BASIC_QUOTE | CF_BASIC_STOP,
+      ['#'] = C_COMMENT,
+      ['\''] = C_LITERAL_QUOTE | CF_LITERAL_STOP,
+      ['+'] = C_SIGN | CF_NUMBER,
+      ['-'] = C_SIGN | CF_BARE | CF_NUMBER,
+      ['.'] = CF_NUMBER,
+      [':'] = CF_NUMBER,
+      ['['] = C_BRACKET,
+      ['\\'] = CF_BASIC_STOP,
+      ['_'] = MYTOML_CHAR_LETTER,
+      ['{'] = C_BRACE,
+      // digits
+      ['0'] = MYTOML_CHAR_DIGIT, ['1'] = MYTOML_CHAR_DIGIT,
+      ['2'] = MYTOML_CHAR_DIGIT, ['3'] = MYTOML_CHAR_DIGIT,
+      ['4'] = MYTOML_CHAR_DIGIT, ['5'] = MYTOML_CHAR_DIGIT,
+      ['6'] = MYTOML_CHAR_DIGIT, ['7'] = MYTOML_CHAR_DIGIT,
+      ['8'] = MYTOML_CHAR_DIGIT, ['9'] = MYTOML_CHAR_DIGIT,
+      // letters
+      ['A'] = MYTOML_CHAR_HEX, ['B'] = MYTOML_CHAR_HEX,
+      ['C'] = MYTOML_CHAR_HEX, ['D'] = MYTOML_CHAR_HEX,
+      ['E'] = MYTOML_CHAR_HEX, ['F'] = MYTOML_CHAR_HEX,
+      ['G'] = MYTOML_CHAR_LETTER, ['H'] = MYTOML_CHAR_LETTER,
+      ['I'] = MYTOML_CHAR_LETTER, ['J'] = MYTOML_CHAR_LETTER,
+      ['K'] = MYTOML_CHAR_LETTER, ['L'] = MYTOML_CHAR_LETTER,
+      ['M'] = MYTOML_CHAR_LETTER, ['N'] = MYTOML_CHAR_LETTER,
+      ['O'] = MYTOML_CHAR_LETTER, ['P'] = MYTOML_CHAR_LETTER,
+      ['Q'] = MYTOML_CHAR_LETTER, ['R'] = MYTOML_CHAR_LETTER,
+      ['S'] = MYTOML_CHAR_LETTER, ['T'] = MYTOML_CHAR_LETTER,
+      ['U'] = MYTOML_CHAR_LETTER, ['V'] = MYTOML_CHAR_LETTER,
+      ['W'] = MYTOML_CHAR_LETTER, ['X'] = MYTOML_CHAR_LETTER,
+      ['Y'] = MYTOML_CHAR_LETTER, ['Z'] = MYTOML_CHAR_LETTER,
+      ['a'] = MYTOML_CHAR_HEX, ['b'] = MYTOML_CHAR_HEX,
+      ['c'] = MYTOML_CHAR_HEX, ['d'] = MYTOML_CHAR_HEX,
+      ['e'] = MYTOML_CHAR_HEX, ['g'] = MYTOML_CHAR_LETTER,
+      ['h'] = MYTOML_CHAR_LETTER, ['j'] = MYTOML_CHAR_LETTER,
+      ['k'] = MYTOML_CHAR_LETTER, ['l'] = MYTOML_CHAR_LETTER,
+      ['m'] = MYTOML_CHAR_LETTER, ['o'] = MYTOML_CHAR_LETTER,
+      ['p'] = MYTOML_CHAR_LETTER, ['q'] = MYTOML_CHAR_LETTER,
+      ['r'] = MYTOML_CHAR_LETTER, ['s'] = MYTOML_CHAR_LETTER,
+      ['u'] = MYTOML_CHAR_LETTER, ['v'] = MYTOML_CHAR_LETTER,
+      ['w'] = MYTOML_CHAR_LETTER, ['x'] = MYTOML_CHAR_LETTER,
+      ['y'] = MYTOML_CHAR_LETTER, ['z'] = MYTOML_CHAR_LETTER,
+      // `t` and `f` start booleans, `i` and `n` start inf and nan
+      ['f'] = C_BOOL | CF_BARE | CF_NUMBER | CF_HEX,
+      ['t'] = C_BOOL | CF_BARE | CF_NUMBER,
+      ['i'] = C_SPECIAL | CF_BARE | CF_NUMBER,
+      ['n'] = C_SPECIAL | CF_BARE | CF_NUMBER,
+  };
+#undef MYTOML_CHAR_CONTROL
+#undef MYTOML_CHAR_DIGIT
+#undef MYTOML_CHAR_LETTER
+#undef MYTOML_CHAR_HEX
+
+  CharClass _mytoml_char_class(char c)
+  {
+    return (CharClass)(_mytoml_char_table[(unsigned char)c] & 0xF);
+  }
+
+  bool _mytoml_char_has(char c, unsigned flags)
+  {
+    return (_mytoml_char_table[(unsigned char)c] & flags) == flags;
+  }
+
+  bool _mytoml_is_whitesapce(char c) { return (c == ' ' || c == '\t'); }
+
+  bool _mytoml_is_newline(char c) { return (c == '\n'); }
+
+  bool _mytoml_is_return(char c) { return (c == '\r'); }
+
+  bool _mytoml_is_comment_start(char c) { return (c == '#'); }
+
+  bool _mytoml_is_equal(char c) { return (c == '='); }
+
+  bool _mytoml_is_escape(char c) { return (c == '\\'); }
+
+  bool _mytoml_is_basic_string_start(char c) { return (c == '"'); }
+
+  bool _mytoml_is_literal_string_start(char c) { return (c == '\''); }
+
+  bool _mytoml_is_table_start(char c) { return (c == '['); }
+
+  bool _mytoml_is_table_end(char c) { return (c == ']'); }
+
+  bool _mytoml_is_inline_table_start(char c) { return (c == '{'); }
+
+  bool _mytoml_is_inline_table_end(char c) { return (c == '}'); }
+
+  bool _mytoml_is_inline_table_seperator(char c) { return (c == ','); }
+
+  bool _mytoml_is_dot(char c) { return (c == '.'); }
+
+  bool _mytoml_is_digit(char c) { return (c >= '0' && c <= '9'); }
+
+  bool _mytoml_is_hex_digit(char c) { return _mytoml_char_has(c, CF_HEX); }
+
+  bool _mytoml_is_number_start(char c)
+  {
+    return ((c == '+' || c == '-') || _mytoml_is_digit(c));
+  }
+
+  bool _mytoml_is_bare_ascii(char c) { return _mytoml_char_has(c, CF_BARE); }
+
+  bool _mytoml_is_control(char c) { return _mytoml_char_has(c, CF_CONTROL); }
+
+  bool _mytoml_is_control_multi(char c)
   {
-    TomlValue *v = (TomlValue *)calloc(1, sizeof(TomlValue));
-    v->type = TOML_INLINETABLE;
-    TomlKey *h = _mytoml_value_new_key(TOML_KEY);
-    for (khiter_t ki = kh_begin(k->subkeys); ki != kh_end(k->subkeys); ++ki)
-    {
-      if (kh_exist(k->subkeys, ki))
-      {
-        _mytoml_value_add_sub_key(h, kh_value(k->subkeys, ki));
-      }
-    }
-    v->data = h;
-    return v;
+    return _mytoml_char_has(c, CF_CONTROL_MULTI);
+  }
+
+  bool _mytoml_is_control_literal(char c)
+  {
+    return _mytoml_char_has(c, CF_CONTROL_LITERAL);
   }
 
-  void _mytoml_value_delete(TomlValue *v)
+  bool _mytoml_is_number_end(char c, const char *end)
   {
-    if (!v)
-      return;
-    if (v->arr)
+    for (size_t i = 0; i < strlen(end); i++)
     {
-      for (TomlValue **iter = v->arr; *iter != NULL; iter++)
-      {
-        _mytoml_value_delete(*iter);
-      }
-      free(v->arr);
+      if (c == end[i])
+        return true;
     }
-    if (v->data)
+    return false;
+  }
+
+  bool _mytoml_is_comment_char(char c) { return !_mytoml_is_control(c); }
+
+  bool _mytoml_is_number_char(char c) { return _mytoml_char_has(c, CF_NUMBER); }
+
+  bool _mytoml_is_basic_string_char(char c)
+  {
+    return !_mytoml_char_has(c, CF_BASIC_STOP);
+  }
+
+  bool _mytoml_is_literal_string_char(char c)
+  {
+    return !_mytoml_char_has(c, CF_LITERAL_STOP);
+  }
+
+  bool _mytoml_is_decimal_point(char c) { return (c == '.'); }
+
+  bool _mytoml_is_underscore(char c) { return (c == '_'); }
+
+  bool _mytoml_is_array_start(char c) { return (c == '['); }
+
+  bool _mytoml_is_array_end(char c) { return (c == ']'); }
+
+  bool _mytoml_is_array_seperator(char c) { return (c == ','); }
+
+  bool _mytoml_is_date(int year, int month, int day)
+  {
+    switch (month)
     {
-      free(v->data);
+    case 0: // January
+      return (day >= 1 && day <= 31);
+    case 1: // February
+      return (
+          (day >= 1 && day <= 28) ||
+          (day == 29 && year % 4 == 0 && year % 100 != 0) ||
+          (day == 29 && year % 4 == 0 && year % 100 == 0 && year % 400 == 0));
+    case 2: // March
+      return (day >= 1 && day <= 31);
+    case 3: // April
+      return (day >= 1 && day <= 30);
+    case 4: // May
+      return (day >= 1 && day <= 31);
+    case 5: // June
+      return (day >= 1 && day <= 30);
+    case 6: // July
+      return (day >= 1 && day <= 31);
+    case 7: // August
+      return (day >= 1 && day <= 31);
+    case 8: // September
+      return (day >= 1 && day <= 30);
+    case 9: // October
+      return (day >= 1 && day <= 31);
+    case 10: // November
+      return (day >= 1 && day <= 30);
+    case 11: // December
+      return (day >= 1 && day <= 31);
+    default:
+      return false;
     }
-    free(v);
+    return false;
+  }
+
+  // days from civil and back count 400-year eras of 146097 days,
+  // starting each year on March 1st so the leap day comes last
+  int32_t _mytoml_datetime_days(int year, int month, int day)
+  {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yoe = year - era * 400;
+    int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+  }
+
+  void _mytoml_datetime_civil(int32_t days, int *year, int *month, int *day)
+  {
+    days += 719468;
+    int era = (days >= 0 ? days : days - 146096) / 146097;
+    int doe = days - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    *day = doy - (153 * mp + 2) / 5 + 1;
+    *month = mp < 10 ? mp + 3 : mp - 9;
+    *year = yoe + era * 400 + (*month <= 2);
   }
 
   //-----------------------------------------------------------------------------
-  // [SECTION] Myjson Key
+  // [SECTION] Myjson Float
   //-----------------------------------------------------------------------------
 
-  TomlKey *_mytoml_value_new_key(TomlKeyType type)
+  // powers of ten a double holds exactly
+  static const double _mytoml_float_exact_pow10[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+  // 5^q normalized to 128 bits, high word first, for q from
+  // MYTOML_FLOAT_MIN_POW10 to MYTOML_FLOAT_MAX_POW10; negative powers are
+  // rounded up, positive ones truncated
+  static const uint64_t _mytoml_float_pow5_table[][2] = {
+      {0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL},
+      {0x9558b4661b6565f8ULL, 0x4ac7ca59a424c507ULL},
+      {0xbaaee17fa23ebf76ULL, 0x5d79bcf00d2df649ULL},
+      {0xe95a99df8ace6f53ULL, 0xf4d82c2c107973dcULL},
+      {0x91d8a02bb6c10594ULL, 0x79071b9b8a4be869ULL},
+      {0xb64ec836a47146f9ULL, 0x9748e2826cdee284ULL},
+      {0xe3e27a444d8d98b7ULL, 0xfd1b1b2308169b25ULL},
+      {0x8e6d8c6ab0787f72ULL, 0xfe30f0f5e50e20f7ULL},
+      {0xb208ef855c969f4fULL, 0xbdbd2d335e51a935ULL},
+      {0xde8b2b66b3bc4723ULL, 0xad2c788035e61382ULL},
+      {0x8b16fb203055ac76ULL, 0x4c3bcb5021afcc31ULL},
+      {0xaddcb9e83c6b1793ULL, 0xdf4abe242a1bbf3dULL},
+      {0xd953e8624b85dd78ULL, 0xd71d6dad34a2af0dULL},
+      {0x87d4713d6f33aa6bULL, 0x8672648c40e5ad68ULL},
+      {0xa9c98d8ccb009506ULL, 0x680efdaf511f18c2ULL},
+      {0xd43bf0effdc0ba48ULL, 0x0212bd1b2566def2ULL},
+      {0x84a57695fe98746dULL, 0x014bb630f7604b57ULL},
+      {0xa5ced43b7e3e9188ULL, 0x419ea3bd35385e2dULL},
+      {0xcf42894a5dce35eaULL, 0x52064cac828675b9ULL},
+      {0x818995ce7aa0e1b2ULL, 0x7343efebd1940993ULL},
+      {0xa1ebfb4219491a1fULL, 0x1014ebe6c5f90bf8ULL},
+      {0xca66fa129f9b60a6ULL, 0xd41a26e077774ef6ULL},
+      {0xfd00b897478238d0ULL, 0x8920b098955522b4ULL},
+      {0x9e20735e8cb16382ULL, 0x55b46e5f5d5535b0ULL},
+      {0xc5a890362fddbc62ULL, 0xeb2189f734aa831dULL},
+      {0xf712b443bbd52b7bULL, 0xa5e9ec7501d523e4ULL},
+      {0x9a6bb0aa55653b2dULL, 0x47b233c92125366eULL},
+      {0xc1069cd4eabe89f8ULL, 0x999ec0bb696e840aULL},
+      {0xf148440a256e2c76ULL, 0xc00670ea43ca250dULL},
+      {0x96cd2a865764dbcaULL, 0x380406926a5e5728ULL},
+      {0xbc807527ed3e12bcULL, 0xc605083704f5ecf2ULL},
+      {0xeba09271e88d976bULL, 0xf7864a44c633682eULL},
+      {0x93445b8731587ea3ULL, 0x7ab3ee6afbe0211dULL},
+      {0xb8157268fdae9e4cULL, 0x5960ea05bad82964ULL},
+      {0xe61acf033d1a45dfULL, 0x6fb92487298e33bdULL},
+      {0x8fd0c16206306babULL, 0xa5d3b6d479f8e056ULL},
+      {0xb3c4f1ba87bc8696ULL, 0x8f48a4899877186cULL},
+      {0xe0b62e2929aba83cULL, 0x331acdabfe94de87ULL},
+      {0x8c71dcd9ba0b4925ULL, 0x9ff0c08b7f1d0b14ULL},
+      {0xaf8e5410288e1b6fULL, 0x07ecf0ae5ee44dd9ULL},
+      {0xdb71e91432b1a24aULL, 0xc9e82cd9f69d6150ULL},
+      {0x892731ac9faf056eULL, 0xbe311c083a225cd2ULL},
+      {0xab70fe17c79ac6caULL, 0x6dbd630a48aaf406ULL},
+      {0xd64d3d9db981787dULL, 0x092cbbccdad5b108ULL},
+      {0x85f0468293f0eb4eULL, 0x25bbf56008c58ea5ULL},
+      {0xa76c582338ed2621ULL, 0xaf2af2b80af6f24eULL},
+      {0xd1476e2c07286faaULL, 0x1af5af660db4aee1ULL},
+      {0x82cca4db847945caULL, 0x50d98d9fc890ed4dULL},
+      {0xa37fce126597973cULL, 0xe50ff107bab528a0ULL},
+      {0xcc5fc196fefd7d0cULL, 0x1e53ed49a96272c8ULL},
+      {0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7aULL},
+      {0x9faacf3df73609b1ULL, 0x77b191618c54e9acULL},
+      {0xc795830d75038c1dULL, 0xd59df5b9ef6a2417ULL},
+      {0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1dULL},
+      {0x9becce62836ac577ULL, 0x4ee367f9430aec32ULL},
+      {0xc2e801fb244576d5ULL, 0x229c41f793cda73fULL},
+      {0xf3a20279ed56d48aULL, 0x6b43527578c1110fULL},
+      {0x9845418c345644d6ULL, 0x830a13896b78aaa9ULL},
+      {0xbe5691ef416bd60cULL, 0x23cc986bc656d553ULL},
+      {0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa8ULL},
+      {0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6a9ULL},
+      {0xb9e08a83a5e34f07ULL, 0xdaf5ccd93fb0cc53ULL},
+      {0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff68ULL},
+      {0x91376c36d99995beULL, 0x23100809b9c21fa1ULL},
+      {0xb58547448ffffb2dULL, 0xabd40a0c2832a78aULL},
+      {0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516cULL},
+      {0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e3ULL},
+      {0xb1442798f49ffb4aULL, 0x99cd11cfdf41779cULL},
+      {0xdd95317f31c7fa1dULL, 0x40405643d711d583ULL},
+      {0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2572ULL},
+      {0xad1c8eab5ee43b66ULL, 0xda3243650005eecfULL},
+      {0xd863b256369d4a40ULL, 0x90bed43e40076a82ULL},
+      {0x873e4f75e2224e68ULL, 0x5a7744a6e804a291ULL},
+      {0xa90de3535aaae202ULL, 0x711515d0a205cb36ULL},
+      {0xd3515c2831559a83ULL, 0x0d5a5b44ca873e03ULL},
+      {0x8412d9991ed58091ULL, 0xe858790afe9486c2ULL},
+      {0xa5178fff668ae0b6ULL, 0x626e974dbe39a872ULL},
+      {0xce5d73ff402d98e3ULL, 0xfb0a3d212dc8128fULL},
+      {0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b99ULL},
+      {0xa139029f6a239f72ULL, 0x1c1fffc1ebc44e80ULL},
+      {0xc987434744ac874eULL, 0xa327ffb266b56220ULL},
+      {0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa8ULL},
+      {0x9d71ac8fada6c9b5ULL, 0x6f773fc3603db4a9ULL},
+      {0xc4ce17b399107c22ULL, 0xcb550fb4384d21d3ULL},
+      {0xf6019da07f549b2bULL, 0x7e2a53a146606a48ULL},
+      {0x99c102844f94e0fbULL, 0x2eda7444cbfc426dULL},
+      {0xc0314325637a1939ULL, 0xfa911155fefb5308ULL},
+      {0xf03d93eebc589f88ULL, 0x793555ab7eba27caULL},
+      {0x96267c7535b763b5ULL, 0x4bc1558b2f3458deULL},
+      {0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f16ULL},
+      {0xea9c227723ee8bcbULL, 0x465e15a979c1cadcULL},
+      {0x92a1958a7675175fULL, 0x0bfacd89ec191ec9ULL},
+      {0xb749faed14125d36ULL, 0xcef980ec671f667bULL},
+      {0xe51c79a85916f484ULL, 0x82b7e12780e7401aULL},
+      {0x8f31cc0937ae58d2ULL, 0xd1b2ecb8b0908810ULL},
+      {0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa15ULL},
+      {0xdfbdcece67006ac9ULL, 0x67a791e093e1d49aULL},
+      {0x8bd6a141006042bdULL, 0xe0c8bb2c5c6d24e0ULL},
+      {0xaecc49914078536dULL, 0x58fae9f773886e18ULL},
+      {0xda7f5bf590966848ULL, 0xaf39a475506a899eULL},
+      {0x888f99797a5e012dULL, 0x6d8406c952429603ULL},
+      {0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b83ULL},
+      {0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a64ULL},
+      {0x855c3be0a17fcd26ULL, 0x5cf2eea09a55067fULL},
+      {0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481eULL},
+      {0xd0601d8efc57b08bULL, 0xf13b94daf124da26ULL},
+      {0x823c12795db6ce57ULL, 0x76c53d08d6b70858ULL},
+      {0xa2cb1717b52481edULL, 0x54768c4b0c64ca6eULL},
+      {0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd09ULL},
+      {0xfe5d54150b090b02ULL, 0xd3f93b35435d7c4cULL},
+      {0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6dafULL},
+      {0xc6b8e9b0709f109aULL, 0x359ab6419ca1091bULL},
+      {0xf867241c8cc6d4c0ULL, 0xc30163d203c94b62ULL},
+      {0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1dULL},
+      {0xc21094364dfb5636ULL, 0x985915fc12f542e4ULL},
+      {0xf294b943e17a2bc4ULL, 0x3e6f5b7b17b2939dULL},
+      {0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c42ULL},
+      {0xbd8430bd08277231ULL, 0x50c6ff782a838353ULL},
+      {0xece53cec4a314ebdULL, 0xa4f8bf5635246428ULL},
+      {0x940f4613ae5ed136ULL, 0x871b7795e136be99ULL},
+      {0xb913179899f68584ULL, 0x28e2557b59846e3fULL},
+      {0xe757dd7ec07426e5ULL, 0x331aeada2fe589cfULL},
+      {0x9096ea6f3848984fULL, 0x3ff0d2c85def7621ULL},
+      {0xb4bca50b065abe63ULL, 0x0fed077a756b53a9ULL},
+      {0xe1ebce4dc7f16dfbULL, 0xd3e8495912c62894ULL},
+      {0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95cULL},
+      {0xb080392cc4349decULL, 0xbd8d794d96aacfb3ULL},
+      {0xdca04777f541c567ULL, 0xecf0d7a0fc5583a0ULL},
+      {0x89e42caaf9491b60ULL, 0xf41686c49db57244ULL},
+      {0xac5d37d5b79b6239ULL, 0x311c2875c522ced5ULL},
+      {0xd77485cb25823ac7ULL, 0x7d633293366b828bULL},
+      {0x86a8d39ef77164bcULL, 0xae5dff9c02033197ULL},
+      {0xa8530886b54dbdebULL, 0xd9f57f830283fdfcULL},
+      {0xd267caa862a12d66ULL, 0xd072df63c324fd7bULL},
+      {0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6dULL},
+      {0xa46116538d0deb78ULL, 0x52d9be85f074e608ULL},
+      {0xcd795be870516656ULL, 0x67902e276c921f8bULL},
+      {0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b6ULL},
+      {0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a4ULL},
+      {0xc8a883c0fdaf7df0ULL, 0x6122cd128006b2cdULL},
+      {0xfad2a4b13d1b5d6cULL, 0x796b805720085f81ULL},
+      {0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb0ULL},
+      {0xc3f490aa77bd60fcULL, 0xbedbfc4411068a9cULL},
+      {0xf4f1b4d515acb93bULL, 0xee92fb5515482d44ULL},
+      {0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4aULL},
+      {0xbf5cd54678eef0b6ULL, 0xd262d45a78a0635dULL},
+      {0xef340a98172aace4ULL, 0x86fb897116c87c34ULL},
+      {0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da0ULL},
+      {0xbae0a846d2195712ULL, 0x8974836059cca109ULL},
+      {0xe998d258869facd7ULL, 0x2bd1a438703fc94bULL},
+      {0x91ff83775423cc06ULL, 0x7b6306a34627ddcfULL},
+      {0xb67f6455292cbf08ULL, 0x1a3bc84c17b1d542ULL},
+      {0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a93ULL},
+      {0x8e938662882af53eULL, 0x547eb47b7282ee9cULL},
+      {0xb23867fb2a35b28dULL, 0xe99e619a4f23aa43ULL},
+      {0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d4ULL},
+      {0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd04ULL},
+      {0xae0b158b4738705eULL, 0x9624ab50b148d445ULL},
+      {0xd98ddaee19068c76ULL, 0x3badd624dd9b0957ULL},
+      {0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d6ULL},
+      {0xa9f6d30a038d1dbcULL, 0x5e9fcf4ccd211f4cULL},
+      {0xd47487cc8470652bULL, 0x7647c3200069671fULL},
+      {0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e073ULL},
+      {0xa5fb0a17c777cf09ULL, 0xf468107100525890ULL},
+      {0xcf79cc9db955c2ccULL, 0x7182148d4066eeb4ULL},
+      {0x81ac1fe293d599bfULL, 0xc6f14cd848405530ULL},
+      {0xa21727db38cb002fULL, 0xb8ada00e5a506a7cULL},
+      {0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851cULL},
+      {0xfd442e4688bd304aULL, 0x908f4a166d1da663ULL},
+      {0x9e4a9cec15763e2eULL, 0x9a598e4e043287feULL},
+      {0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29fdULL},
+      {0xf7549530e188c128ULL, 0xd12bee59e68ef47cULL},
+      {0x9a94dd3e8cf578b9ULL, 0x82bb74f8301958ceULL},
+      {0xc13a148e3032d6e7ULL, 0xe36a52363c1faf01ULL},
+      {0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac1ULL},
+      {0x96f5600f15a7b7e5ULL, 0x29ab103a5ef8c0b9ULL},
+      {0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e7ULL},
+      {0xebdf661791d60f56ULL, 0x111b495b3464ad21ULL},
+      {0x936b9fcebb25c995ULL, 0xcab10dd900beec34ULL},
+      {0xb84687c269ef3bfbULL, 0x3d5d514f40eea742ULL},
+      {0xe65829b3046b0afaULL, 0x0cb4a5a3112a5112ULL},
+      {0x8ff71a0fe2c2e6dcULL, 0x47f0e785eaba72abULL},
+      {0xb3f4e093db73a093ULL, 0x59ed216765690f56ULL},
+      {0xe0f218b8d25088b8ULL, 0x306869c13ec3532cULL},
+      {0x8c974f7383725573ULL, 0x1e414218c73a13fbULL},
+      {0xafbd2350644eeacfULL, 0xe5d1929ef90898faULL},
+      {0xdbac6c247d62a583ULL, 0xdf45f746b74abf39ULL},
+      {0x894bc396ce5da772ULL, 0x6b8bba8c328eb783ULL},
+      {0xab9eb47c81f5114fULL, 0x066ea92f3f326564ULL},
+      {0xd686619ba27255a2ULL, 0xc80a537b0efefebdULL},
+      {0x8613fd0145877585ULL, 0xbd06742ce95f5f36ULL},
+      {0xa798fc4196e952e7ULL, 0x2c48113823b73704ULL},
+      {0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c5ULL},
+      {0x82ef85133de648c4ULL, 0x9a984d73dbe722fbULL},
+      {0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbaULL},
+      {0xcc963fee10b7d1b3ULL, 0x318df905079926a8ULL},
+      {0xffbbcfe994e5c61fULL, 0xfdf17746497f7052ULL},
+      {0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa633ULL},
+      {0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc0ULL},
+      {0xf9bd690a1b68637bULL, 0x3dfdce7aa3c673b0ULL},
+      {0x9c1661a651213e2dULL, 0x06bea10ca65c084eULL},
+      {0xc31bfa0fe5698db8ULL, 0x486e494fcff30a62ULL},
+      {0xf3e2f893dec3f126ULL, 0x5a89dba3c3efccfaULL},
+      {0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01cULL},
+      {0xbe89523386091465ULL, 0xf6bbb397f1135823ULL},
+      {0xee2ba6c0678b597fULL, 0x746aa07ded582e2cULL},
+      {0x94db483840b717efULL, 0xa8c2a44eb4571cdcULL},
+      {0xba121a4650e4ddebULL, 0x92f34d62616ce413ULL},
+      {0xe896a0d7e51e1566ULL, 0x77b020baf9c81d17ULL},
+      {0x915e2486ef32cd60ULL, 0x0ace1474dc1d122eULL},
+      {0xb5b5ada8aaff80b8ULL, 0x0d819992132456baULL},
+      {0xe3231912d5bf60e6ULL, 0x10e1fff697ed6c69ULL},
+      {0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c1ULL},
+      {0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb2ULL},
+      {0xddd0467c64bce4a0ULL, 0xac7cb3f6d05ddbdeULL},
+      {0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96bULL},
+      {0xad4ab7112eb3929dULL, 0x86c16c98d2c953c6ULL},
+      {0xd89d64d57a607744ULL, 0xe871c7bf077ba8b7ULL},
+      {0x87625f056c7c4a8bULL, 0x11471cd764ad4972ULL},
+      {0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bcfULL},
+      {0xd389b47879823479ULL, 0x4aff1d108d4ec2c3ULL},
+      {0x843610cb4bf160cbULL, 0xcedf722a585139baULL},
+      {0xa54394fe1eedb8feULL, 0xc2974eb4ee658828ULL},
+      {0xce947a3da6a9273eULL, 0x733d226229feea32ULL},
+      {0x811ccc668829b887ULL, 0x0806357d5a3f525fULL},
+      {0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f7ULL},
+      {0xc9bcff6034c13052ULL, 0xfc89b393dd02f0b5ULL},
+      {0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace2ULL},
+      {0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0dULL},
+      {0xc5029163f384a931ULL, 0x0a9e795e65d4df11ULL},
+      {0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d5ULL},
+      {0x99ea0196163fa42eULL, 0x504bced1bf8e4e45ULL},
+      {0xc06481fb9bcf8d39ULL, 0xe45ec2862f71e1d6ULL},
+      {0xf07da27a82c37088ULL, 0x5d767327bb4e5a4cULL},
+      {0x964e858c91ba2655ULL, 0x3a6a07f8d510f86fULL},
+      {0xbbe226efb628afeaULL, 0x890489f70a55368bULL},
+      {0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842eULL},
+      {0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929dULL},
+      {0xb77ada0617e3bbcbULL, 0x09ce6ebb40173744ULL},
+      {0xe55990879ddcaabdULL, 0xcc420a6a101d0515ULL},
+      {0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232dULL},
+      {0xb32df8e9f3546564ULL, 0x47939822dc96abf9ULL},
+      {0xdff9772470297ebdULL, 0x59787e2b93bc56f7ULL},
+      {0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65aULL},
+      {0xaefae51477a06b03ULL, 0xede622920b6b23f1ULL},
+      {0xdab99e59958885c4ULL, 0xe95fab368e45ecedULL},
+      {0x88b402f7fd75539bULL, 0x11dbcb0218ebb414ULL},
+      {0xaae103b5fcd2a881ULL, 0xd652bdc29f26a119ULL},
+      {0xd59944a37c0752a2ULL, 0x4be76d3346f0495fULL},
+      {0x857fcae62d8493a5ULL, 0x6f70a4400c562ddbULL},
+      {0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb952ULL},
+      {0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a7ULL},
+      {0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL},
+      {0xa2f67f2dfa90563bULL, 0x728900802f0f32faULL},
+      {0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffb9ULL},
+      {0xfea126b7d78186bcULL, 0xe2f610c84987bfa8ULL},
+      {0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7c9ULL},
+      {0xc6ede63fa05d3143ULL, 0x91503d1c79720dbbULL},
+      {0xf8a95fcf88747d94ULL, 0x75a44c6397ce912aULL},
+      {0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abaULL},
+      {0xc24452da229b021bULL, 0xfbe85badce996168ULL},
+      {0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c3ULL},
+      {0x97c560ba6b0919a5ULL, 0xdccd879fc967d41aULL},
+      {0xbdb6b8e905cb600fULL, 0x5400e987bbc1c920ULL},
+      {0xed246723473e3813ULL, 0x290123e9aab23b68ULL},
+      {0x9436c0760c86e30bULL, 0xf9a0b6720aaf6521ULL},
+      {0xb94470938fa89bceULL, 0xf808e40e8d5b3e69ULL},
+      {0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e04ULL},
+      {0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c2ULL},
+      {0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af3ULL},
+      {0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b0ULL},
+      {0x8d590723948a535fULL, 0x579c487e5a38ad0eULL},
+      {0xb0af48ec79ace837ULL, 0x2d835a9df0c6d851ULL},
+      {0xdcdb1b2798182244ULL, 0xf8e431456cf88e65ULL},
+      {0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b58ffULL},
+      {0xac8b2d36eed2dac5ULL, 0xe272467e3d222f3fULL},
+      {0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb0fULL},
+      {0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL},
+      {0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL},
+      {0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL},
+      {0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL},
+      {0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL},
+      {0xcdb02555653131b6ULL, 0x3792f412cb06794dULL},
+      {0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL},
+      {0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL},
+      {0xc8de047564d20a8bULL, 0xf245825a5a445275ULL},
+      {0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL},
+      {0x9ced737bb6c4183dULL, 0x55464dd69685606bULL},
+      {0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL},
+      {0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL},
+      {0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL},
+      {0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL},
+      {0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL},
+      {0x95a8637627989aadULL, 0xdde7001379a44aa8ULL},
+      {0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL},
+      {0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL},
+      {0x9226712162ab070dULL, 0xcab3961304ca70e8ULL},
+      {0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL},
+      {0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL},
+      {0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL},
+      {0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL},
+      {0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL},
+      {0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL},
+      {0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL},
+      {0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL},
+      {0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL},
+      {0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL},
+      {0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL},
+      {0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL},
+      {0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL},
+      {0xcfb11ead453994baULL, 0x67de18eda5814af2ULL},
+      {0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL},
+      {0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL},
+      {0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL},
+      {0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL},
+      {0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL},
+      {0xc612062576589ddaULL, 0x95364afe032a819eULL},
+      {0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL},
+      {0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL},
+      {0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL},
+      {0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL},
+      {0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL},
+      {0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL},
+      {0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL},
+      {0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL},
+      {0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL},
+      {0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL},
+      {0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL},
+      {0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL},
+      {0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL},
+      {0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL},
+      {0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL},
+      {0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL},
+      {0x89705f4136b4a597ULL, 0x31680a88f8953031ULL},
+      {0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL},
+      {0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL},
+      {0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL},
+      {0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL},
+      {0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL},
+      {0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL},
+      {0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL},
+      {0xccccccccccccccccULL, 0xcccccccccccccccdULL},
+      {0x8000000000000000ULL, 0x0000000000000000ULL},
+      {0xa000000000000000ULL, 0x0000000000000000ULL},
+      {0xc800000000000000ULL, 0x0000000000000000ULL},
+      {0xfa00000000000000ULL, 0x0000000000000000ULL},
+      {0x9c40000000000000ULL, 0x0000000000000000ULL},
+      {0xc350000000000000ULL, 0x0000000000000000ULL},
+      {0xf424000000000000ULL, 0x0000000000000000ULL},
+      {0x9896800000000000ULL, 0x0000000000000000ULL},
+      {0xbebc200000000000ULL, 0x0000000000000000ULL},
+      {0xee6b280000000000ULL, 0x0000000000000000ULL},
+      {0x9502f90000000000ULL, 0x0000000000000000ULL},
+      {0xba43b74000000000ULL, 0x0000000000000000ULL},
+      {0xe8d4a51000000000ULL, 0x0000000000000000ULL},
+      {0x9184e72a00000000ULL, 0x0000000000000000ULL},
+      {0xb5e620f480000000ULL, 0x0000000000000000ULL},
+      {0xe35fa931a0000000ULL, 0x0000000000000000ULL},
+      {0x8e1bc9bf04000000ULL, 0x0000000000000000ULL},
+      {0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL},
+      {0xde0b6b3a76400000ULL, 0x0000000000000000ULL},
+      {0x8ac7230489e80000ULL, 0x0000000000000000ULL},
+      {0xad78ebc5ac620000ULL, 0x0000000000000000ULL},
+      {0xd8d726b7177a8000ULL, 0x0000000000000000ULL},
+      {0x878678326eac9000ULL, 0x0000000000000000ULL},
+      {0xa968163f0a57b400ULL, 0x0000000000000000ULL},
+      {0xd3c21bcecceda100ULL, 0x0000000000000000ULL},
+      {0x84595161401484a0ULL, 0x0000000000000000ULL},
+      {0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL},
+      {0xcecb8f27f4200f3aULL, 0x0000000000000000ULL},
+      {0x813f3978f8940984ULL, 0x4000000000000000ULL},
+      {0xa18f07d736b90be5ULL, 0x5000000000000000ULL},
+      {0xc9f2c9cd04674edeULL, 0xa400000000000000ULL},
+      {0xfc6f7c4045812296ULL, 0x4d00000000000000ULL},
+      {0x9dc5ada82b70b59dULL, 0xf020000000000000ULL},
+      {0xc5371912364ce305ULL, 0x6c28000000000000ULL},
+      {0xf684df56c3e01bc6ULL, 0xc732000000000000ULL},
+      {0x9a130b963a6c115cULL, 0x3c7f400000000000ULL},
+      {0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL},
+      {0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL},
+      {0x96769950b50d88f4ULL, 0x1314448000000000ULL},
+      {0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL},
+      {0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL},
+      {0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL},
+      {0xb7abc627050305adULL, 0xf14a3d9e40000000ULL},
+      {0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL},
+      {0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL},
+      {0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL},
+      {0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL},
+      {0x8c213d9da502de45ULL, 0x4526f422cc340000ULL},
+      {0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL},
+      {0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL},
+      {0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL},
+      {0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL},
+      {0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL},
+      {0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL},
+      {0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL},
+      {0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL},
+      {0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL},
+      {0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL},
+      {0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764490ULL},
+      {0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL},
+      {0x9f4f2726179a2245ULL, 0x01d762422c946590ULL},
+      {0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef5ULL},
+      {0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL},
+      {0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL},
+      {0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fbULL},
+      {0xf316271c7fc3908aULL, 0x8bef464e3945ef7aULL},
+      {0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5acULL},
+      {0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea317ULL},
+      {0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bddULL},
+      {0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6aULL},
+      {0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b44ULL},
+      {0xe7d34c64a9c85d44ULL, 0x60dbbca87196b616ULL},
+      {0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31cdULL},
+      {0xb51d13aea4a488ddULL, 0x6babab6398bdbe41ULL},
+      {0xe264589a4dcdab14ULL, 0xc696963c7eed2dd1ULL},
+      {0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca2ULL},
+      {0xb0de65388cc8ada8ULL, 0x3b25a55f43294bcbULL},
+      {0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL},
+      {0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL},
+      {0xacb92ed9397bf996ULL, 0x49c2c37f07965404ULL},
+      {0xd7e77a8f87daf7fbULL, 0xdc33745ec97be906ULL},
+      {0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a3ULL},
+      {0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0cULL},
+      {0xd2d80db02aabd62bULL, 0xf50a3fa490c30190ULL},
+      {0x83c7088e1aab65dbULL, 0x792667c6da79e0faULL},
+      {0xa4b8cab1a1563f52ULL, 0x577001b891185938ULL},
+      {0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f86ULL},
+      {0x80b05e5ac60b6178ULL, 0x544f8158315b05b4ULL},
+      {0xa0dc75f1778e39d6ULL, 0x696361ae3db1c721ULL},
+      {0xc913936dd571c84cULL, 0x03bc3a19cd1e38e9ULL},
+      {0xfb5878494ace3a5fULL, 0x04ab48a04065c723ULL},
+      {0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c76ULL},
+      {0xc45d1df942711d9aULL, 0x3ba5d0bd324f8394ULL},
+      {0xf5746577930d6500ULL, 0xca8f44ec7ee36479ULL},
+      {0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1ecbULL},
+      {0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67eULL},
+      {0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101eULL},
+      {0x95d04aee3b80ece5ULL, 0xbba1f1d158724a12ULL},
+      {0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc97ULL},
+      {0xea1575143cf97226ULL, 0xf52d09d71a3293bdULL},
+      {0x924d692ca61be758ULL, 0x593c2626705f9c56ULL},
+      {0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836cULL},
+      {0xe498f455c38b997aULL, 0x0b6dfb9c0f956447ULL},
+      {0x8edf98b59a373fecULL, 0x4724bd4189bd5eacULL},
+      {0xb2977ee300c50fe7ULL, 0x58edec91ec2cb657ULL},
+      {0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3edULL},
+      {0x8b865b215899f46cULL, 0xbd79e0d20082ee74ULL},
+      {0xae67f1e9aec07187ULL, 0xecd8590680a3aa11ULL},
+      {0xda01ee641a708de9ULL, 0xe80e6f4820cc9495ULL},
+      {0x884134fe908658b2ULL, 0x3109058d147fdcddULL},
+      {0xaa51823e34a7eedeULL, 0xbd4b46f0599fd415ULL},
+      {0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91aULL},
+      {0x850fadc09923329eULL, 0x03e2cf6bc604ddb0ULL},
+      {0xa6539930bf6bff45ULL, 0x84db8346b786151cULL},
+      {0xcfe87f7cef46ff16ULL, 0xe612641865679a63ULL},
+      {0x81f14fae158c5f6eULL, 0x4fcb7e8f3f60c07eULL},
+      {0xa26da3999aef7749ULL, 0xe3be5e330f38f09dULL},
+      {0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc5ULL},
+      {0xfdcb4fa002162a63ULL, 0x73d9732fc7c8f7f6ULL},
+      {0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afaULL},
+      {0xc646d63501a1511dULL, 0xb281e1fd541501b8ULL},
+      {0xf7d88bc24209a565ULL, 0x1f225a7ca91a4226ULL},
+      {0x9ae757596946075fULL, 0x3375788de9b06958ULL},
+      {0xc1a12d2fc3978937ULL, 0x0052d6b1641c83aeULL},
+      {0xf209787bb47d6b84ULL, 0xc0678c5dbd23a49aULL},
+      {0x9745eb4d50ce6332ULL, 0xf840b7ba963646e0ULL},
+      {0xbd176620a501fbffULL, 0xb650e5a93bc3d898ULL},
+      {0xec5d3fa8ce427affULL, 0xa3e51f138ab4cebeULL},
+      {0x93ba47c980e98cdfULL, 0xc66f336c36b10137ULL},
+      {0xb8a8d9bbe123f017ULL, 0xb80b0047445d4184ULL},
+      {0xe6d3102ad96cec1dULL, 0xa60dc059157491e5ULL},
+      {0x9043ea1ac7e41392ULL, 0x87c89837ad68db2fULL},
+      {0xb454e4a179dd1877ULL, 0x29babe4598c311fbULL},
+      {0xe16a1dc9d8545e94ULL, 0xf4296dd6fef3d67aULL},
+      {0x8ce2529e2734bb1dULL, 0x1899e4a65f58660cULL},
+      {0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f8fULL},
+      {0xdc21a1171d42645dULL, 0x76707543f4fa1f73ULL},
+      {0x899504ae72497ebaULL, 0x6a06494a791c53a8ULL},
+      {0xabfa45da0edbde69ULL, 0x0487db9d17636892ULL},
+      {0xd6f8d7509292d603ULL, 0x45a9d2845d3c42b6ULL},
+      {0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b2ULL},
+      {0xa7f26836f282b732ULL, 0x8e6cac7768d7141eULL},
+      {0xd1ef0244af2364ffULL, 0x3207d795430cd926ULL},
+      {0x8335616aed761f1fULL, 0x7f44e6bd49e807b8ULL},
+      {0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a6ULL},
+      {0xcd036837130890a1ULL, 0x36dba887c37a8c0fULL},
+      {0x802221226be55a64ULL, 0xc2494954da2c9789ULL},
+      {0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6cULL},
+      {0xc83553c5c8965d3dULL, 0x6f92829494e5acc7ULL},
+      {0xfa42a8b73abbf48cULL, 0xcb772339ba1f17f9ULL},
+      {0x9c69a97284b578d7ULL, 0xff2a760414536efbULL},
+      {0xc38413cf25e2d70dULL, 0xfef5138519684abaULL},
+      {0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d69ULL},
+      {0x98bf2f79d5993802ULL, 0xef2f773ffbd97a61ULL},
+      {0xbeeefb584aff8603ULL, 0xaafb550ffacfd8faULL},
+      {0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf38ULL},
+      {0x952ab45cfa97a0b2ULL, 0xdd945a747bf26183ULL},
+      {0xba756174393d88dfULL, 0x94f971119aeef9e4ULL},
+      {0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85dULL},
+      {0x91abb422ccb812eeULL, 0xac62e055c10ab33aULL},
+      {0xb616a12b7fe617aaULL, 0x577b986b314d6009ULL},
+      {0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80bULL},
+      {0x8e41ade9fbebc27dULL, 0x14588f13be847307ULL},
+      {0xb1d219647ae6b31cULL, 0x596eb2d8ae258fc8ULL},
+      {0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bbULL},
+      {0x8aec23d680043beeULL, 0x25de7bb9480d5854ULL},
+      {0xada72ccc20054ae9ULL, 0xaf561aa79a10ae6aULL},
+      {0xd910f7ff28069da4ULL, 0x1b2ba1518094da04ULL},
+      {0x87aa9aff79042286ULL, 0x90fb44d2f05d0842ULL},
+      {0xa99541bf57452b28ULL, 0x353a1607ac744a53ULL},
+      {0xd3fa922f2d1675f2ULL, 0x42889b8997915ce8ULL},
+      {0x847c9b5d7c2e09b7ULL, 0x69956135febada11ULL},
+      {0xa59bc234db398c25ULL, 0x43fab9837e699095ULL},
+      {0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bbULL},
+      {0x8161afb94b44f57dULL, 0x1d1be0eebac278f5ULL},
+      {0xa1ba1ba79e1632dcULL, 0x6462d92a69731732ULL},
+      {0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcfeULL},
+      {0xfcb2cb35e702af78ULL, 0x5cda735244c3d43eULL},
+      {0x9defbf01b061adabULL, 0x3a0888136afa64a7ULL},
+      {0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd0ULL},
+      {0xf6c69a72a3989f5bULL, 0x8aad549e57273d45ULL},
+      {0x9a3c2087a63f6399ULL, 0x36ac54e2f678864bULL},
+      {0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7ddULL},
+      {0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d5ULL},
+      {0x969eb7c47859e743ULL, 0x9f644ae5a4b1b325ULL},
+      {0xbc4665b596706114ULL, 0x873d5d9f0dde1feeULL},
+      {0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7eaULL},
+      {0x9316ff75dd87cbd8ULL, 0x09a7f12442d588f2ULL},
+      {0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb2fULL},
+      {0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5faULL},
+      {0x8fa475791a569d10ULL, 0xf96e017d694487bcULL},
+      {0xb38d92d760ec4455ULL, 0x37c981dcc395a9acULL},
+      {0xe070f78d3927556aULL, 0x85bbe253f47b1417ULL},
+      {0x8c469ab843b89562ULL, 0x93956d7478ccec8eULL},
+      {0xaf58416654a6babbULL, 0x387ac8d1970027b2ULL},
+      {0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319eULL},
+      {0x88fcf317f22241e2ULL, 0x441fece3bdf81f03ULL},
+      {0xab3c2fddeeaad25aULL, 0xd527e81cad7626c3ULL},
+      {0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b074ULL},
+      {0x85c7056562757456ULL, 0xf6872d5667844e49ULL},
+      {0xa738c6bebb12d16cULL, 0xb428f8ac016561dbULL},
+      {0xd106f86e69d785c7ULL, 0xe13336d701beba52ULL},
+      {0x82a45b450226b39cULL, 0xecc0024661173473ULL},
+      {0xa34d721642b06084ULL, 0x27f002d7f95d0190ULL},
+      {0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f4ULL},
+      {0xff290242c83396ceULL, 0x7e67047175a15271ULL},
+      {0x9f79a169bd203e41ULL, 0x0f0062c6e984d386ULL},
+      {0xc75809c42c684dd1ULL, 0x52c07b78a3e60868ULL},
+      {0xf92e0c3537826145ULL, 0xa7709a56ccdf8a82ULL},
+      {0x9bbcc7a142b17ccbULL, 0x88a66076400bb691ULL},
+      {0xc2abf989935ddbfeULL, 0x6acff893d00ea435ULL},
+      {0xf356f7ebf83552feULL, 0x0583f6b8c4124d43ULL},
+      {0x98165af37b2153deULL, 0xc3727a337a8b704aULL},
+      {0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5cULL},
+      {0xeda2ee1c7064130cULL, 0x1162def06f79df73ULL},
+      {0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba8ULL},
+      {0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173692ULL},
+      {0xe8111c87c5c1ba99ULL, 0xc8fa8db6ccdd0437ULL},
+      {0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a2ULL},
+      {0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4bULL},
+      {0xe2a0b5dc971f303aULL, 0x2e44ae64840fd61dULL},
+      {0x8da471a9de737e24ULL, 0x5ceaecfed289e5d2ULL},
+      {0xb10d8e1456105dadULL, 0x7425a83e872c5f47ULL},
+      {0xdd50f1996b947518ULL, 0xd12f124e28f77719ULL},
+      {0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa6fULL},
+      {0xace73cbfdc0bfb7bULL, 0x636cc64d1001550bULL},
+      {0xd8210befd30efa5aULL, 0x3c47f7e05401aa4eULL},
+      {0x8714a775e3e95c78ULL, 0x65acfaec34810a71ULL},
+      {0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0dULL},
+      {0xd31045a8341ca07cULL, 0x1ede48111209a050ULL},
+      {0x83ea2b892091e44dULL, 0x934aed0aab460432ULL},
+      {0xa4e4b66b68b65d60ULL, 0xf81da84d5617853fULL},
+      {0xce1de40642e3f4b9ULL, 0x36251260ab9d668eULL},
+      {0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b426019ULL},
+      {0xa1075a24e4421730ULL, 0xb24cf65b8612f81fULL},
+      {0xc94930ae1d529cfcULL, 0xdee033f26797b627ULL},
+      {0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b1ULL},
+      {0x9d412e0806e88aa5ULL, 0x8e1f289560ee864eULL},
+      {0xc491798a08a2ad4eULL, 0xf1a6f2bab92a27e2ULL},
+      {0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dbULL},
+      {0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef29ULL},
+      {0xbff610b0cc6edd3fULL, 0x17fd090a58d32af3ULL},
+      {0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b0ULL},
+      {0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98eULL},
+      {0xbb764c4ca7a4440fULL, 0x9d6d1ad41abe37f1ULL},
+      {0xea53df5fd18d5513ULL, 0x84c86189216dc5edULL},
+      {0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb4ULL},
+      {0xb7118682dbb66a77ULL, 0x3fbc8c33221dc2a1ULL},
+      {0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334aULL},
+      {0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400eULL},
+      {0xb2c71d5bca9023f8ULL, 0x743e20e9ef511012ULL},
+      {0xdf78e4b2bd342cf6ULL, 0x914da9246b255416ULL},
+      {0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548eULL},
+      {0xae9672aba3d0c320ULL, 0xa184ac2473b529b1ULL},
+      {0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741eULL},
+      {0x8865899617fb1871ULL, 0x7e2fa67c7a658892ULL},
+      {0xaa7eebfb9df9de8dULL, 0xddbb901b98feeab7ULL},
+      {0xd51ea6fa85785631ULL, 0x552a74227f3ea565ULL},
+      {0x8533285c936b35deULL, 0xd53a88958f87275fULL},
+      {0xa67ff273b8460356ULL, 0x8a892abaf368f137ULL},
+      {0xd01fef10a657842cULL, 0x2d2b7569b0432d85ULL},
+      {0x8213f56a67f6b29bULL, 0x9c3b29620e29fc73ULL},
+      {0xa298f2c501f45f42ULL, 0x8349f3ba91b47b8fULL},
+      {0xcb3f2f7642717713ULL, 0x241c70a936219a73ULL},
+      {0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0110ULL},
+      {0x9ec95d1463e8a506ULL, 0xf4363804324a40aaULL},
+      {0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d5ULL},
+      {0xf81aa16fdc1b81daULL, 0xdd94b7868e94050aULL},
+      {0x9b10a4e5e9913128ULL, 0xca7cf2b4191c8326ULL},
+      {0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f0ULL},
+      {0xf24a01a73cf2dccfULL, 0xbc633b39673c8cecULL},
+      {0x976e41088617ca01ULL, 0xd5be0503e085d813ULL},
+      {0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e18ULL},
+      {0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219eULL},
+      {0x93e1ab8252f33b45ULL, 0xcabb90e5c942b503ULL},
+      {0xb8da1662e7b00a17ULL, 0x3d6a751f3b936243ULL},
+      {0xe7109bfba19c0c9dULL, 0x0cc512670a783ad4ULL},
+      {0x906a617d450187e2ULL, 0x27fb2b80668b24c5ULL},
+      {0xb484f9dc9641e9daULL, 0xb1f9f660802dedf6ULL},
+      {0xe1a63853bbd26451ULL, 0x5e7873f8a0396973ULL},
+      {0x8d07e33455637eb2ULL, 0xdb0b487b6423e1e8ULL},
+      {0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda62ULL},
+      {0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fbULL},
+      {0x89b9b3e11b6329baULL, 0xa9e904c87fcb0a9dULL},
+      {0xac2820d9623bf429ULL, 0x546345fa9fbdcd44ULL},
+      {0xd732290fbacaf133ULL, 0xa97c177947ad4095ULL},
+      {0x867f59a9d4bed6c0ULL, 0x49ed8eabcccc485dULL},
+      {0xa81f301449ee8c70ULL, 0x5c68f256bfff5a74ULL},
+      {0xd226fc195c6a2f8cULL, 0x73832eec6fff3111ULL},
+      {0x83585d8fd9c25db7ULL, 0xc831fd53c5ff7eabULL},
+      {0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e55ULL},
+      {0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ebULL},
+      {0x80444b5e7aa7cf85ULL, 0x7980d163cf5b81b3ULL},
+      {0xa0555e361951c366ULL, 0xd7e105bcc332621fULL},
+      {0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa7ULL},
+      {0xfa856334878fc150ULL, 0xb14f98f6f0feb951ULL},
+      {0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d3ULL},
+      {0xc3b8358109e84f07ULL, 0x0a862f80ec4700c8ULL},
+      {0xf4a642e14c6262c8ULL, 0xcd27bb612758c0faULL},
+      {0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789cULL},
+      {0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c3ULL},
+      {0xeeea5d5004981478ULL, 0x1858ccfce06cac74ULL},
+      {0x95527a5202df0ccbULL, 0x0f37801e0c43ebc8ULL},
+      {0xbaa718e68396cffdULL, 0xd30560258f54e6baULL},
+      {0xe950df20247c83fdULL, 0x47c6b82ef32a2069ULL},
+      {0x91d28b7416cdd27eULL, 0x4cdc331d57fa5441ULL},
+      {0xb6472e511c81471dULL, 0xe0133fe4adf8e952ULL},
+      {0xe3d8f9e563a198e5ULL, 0x58180fddd97723a6ULL},
+      {0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7648ULL},
+  };
+
+  static void _mytoml_float_mul128(uint64_t a, uint64_t b, uint64_t *hi,
+                                   uint64_t *lo)
   {
-    TomlKey *k = (TomlKey *)calloc(1, sizeof(TomlKey));
-    k->type = type;
-    k->value = NULL;
-    k->idx = -1;
-    k->subkeys = kh_init(str);
-    memset(k->id, 0, MYTOML_MAX_ID_LENGTH);
-    return k;
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 r = (unsigned __int128)a * b;
+    *hi = (uint64_t)(r >> 64);
+    *lo = (uint64_t)r;
+#else
+    uint64_t a0 = (uint32_t)a, a1 = a >> 32;
+    uint64_t b0 = (uint32_t)b, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+    *lo = (mid << 32) | (uint32_t)p00;
+    *hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+#endif
   }
 
-  TomlKey *_mytoml_value_has_sub_key(TomlKey *key, TomlKey *subkey)
+  static int _mytoml_float_clz64(uint64_t x)
   {
-    khiter_t k = kh_get(str, key->subkeys, subkey->id);
-    if (k == kh_end(key->subkeys))
-      return NULL;
-    return kh_value(key->subkeys, k);
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#else
+    int n = 0;
+    for (; !(x >> 63); x <<= 1)
+      n++;
+    return n;
+#endif
   }
 
-  TomlKey *_mytoml_value_add_sub_key(TomlKey *key, TomlKey *subkey)
+  bool _mytoml_float_from_decimal(uint64_t w, int q, bool negative, double *d)
   {
-    TomlKey *s = _mytoml_value_has_sub_key(key, subkey);
-    if (s)
+    uint64_t bits;
+    if (w == 0 || q < MYTOML_FLOAT_MIN_POW10)
     {
-      if (_mytoml_value_keys_compatible(s->type, subkey->type))
+      bits = 0;
+    }
+    else if (q > MYTOML_FLOAT_MAX_POW10)
+    {
+      bits = (uint64_t)0x7FF << 52;
+    }
+    else
+    {
+      int lz = _mytoml_float_clz64(w);
+      w <<= lz;
+      const uint64_t *pow5 = _mytoml_float_pow5_table[q - MYTOML_FLOAT_MIN_POW10];
+      uint64_t hi, lo;
+      _mytoml_float_mul128(w, pow5[0], &hi, &lo);
+      // the low bits below the 55 kept may carry into them, bring in the
+      // next 64 bits of the power
+      if ((hi & 0x1FF) == 0x1FF)
       {
-        // re-defining a TABLE as a TABLELEAF
-        // is allowed only once
-        if (subkey->type == TOML_TABLELEAF)
+        uint64_t hi2, lo2;
+        _mytoml_float_mul128(w, pow5[1], &hi2, &lo2);
+        lo += hi2;
+        hi += hi2 > lo;
+      }
+      // still undecided, only possible outside the range where the
+      // truncated power is exact
+      if (lo == UINT64_MAX && (q < -27 || q > 55))
+        return false;
+      int upper = (int)(hi >> 63);
+      int shift = upper + 64 - 52 - 3;
+      uint64_t mantissa = hi >> shift;
+      // floor(log2(10^q)) + 63, plus the exponent bias
+      int power2 = (((152170 + 65536) * q) >> 16) + 63 + upper - lz + 1023;
+      if (power2 <= 0)
+      {
+        // subnormal
+        if (-power2 + 1 >= 64)
         {
-          s->type = TOML_TABLELEAF;
+          bits = 0;
+        }
+        else
+        {
+          mantissa >>= -power2 + 1;
+          mantissa += mantissa & 1;
+          mantissa >>= 1;
+          bits = mantissa;
         }
-        return s;
       }
       else
       {
-        RETURN_IF_FAILED(0,
-                         "failed to add subkey\n"
-                         "existing subkey - key: %s type: %d\n"
-                         "new subkey: key: %s type: %d\n",
-                         s->id, (int)(s->type), subkey->id, (int)(subkey->type));
+        // exactly halfway between two doubles, round to even
+        if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 &&
+            (mantissa << shift) == hi)
+          mantissa &= ~(uint64_t)1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        if (mantissa >= (uint64_t)2 << 52)
+        {
+          mantissa = (uint64_t)1 << 52;
+          power2++;
+        }
+        mantissa &= ~((uint64_t)1 << 52);
+        if (power2 >= 0x7FF)
+          bits = (uint64_t)0x7FF << 52;
+        else
+          bits = mantissa | (uint64_t)power2 << 52;
+      }
+    }
+    bits |= (uint64_t)negative << 63;
+    memcpy(d, &bits, sizeof(bits));
+    return true;
+  }
+
+  // reads digits joined by single underscores into `w`, counting the
+  // significant ones in `nd`, returns the number of digits read. Only
+  // the first 19 fit `w`, `truncated` tells whether any dropped one was
+  // not zero
+  static size_t _mytoml_float_digits(const char **p, const char *e,
+                                     uint64_t *w, int *nd, bool *truncated)
+  {
+    const char *s = *p;
+    size_t count = 0;
+    while (s < e)
+    {
+      if (*s == '_' && count && s + 1 < e && _mytoml_is_digit(s[1]))
+        s++;
+      else if (!_mytoml_is_digit(*s))
+        break;
+      if (*w || *s != '0')
+      {
+        if (*nd < 19)
+          *w = *w * 10 + (uint64_t)(*s - '0');
+        else if (*s != '0')
+          *truncated = true;
+        (*nd)++;
       }
+      count++;
+      s++;
+    }
+    *p = s;
+    return count;
+  }
+
+  bool _mytoml_float_parse_span(const char *s, size_t len, double *d, Number *n)
+  {
+    const char *p = s;
+    const char *e = s + len;
+    bool negative = false;
+    if (p < e && (*p == '+' || *p == '-'))
+    {
+      negative = *p == '-';
+      p++;
+    }
+    // leading zeros are left to the validating parser
+    if (p + 1 < e && p[0] == '0' && (_mytoml_is_digit(p[1]) || p[1] == '_'))
+      return false;
+    uint64_t w = 0;
+    int nd = 0;
+    bool truncated = false;
+    if (!_mytoml_float_digits(&p, e, &w, &nd, &truncated))
+      return false;
+    int q = 0;
+    const char *point = p;
+    bool fraction = p < e && *p == '.';
+    if (fraction)
+    {
+      p++;
+      size_t count = _mytoml_float_digits(&p, e, &w, &nd, &truncated);
+      if (!count)
+        return false;
+      q -= (int)count;
     }
-    if (kh_size(key->subkeys) < MYTOML_MAX_SUBKEYS)
+    bool scientific = p < e && (*p == 'e' || *p == 'E');
+    if (scientific)
     {
-      if (key->type == TOML_ARRAYTABLE)
+      p++;
+      bool exp_negative = false;
+      if (p < e && (*p == '+' || *p == '-'))
       {
-        // since an ARRAYTABLE is a list of a map of key-value,
-        // and re-defining an ARRAYTABLE means adding another map
-        // of key-value to the list, we use the `value->arr`
-        // attribute of the key to store each map of key-values
-        TomlKey *a = _mytoml_value_add_sub_key(
-            (TomlKey *)key->value->arr[key->idx]->data, subkey);
-        return a;
+        exp_negative = *p == '-';
+        p++;
       }
-      else
+      int exp = 0;
+      size_t count = 0;
+      for (; p < e; p++)
+      {
+        if (*p == '_' && count && p + 1 < e && _mytoml_is_digit(p[1]))
+          continue;
+        if (!_mytoml_is_digit(*p))
+          break;
+        // far past any double, saturate
+        if (exp < 100000)
+          exp = exp * 10 + (*p - '0');
+        count++;
+      }
+      if (!count)
+        return false;
+      q += exp_negative ? -exp : exp;
+    }
+    if (p != e || !(fraction || scientific))
+      return false;
+    // `w` holds the first 19 significant digits, the others only scale it
+    if (nd > 19)
+      q += nd - 19;
+    bool exact = false;
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    exact = !truncated && w <= (uint64_t)1 << 53 && q >= -22 && q <= 22;
+#endif
+    if (truncated)
+    {
+      // the value lies between `w` and `w + 1` units of the last digit
+      // kept, when both round to the same double so does the value
+      double lo, hi;
+      if (!_mytoml_float_from_decimal(w, q, negative, &lo) ||
+          !_mytoml_float_from_decimal(w + 1, q, negative, &hi) || lo != hi)
       {
-        int ret;
-        khiter_t k = kh_put(str, key->subkeys, subkey->id, &ret);
-        kh_value(key->subkeys, k) = subkey;
-        return subkey;
+        if (!_mytoml_float_parse_decimal(s, len, &lo))
+          return false;
       }
+      *d = lo;
     }
-    else
+    else if (exact)
     {
-      LOG_ERR("buffer overflow\n");
+      // both operands are exact, so one rounding gives the nearest double
+      *d = q < 0 ? (double)w / _mytoml_float_exact_pow10[-q]
+                 : (double)w * _mytoml_float_exact_pow10[q];
+      if (negative)
+        *d = -*d;
     }
-    return NULL;
+    else if (!_mytoml_float_from_decimal(w, q, negative, d) &&
+             !_mytoml_float_parse_decimal(s, len, d))
+    {
+      return false;
+    }
+    // like the validating parser, count every character past the point
+    int precision = 0;
+    if (fraction)
+    {
+      for (const char *c = point + 1; c < e; c++)
+        precision += *c != '_';
+    }
+    n->type = TOML_FLOAT;
+    n->precision = precision;
+    n->scientific = scientific;
+    return true;
   }
 
-  bool _mytoml_value_keys_compatible(TomlKeyType existing, TomlKeyType current)
+  // drops the trailing zeros of `a`
+  static void _mytoml_decimal_trim(FloatDecimal *a)
   {
-    // re-definition rules
-    // [existing]
-    // [current]
+    while (a->nd > 0 && a->d[a->nd - 1] == 0)
+      a->nd--;
+    if (a->nd == 0)
+      a->dp = 0;
+  }
 
-    // `a = b`
-    // `a = c`
-    if (existing == TOML_KEYLEAF)
+  // divides `a` by 2^k, for k up to 60 so `n` cannot overflow
+  static void _mytoml_decimal_right_shift(FloatDecimal *a, int k)
+  {
+    int r = 0, w = 0;
+    uint64_t n = 0;
+    // read enough leading digits for the first digit of the quotient
+    for (; n >> k == 0; r++)
     {
-      return false;
+      if (r >= a->nd)
+      {
+        if (n == 0)
+        {
+          a->nd = 0;
+          return;
+        }
+        while (n >> k == 0)
+        {
+          n *= 10;
+          r++;
+        }
+        break;
+      }
+      n = n * 10 + a->d[r];
     }
-    // `[a.b]`
-    // `[a.b]`
-    if (existing == TOML_TABLELEAF && current == TOML_TABLELEAF)
+    a->dp -= r - 1;
+    uint64_t mask = ((uint64_t)1 << k) - 1;
+    for (; r < a->nd; r++)
     {
-      return false;
+      a->d[w++] = (unsigned char)(n >> k);
+      n = (n & mask) * 10 + a->d[r];
     }
-    // `[a.b] or b.c = d`
-    // `[a.b.e] or [b.e]`
-    if ((existing == TOML_TABLELEAF || existing == TOML_KEY) &&
-        current == TOML_TABLE)
+    while (n > 0)
     {
-      return true;
+      unsigned char digit = (unsigned char)(n >> k);
+      n = (n & mask) * 10;
+      if (w < MYTOML_FLOAT_DECIMAL_DIGITS)
+        a->d[w++] = digit;
+      else if (digit > 0)
+        a->truncated = true;
     }
-    // `[a.b]`
-    // `[a]`
-    if (existing == TOML_TABLE && current == TOML_TABLELEAF)
+    a->nd = w;
+    _mytoml_decimal_trim(a);
+  }
+
+  // multiplies `a` by 2^k, for k up to 60 so `n` cannot overflow
+  static void _mytoml_decimal_left_shift(FloatDecimal *a, int k)
+  {
+    // the product has at most floor(k * log10(2)) + 1 more digits, it is
+    // written from the back and moved over the slots it did not need
+    int delta = ((k * 1233) >> 12) + 1;
+    int r = a->nd;
+    int w = a->nd + delta;
+    uint64_t n = 0;
+    while (r > 0)
     {
-      return true;
+      n += (uint64_t)a->d[--r] << k;
+      a->d[--w] = (unsigned char)(n % 10);
+      n /= 10;
     }
-    // `[[t]]`
-    // `[t.s]`
-    if (existing == TOML_ARRAYTABLE && current == TOML_TABLE)
+    while (n > 0)
     {
-      return true;
+      a->d[--w] = (unsigned char)(n % 10);
+      n /= 10;
     }
-    if (current == existing)
+    a->nd += delta - w;
+    a->dp += delta - w;
+    memmove(a->d, a->d + w, (size_t)a->nd);
+    if (a->nd > MYTOML_FLOAT_DECIMAL_DIGITS)
     {
-      return true;
+      for (int i = MYTOML_FLOAT_DECIMAL_DIGITS; i < a->nd; i++)
+        a->truncated |= a->d[i] != 0;
+      a->nd = MYTOML_FLOAT_DECIMAL_DIGITS;
     }
-    return false;
+    _mytoml_decimal_trim(a);
   }
 
-  void _mytoml_value_delete_key(TomlKey *key)
+  // multiplies `a` by 2^k, or divides it by 2^-k
+  static void _mytoml_decimal_shift(FloatDecimal *a, int k)
   {
-    if (!key)
+    if (a->nd == 0)
       return;
-    kh_destroy(str, key->subkeys);
-    if (key->value)
+    for (; k > 60; k -= 60)
+      _mytoml_decimal_left_shift(a, 60);
+    for (; k < -60; k += 60)
+      _mytoml_decimal_right_shift(a, 60);
+    if (k > 0)
+      _mytoml_decimal_left_shift(a, k);
+    else if (k < 0)
+      _mytoml_decimal_right_shift(a, -k);
+  }
+
+  // integer part of `a`, rounded to nearest with ties to even
+  static uint64_t _mytoml_decimal_round(const FloatDecimal *a)
+  {
+    if (a->dp > 20)
+      return UINT64_MAX;
+    uint64_t n = 0;
+    int i = 0;
+    for (; i < a->dp && i < a->nd; i++)
+      n = n * 10 + a->d[i];
+    for (; i < a->dp; i++)
+      n *= 10;
+    bool up = false;
+    if (a->dp >= 0 && a->dp < a->nd)
+    {
+      // a dropped digit puts an apparent tie above halfway
+      if (a->d[a->dp] == 5 && a->dp + 1 == a->nd)
+        up = a->truncated || (a->dp > 0 && a->d[a->dp - 1] % 2 != 0);
+      else
+        up = a->d[a->dp] >= 5;
+    }
+    return n + up;
+  }
+
+  // bits of the double nearest to `a`, without the sign
+  static uint64_t _mytoml_decimal_bits(FloatDecimal *a)
+  {
+    // shift that keeps `a` above 1/2 when it has `dp` integer digits
+    static const int pow2[] = {1, 3, 6, 9, 13, 16, 19, 23, 26};
+    const uint64_t infinity = (uint64_t)0x7FF << 52;
+    if (a->nd == 0 || a->dp < -330)
+      return 0;
+    if (a->dp > 310)
+      return infinity;
+    // scale into [1/2, 1), counting the powers of two in `exp`
+    int exp = 0;
+    while (a->dp > 0)
+    {
+      int n = a->dp >= 9 ? 27 : pow2[a->dp];
+      _mytoml_decimal_shift(a, -n);
+      exp += n;
+    }
+    while (a->dp < 0 || (a->dp == 0 && a->d[0] < 5))
+    {
+      int n = -a->dp >= 9 ? 27 : pow2[-a->dp];
+      _mytoml_decimal_shift(a, n);
+      exp -= n;
+    }
+    // a double keeps its mantissa in [1, 2)
+    exp--;
+    // below the smallest normal exponent the mantissa loses bits
+    if (exp < -1022)
+    {
+      _mytoml_decimal_shift(a, exp + 1022);
+      exp = -1022;
+    }
+    if (exp + 1023 >= 0x7FF)
+      return infinity;
+    _mytoml_decimal_shift(a, 53);
+    uint64_t mantissa = _mytoml_decimal_round(a);
+    // rounding carried into a new bit
+    if (mantissa == (uint64_t)2 << 52)
+    {
+      mantissa >>= 1;
+      exp++;
+      if (exp + 1023 >= 0x7FF)
+        return infinity;
+    }
+    if (!(mantissa & ((uint64_t)1 << 52)))
+      return mantissa;
+    return (mantissa & (((uint64_t)1 << 52) - 1)) |
+           (uint64_t)(exp + 1023) << 52;
+  }
+
+  bool _mytoml_float_parse_decimal(const char *s, size_t len, double *d)
+  {
+    FloatDecimal a;
+    a.nd = 0;
+    a.dp = 0;
+    a.truncated = false;
+    const char *p = s;
+    const char *e = s + len;
+    bool negative = false;
+    if (p < e && (*p == '+' || *p == '-'))
+    {
+      negative = *p == '-';
+      p++;
+    }
+    bool digits = false;
+    bool point = false;
+    for (; p < e; p++)
+    {
+      if (*p == '_')
+        continue;
+      if (*p == '.' && !point)
+      {
+        point = true;
+        continue;
+      }
+      if (!_mytoml_is_digit(*p))
+        break;
+      digits = true;
+      if (a.nd == 0 && *p == '0')
+      {
+        // leading zeros only move the point, the bound is far past any
+        // double
+        if (point && a.dp > -100000)
+          a.dp--;
+        continue;
+      }
+      if (a.nd < MYTOML_FLOAT_DECIMAL_DIGITS)
+        a.d[a.nd++] = (unsigned char)(*p - '0');
+      else if (*p != '0')
+        a.truncated = true;
+      if (!point && a.dp < 100000)
+        a.dp++;
+    }
+    if (!digits)
+      return false;
+    if (p < e && (*p == 'e' || *p == 'E'))
     {
-      _mytoml_value_delete(key->value);
+      p++;
+      bool exp_negative = false;
+      if (p < e && (*p == '+' || *p == '-'))
+      {
+        exp_negative = *p == '-';
+        p++;
+      }
+      int exp = 0;
+      size_t count = 0;
+      for (; p < e; p++)
+      {
+        if (*p == '_')
+          continue;
+        if (!_mytoml_is_digit(*p))
+          break;
+        if (exp < 100000)
+          exp = exp * 10 + (*p - '0');
+        count++;
+      }
+      if (!count)
+        return false;
+      a.dp += exp_negative ? -exp : exp;
     }
-    free(key);
+    if (p != e)
+      return false;
+    _mytoml_decimal_trim(&a);
+    uint64_t bits = _mytoml_decimal_bits(&a) | (uint64_t)negative << 63;
+    memcpy(d, &bits, sizeof(bits));
+    return true;
   }
 
   //-----------------------------------------------------------------------------
-  // [SECTION] Myjson Parser Utils
+  // [SECTION] Myjson Number Format
   //-----------------------------------------------------------------------------
 
-  bool _mytoml_is_whitesapce(char c) { return (c == ' ' || c == '\t'); }
-
-  bool _mytoml_is_newline(char c) { return (c == '\n'); }
-
-  bool _mytoml_is_return(char c) { return (c == '\r'); }
-
-  bool _mytoml_is_comment_start(char c) { return (c == '#'); }
-
-  bool _mytoml_is_equal(char c) { return (c == '='); }
-
-  bool _mytoml_is_escape(char c) { return (c == '\\'); }
-
-  bool _mytoml_is_basic_string_start(char c) { return (c == '"'); }
-
-  bool _mytoml_is_literal_string_start(char c) { return (c == '\''); }
-
-  bool _mytoml_is_table_start(char c) { return (c == '['); }
-
-  bool _mytoml_is_table_end(char c) { return (c == ']'); }
-
-  bool _mytoml_is_inline_table_start(char c) { return (c == '{'); }
-
-  bool _mytoml_is_inline_table_end(char c) { return (c == '}'); }
-
-  bool _mytoml_is_inline_table_seperator(char c) { return (c == ','); }
-
-  bool _mytoml_is_dot(char c) { return (c == '.'); }
-
-  bool _mytoml_is_digit(char c) { return (c >= '0' && c <= '9'); }
+  // 10^k rounded up to 128 bits, high word first, for k from
+  // MYTOML_FLOAT_FORMAT_MIN_POW10 to MYTOML_FLOAT_FORMAT_MAX_POW10
+  static const uint64_t _mytoml_float_format_pow10_table[][2] = {
+      {0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7bULL},
+      {0x9faacf3df73609b1ULL, 0x77b191618c54e9adULL},
+      {0xc795830d75038c1dULL, 0xd59df5b9ef6a2418ULL},
+      {0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1eULL},
+      {0x9becce62836ac577ULL, 0x4ee367f9430aec33ULL},
+      {0xc2e801fb244576d5ULL, 0x229c41f793cda740ULL},
+      {0xf3a20279ed56d48aULL, 0x6b43527578c11110ULL},
+      {0x9845418c345644d6ULL, 0x830a13896b78aaaaULL},
+      {0xbe5691ef416bd60cULL, 0x23cc986bc656d554ULL},
+      {0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa9ULL},
+      {0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6aaULL},
+      {0xb9e08a83a5e34f07ULL, 0xdaf5ccd93fb0cc54ULL},
+      {0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff69ULL},
+      {0x91376c36d99995beULL, 0x23100809b9c21fa2ULL},
+      {0xb58547448ffffb2dULL, 0xabd40a0c2832a78bULL},
+      {0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516dULL},
+      {0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e4ULL},
+      {0xb1442798f49ffb4aULL, 0x99cd11cfdf41779dULL},
+      {0xdd95317f31c7fa1dULL, 0x40405643d711d584ULL},
+      {0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2573ULL},
+      {0xad1c8eab5ee43b66ULL, 0xda3243650005eed0ULL},
+      {0xd863b256369d4a40ULL, 0x90bed43e40076a83ULL},
+      {0x873e4f75e2224e68ULL, 0x5a7744a6e804a292ULL},
+      {0xa90de3535aaae202ULL, 0x711515d0a205cb37ULL},
+      {0xd3515c2831559a83ULL, 0x0d5a5b44ca873e04ULL},
+      {0x8412d9991ed58091ULL, 0xe858790afe9486c3ULL},
+      {0xa5178fff668ae0b6ULL, 0x626e974dbe39a873ULL},
+      {0xce5d73ff402d98e3ULL, 0xfb0a3d212dc81290ULL},
+      {0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b9aULL},
+      {0xa139029f6a239f72ULL, 0x1c1fffc1ebc44e81ULL},
+      {0xc987434744ac874eULL, 0xa327ffb266b56221ULL},
+      {0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa9ULL},
+      {0x9d71ac8fada6c9b5ULL, 0x6f773fc3603db4aaULL},
+      {0xc4ce17b399107c22ULL, 0xcb550fb4384d21d4ULL},
+      {0xf6019da07f549b2bULL, 0x7e2a53a146606a49ULL},
+      {0x99c102844f94e0fbULL, 0x2eda7444cbfc426eULL},
+      {0xc0314325637a1939ULL, 0xfa911155fefb5309ULL},
+      {0xf03d93eebc589f88ULL, 0x793555ab7eba27cbULL},
+      {0x96267c7535b763b5ULL, 0x4bc1558b2f3458dfULL},
+      {0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f17ULL},
+      {0xea9c227723ee8bcbULL, 0x465e15a979c1caddULL},
+      {0x92a1958a7675175fULL, 0x0bfacd89ec191ecaULL},
+      {0xb749faed14125d36ULL, 0xcef980ec671f667cULL},
+      {0xe51c79a85916f484ULL, 0x82b7e12780e7401bULL},
+      {0x8f31cc0937ae58d2ULL, 0xd1b2ecb8b0908811ULL},
+      {0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa16ULL},
+      {0xdfbdcece67006ac9ULL, 0x67a791e093e1d49bULL},
+      {0x8bd6a141006042bdULL, 0xe0c8bb2c5c6d24e1ULL},
+      {0xaecc49914078536dULL, 0x58fae9f773886e19ULL},
+      {0xda7f5bf590966848ULL, 0xaf39a475506a899fULL},
+      {0x888f99797a5e012dULL, 0x6d8406c952429604ULL},
+      {0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b84ULL},
+      {0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a65ULL},
+      {0x855c3be0a17fcd26ULL, 0x5cf2eea09a550680ULL},
+      {0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481fULL},
+      {0xd0601d8efc57b08bULL, 0xf13b94daf124da27ULL},
+      {0x823c12795db6ce57ULL, 0x76c53d08d6b70859ULL},
+      {0xa2cb1717b52481edULL, 0x54768c4b0c64ca6fULL},
+      {0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd0aULL},
+      {0xfe5d54150b090b02ULL, 0xd3f93b35435d7c4dULL},
+      {0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6db0ULL},
+      {0xc6b8e9b0709f109aULL, 0x359ab6419ca1091cULL},
+      {0xf867241c8cc6d4c0ULL, 0xc30163d203c94b63ULL},
+      {0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1eULL},
+      {0xc21094364dfb5636ULL, 0x985915fc12f542e5ULL},
+      {0xf294b943e17a2bc4ULL, 0x3e6f5b7b17b2939eULL},
+      {0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c43ULL},
+      {0xbd8430bd08277231ULL, 0x50c6ff782a838354ULL},
+      {0xece53cec4a314ebdULL, 0xa4f8bf5635246429ULL},
+      {0x940f4613ae5ed136ULL, 0x871b7795e136be9aULL},
+      {0xb913179899f68584ULL, 0x28e2557b59846e40ULL},
+      {0xe757dd7ec07426e5ULL, 0x331aeada2fe589d0ULL},
+      {0x9096ea6f3848984fULL, 0x3ff0d2c85def7622ULL},
+      {0xb4bca50b065abe63ULL, 0x0fed077a756b53aaULL},
+      {0xe1ebce4dc7f16dfbULL, 0xd3e8495912c62895ULL},
+      {0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95dULL},
+      {0xb080392cc4349decULL, 0xbd8d794d96aacfb4ULL},
+      {0xdca04777f541c567ULL, 0xecf0d7a0fc5583a1ULL},
+      {0x89e42caaf9491b60ULL, 0xf41686c49db57245ULL},
+      {0xac5d37d5b79b6239ULL, 0x311c2875c522ced6ULL},
+      {0xd77485cb25823ac7ULL, 0x7d633293366b828cULL},
+      {0x86a8d39ef77164bcULL, 0xae5dff9c02033198ULL},
+      {0xa8530886b54dbdebULL, 0xd9f57f830283fdfdULL},
+      {0xd267caa862a12d66ULL, 0xd072df63c324fd7cULL},
+      {0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6eULL},
+      {0xa46116538d0deb78ULL, 0x52d9be85f074e609ULL},
+      {0xcd795be870516656ULL, 0x67902e276c921f8cULL},
+      {0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b7ULL},
+      {0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a5ULL},
+      {0xc8a883c0fdaf7df0ULL, 0x6122cd128006b2ceULL},
+      {0xfad2a4b13d1b5d6cULL, 0x796b805720085f82ULL},
+      {0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb1ULL},
+      {0xc3f490aa77bd60fcULL, 0xbedbfc4411068a9dULL},
+      {0xf4f1b4d515acb93bULL, 0xee92fb5515482d45ULL},
+      {0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4bULL},
+      {0xbf5cd54678eef0b6ULL, 0xd262d45a78a0635eULL},
+      {0xef340a98172aace4ULL, 0x86fb897116c87c35ULL},
+      {0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da1ULL},
+      {0xbae0a846d2195712ULL, 0x8974836059cca10aULL},
+      {0xe998d258869facd7ULL, 0x2bd1a438703fc94cULL},
+      {0x91ff83775423cc06ULL, 0x7b6306a34627ddd0ULL},
+      {0xb67f6455292cbf08ULL, 0x1a3bc84c17b1d543ULL},
+      {0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a94ULL},
+      {0x8e938662882af53eULL, 0x547eb47b7282ee9dULL},
+      {0xb23867fb2a35b28dULL, 0xe99e619a4f23aa44ULL},
+      {0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d5ULL},
+      {0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd05ULL},
+      {0xae0b158b4738705eULL, 0x9624ab50b148d446ULL},
+      {0xd98ddaee19068c76ULL, 0x3badd624dd9b0958ULL},
+      {0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d7ULL},
+      {0xa9f6d30a038d1dbcULL, 0x5e9fcf4ccd211f4dULL},
+      {0xd47487cc8470652bULL, 0x7647c32000696720ULL},
+      {0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e074ULL},
+      {0xa5fb0a17c777cf09ULL, 0xf468107100525891ULL},
+      {0xcf79cc9db955c2ccULL, 0x7182148d4066eeb5ULL},
+      {0x81ac1fe293d599bfULL, 0xc6f14cd848405531ULL},
+      {0xa21727db38cb002fULL, 0xb8ada00e5a506a7dULL},
+      {0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851dULL},
+      {0xfd442e4688bd304aULL, 0x908f4a166d1da664ULL},
+      {0x9e4a9cec15763e2eULL, 0x9a598e4e043287ffULL},
+      {0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29feULL},
+      {0xf7549530e188c128ULL, 0xd12bee59e68ef47dULL},
+      {0x9a94dd3e8cf578b9ULL, 0x82bb74f8301958cfULL},
+      {0xc13a148e3032d6e7ULL, 0xe36a52363c1faf02ULL},
+      {0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac2ULL},
+      {0x96f5600f15a7b7e5ULL, 0x29ab103a5ef8c0baULL},
+      {0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e8ULL},
+      {0xebdf661791d60f56ULL, 0x111b495b3464ad22ULL},
+      {0x936b9fcebb25c995ULL, 0xcab10dd900beec35ULL},
+      {0xb84687c269ef3bfbULL, 0x3d5d514f40eea743ULL},
+      {0xe65829b3046b0afaULL, 0x0cb4a5a3112a5113ULL},
+      {0x8ff71a0fe2c2e6dcULL, 0x47f0e785eaba72acULL},
+      {0xb3f4e093db73a093ULL, 0x59ed216765690f57ULL},
+      {0xe0f218b8d25088b8ULL, 0x306869c13ec3532dULL},
+      {0x8c974f7383725573ULL, 0x1e414218c73a13fcULL},
+      {0xafbd2350644eeacfULL, 0xe5d1929ef90898fbULL},
+      {0xdbac6c247d62a583ULL, 0xdf45f746b74abf3aULL},
+      {0x894bc396ce5da772ULL, 0x6b8bba8c328eb784ULL},
+      {0xab9eb47c81f5114fULL, 0x066ea92f3f326565ULL},
+      {0xd686619ba27255a2ULL, 0xc80a537b0efefebeULL},
+      {0x8613fd0145877585ULL, 0xbd06742ce95f5f37ULL},
+      {0xa798fc4196e952e7ULL, 0x2c48113823b73705ULL},
+      {0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c6ULL},
+      {0x82ef85133de648c4ULL, 0x9a984d73dbe722fcULL},
+      {0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbbULL},
+      {0xcc963fee10b7d1b3ULL, 0x318df905079926a9ULL},
+      {0xffbbcfe994e5c61fULL, 0xfdf17746497f7053ULL},
+      {0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa634ULL},
+      {0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc1ULL},
+      {0xf9bd690a1b68637bULL, 0x3dfdce7aa3c673b1ULL},
+      {0x9c1661a651213e2dULL, 0x06bea10ca65c084fULL},
+      {0xc31bfa0fe5698db8ULL, 0x486e494fcff30a63ULL},
+      {0xf3e2f893dec3f126ULL, 0x5a89dba3c3efccfbULL},
+      {0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01dULL},
+      {0xbe89523386091465ULL, 0xf6bbb397f1135824ULL},
+      {0xee2ba6c0678b597fULL, 0x746aa07ded582e2dULL},
+      {0x94db483840b717efULL, 0xa8c2a44eb4571cddULL},
+      {0xba121a4650e4ddebULL, 0x92f34d62616ce414ULL},
+      {0xe896a0d7e51e1566ULL, 0x77b020baf9c81d18ULL},
+      {0x915e2486ef32cd60ULL, 0x0ace1474dc1d122fULL},
+      {0xb5b5ada8aaff80b8ULL, 0x0d819992132456bbULL},
+      {0xe3231912d5bf60e6ULL, 0x10e1fff697ed6c6aULL},
+      {0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c2ULL},
+      {0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb3ULL},
+      {0xddd0467c64bce4a0ULL, 0xac7cb3f6d05ddbdfULL},
+      {0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96cULL},
+      {0xad4ab7112eb3929dULL, 0x86c16c98d2c953c7ULL},
+      {0xd89d64d57a607744ULL, 0xe871c7bf077ba8b8ULL},
+      {0x87625f056c7c4a8bULL, 0x11471cd764ad4973ULL},
+      {0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bd0ULL},
+      {0xd389b47879823479ULL, 0x4aff1d108d4ec2c4ULL},
+      {0x843610cb4bf160cbULL, 0xcedf722a585139bbULL},
+      {0xa54394fe1eedb8feULL, 0xc2974eb4ee658829ULL},
+      {0xce947a3da6a9273eULL, 0x733d226229feea33ULL},
+      {0x811ccc668829b887ULL, 0x0806357d5a3f5260ULL},
+      {0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f8ULL},
+      {0xc9bcff6034c13052ULL, 0xfc89b393dd02f0b6ULL},
+      {0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace3ULL},
+      {0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0eULL},
+      {0xc5029163f384a931ULL, 0x0a9e795e65d4df12ULL},
+      {0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d6ULL},
+      {0x99ea0196163fa42eULL, 0x504bced1bf8e4e46ULL},
+      {0xc06481fb9bcf8d39ULL, 0xe45ec2862f71e1d7ULL},
+      {0xf07da27a82c37088ULL, 0x5d767327bb4e5a4dULL},
+      {0x964e858c91ba2655ULL, 0x3a6a07f8d510f870ULL},
+      {0xbbe226efb628afeaULL, 0x890489f70a55368cULL},
+      {0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842fULL},
+      {0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929eULL},
+      {0xb77ada0617e3bbcbULL, 0x09ce6ebb40173745ULL},
+      {0xe55990879ddcaabdULL, 0xcc420a6a101d0516ULL},
+      {0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232eULL},
+      {0xb32df8e9f3546564ULL, 0x47939822dc96abfaULL},
+      {0xdff9772470297ebdULL, 0x59787e2b93bc56f8ULL},
+      {0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65bULL},
+      {0xaefae51477a06b03ULL, 0xede622920b6b23f2ULL},
+      {0xdab99e59958885c4ULL, 0xe95fab368e45eceeULL},
+      {0x88b402f7fd75539bULL, 0x11dbcb0218ebb415ULL},
+      {0xaae103b5fcd2a881ULL, 0xd652bdc29f26a11aULL},
+      {0xd59944a37c0752a2ULL, 0x4be76d3346f04960ULL},
+      {0x857fcae62d8493a5ULL, 0x6f70a4400c562ddcULL},
+      {0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb953ULL},
+      {0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a8ULL},
+      {0x825ecc24c873782fULL, 0x8ed400668c0c28c9ULL},
+      {0xa2f67f2dfa90563bULL, 0x728900802f0f32fbULL},
+      {0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffbaULL},
+      {0xfea126b7d78186bcULL, 0xe2f610c84987bfa9ULL},
+      {0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7caULL},
+      {0xc6ede63fa05d3143ULL, 0x91503d1c79720dbcULL},
+      {0xf8a95fcf88747d94ULL, 0x75a44c6397ce912bULL},
+      {0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abbULL},
+      {0xc24452da229b021bULL, 0xfbe85badce996169ULL},
+      {0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c4ULL},
+      {0x97c560ba6b0919a5ULL, 0xdccd879fc967d41bULL},
+      {0xbdb6b8e905cb600fULL, 0x5400e987bbc1c921ULL},
+      {0xed246723473e3813ULL, 0x290123e9aab23b69ULL},
+      {0x9436c0760c86e30bULL, 0xf9a0b6720aaf6522ULL},
+      {0xb94470938fa89bceULL, 0xf808e40e8d5b3e6aULL},
+      {0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e05ULL},
+      {0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c3ULL},
+      {0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af4ULL},
+      {0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b1ULL},
+      {0x8d590723948a535fULL, 0x579c487e5a38ad0fULL},
+      {0xb0af48ec79ace837ULL, 0x2d835a9df0c6d852ULL},
+      {0xdcdb1b2798182244ULL, 0xf8e431456cf88e66ULL},
+      {0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b5900ULL},
+      {0xac8b2d36eed2dac5ULL, 0xe272467e3d222f40ULL},
+      {0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb10ULL},
+      {0x86ccbb52ea94baeaULL, 0x98e947129fc2b4eaULL},
+      {0xa87fea27a539e9a5ULL, 0x3f2398d747b36225ULL},
+      {0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aaeULL},
+      {0x83a3eeeef9153e89ULL, 0x1953cf68300424adULL},
+      {0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd8ULL},
+      {0xcdb02555653131b6ULL, 0x3792f412cb06794eULL},
+      {0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd1ULL},
+      {0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec5ULL},
+      {0xc8de047564d20a8bULL, 0xf245825a5a445276ULL},
+      {0xfb158592be068d2eULL, 0xeed6e2f0f0d56713ULL},
+      {0x9ced737bb6c4183dULL, 0x55464dd69685606cULL},
+      {0xc428d05aa4751e4cULL, 0xaa97e14c3c26b887ULL},
+      {0xf53304714d9265dfULL, 0xd53dd99f4b3066a9ULL},
+      {0x993fe2c6d07b7fabULL, 0xe546a8038efe402aULL},
+      {0xbf8fdb78849a5f96ULL, 0xde98520472bdd034ULL},
+      {0xef73d256a5c0f77cULL, 0x963e66858f6d4441ULL},
+      {0x95a8637627989aadULL, 0xdde7001379a44aa9ULL},
+      {0xbb127c53b17ec159ULL, 0x5560c018580d5d53ULL},
+      {0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a7ULL},
+      {0x9226712162ab070dULL, 0xcab3961304ca70e9ULL},
+      {0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d23ULL},
+      {0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506bULL},
+      {0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb243ULL},
+      {0xb267ed1940f1c61cULL, 0x55f038b237591ed4ULL},
+      {0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6689ULL},
+      {0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da016ULL},
+      {0xae397d8aa96c1b77ULL, 0xabec975e0a0d081bULL},
+      {0xd9c7dced53c72255ULL, 0x96e7bd358c904a22ULL},
+      {0x881cea14545c7575ULL, 0x7e50d64177da2e55ULL},
+      {0xaa242499697392d2ULL, 0xdde50bd1d5d0b9eaULL},
+      {0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e865ULL},
+      {0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113fULL},
+      {0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58fULL},
+      {0xcfb11ead453994baULL, 0x67de18eda5814af3ULL},
+      {0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced8ULL},
+      {0xa2425ff75e14fc31ULL, 0xa1258379a94d028eULL},
+      {0xcad2f7f5359a3b3eULL, 0x096ee45813a04331ULL},
+      {0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fdULL},
+      {0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL},
+      {0xc612062576589ddaULL, 0x95364afe032a819eULL},
+      {0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL},
+      {0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL},
+      {0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL},
+      {0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL},
+      {0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL},
+      {0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL},
+      {0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL},
+      {0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL},
+      {0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL},
+      {0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL},
+      {0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL},
+      {0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL},
+      {0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL},
+      {0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL},
+      {0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL},
+      {0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL},
+      {0x89705f4136b4a597ULL, 0x31680a88f8953031ULL},
+      {0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL},
+      {0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL},
+      {0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL},
+      {0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL},
+      {0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL},
+      {0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL},
+      {0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL},
+      {0xccccccccccccccccULL, 0xcccccccccccccccdULL},
+      {0x8000000000000000ULL, 0x0000000000000001ULL},
+      {0xa000000000000000ULL, 0x0000000000000001ULL},
+      {0xc800000000000000ULL, 0x0000000000000001ULL},
+      {0xfa00000000000000ULL, 0x0000000000000001ULL},
+      {0x9c40000000000000ULL, 0x0000000000000001ULL},
+      {0xc350000000000000ULL, 0x0000000000000001ULL},
+      {0xf424000000000000ULL, 0x0000000000000001ULL},
+      {0x9896800000000000ULL, 0x0000000000000001ULL},
+      {0xbebc200000000000ULL, 0x0000000000000001ULL},
+      {0xee6b280000000000ULL, 0x0000000000000001ULL},
+      {0x9502f90000000000ULL, 0x0000000000000001ULL},
+      {0xba43b74000000000ULL, 0x0000000000000001ULL},
+      {0xe8d4a51000000000ULL, 0x0000000000000001ULL},
+      {0x9184e72a00000000ULL, 0x0000000000000001ULL},
+      {0xb5e620f480000000ULL, 0x0000000000000001ULL},
+      {0xe35fa931a0000000ULL, 0x0000000000000001ULL},
+      {0x8e1bc9bf04000000ULL, 0x0000000000000001ULL},
+      {0xb1a2bc2ec5000000ULL, 0x0000000000000001ULL},
+      {0xde0b6b3a76400000ULL, 0x0000000000000001ULL},
+      {0x8ac7230489e80000ULL, 0x0000000000000001ULL},
+      {0xad78ebc5ac620000ULL, 0x0000000000000001ULL},
+      {0xd8d726b7177a8000ULL, 0x0000000000000001ULL},
+      {0x878678326eac9000ULL, 0x0000000000000001ULL},
+      {0xa968163f0a57b400ULL, 0x0000000000000001ULL},
+      {0xd3c21bcecceda100ULL, 0x0000000000000001ULL},
+      {0x84595161401484a0ULL, 0x0000000000000001ULL},
+      {0xa56fa5b99019a5c8ULL, 0x0000000000000001ULL},
+      {0xcecb8f27f4200f3aULL, 0x0000000000000001ULL},
+      {0x813f3978f8940984ULL, 0x4000000000000001ULL},
+      {0xa18f07d736b90be5ULL, 0x5000000000000001ULL},
+      {0xc9f2c9cd04674edeULL, 0xa400000000000001ULL},
+      {0xfc6f7c4045812296ULL, 0x4d00000000000001ULL},
+      {0x9dc5ada82b70b59dULL, 0xf020000000000001ULL},
+      {0xc5371912364ce305ULL, 0x6c28000000000001ULL},
+      {0xf684df56c3e01bc6ULL, 0xc732000000000001ULL},
+      {0x9a130b963a6c115cULL, 0x3c7f400000000001ULL},
+      {0xc097ce7bc90715b3ULL, 0x4b9f100000000001ULL},
+      {0xf0bdc21abb48db20ULL, 0x1e86d40000000001ULL},
+      {0x96769950b50d88f4ULL, 0x1314448000000001ULL},
+      {0xbc143fa4e250eb31ULL, 0x17d955a000000001ULL},
+      {0xeb194f8e1ae525fdULL, 0x5dcfab0800000001ULL},
+      {0x92efd1b8d0cf37beULL, 0x5aa1cae500000001ULL},
+      {0xb7abc627050305adULL, 0xf14a3d9e40000001ULL},
+      {0xe596b7b0c643c719ULL, 0x6d9ccd05d0000001ULL},
+      {0x8f7e32ce7bea5c6fULL, 0xe4820023a2000001ULL},
+      {0xb35dbf821ae4f38bULL, 0xdda2802c8a800001ULL},
+      {0xe0352f62a19e306eULL, 0xd50b2037ad200001ULL},
+      {0x8c213d9da502de45ULL, 0x4526f422cc340001ULL},
+      {0xaf298d050e4395d6ULL, 0x9670b12b7f410001ULL},
+      {0xdaf3f04651d47b4cULL, 0x3c0cdd765f114001ULL},
+      {0x88d8762bf324cd0fULL, 0xa5880a69fb6ac801ULL},
+      {0xab0e93b6efee0053ULL, 0x8eea0d047a457a01ULL},
+      {0xd5d238a4abe98068ULL, 0x72a4904598d6d881ULL},
+      {0x85a36366eb71f041ULL, 0x47a6da2b7f864751ULL},
+      {0xa70c3c40a64e6c51ULL, 0x999090b65f67d925ULL},
+      {0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6eULL},
+      {0x82818f1281ed449fULL, 0xbff8f10e7a8921a5ULL},
+      {0xa321f2d7226895c7ULL, 0xaff72d52192b6a0eULL},
+      {0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764491ULL},
+      {0xfee50b7025c36a08ULL, 0x02f236d04753d5b5ULL},
+      {0x9f4f2726179a2245ULL, 0x01d762422c946591ULL},
+      {0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef6ULL},
+      {0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb3ULL},
+      {0x9b934c3b330c8577ULL, 0x63cc55f49f88eb30ULL},
+      {0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fcULL},
+      {0xf316271c7fc3908aULL, 0x8bef464e3945ef7bULL},
+      {0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5adULL},
+      {0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea318ULL},
+      {0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bdeULL},
+      {0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6bULL},
+      {0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b45ULL},
+      {0xe7d34c64a9c85d44ULL, 0x60dbbca87196b617ULL},
+      {0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31ceULL},
+      {0xb51d13aea4a488ddULL, 0x6babab6398bdbe42ULL},
+      {0xe264589a4dcdab14ULL, 0xc696963c7eed2dd2ULL},
+      {0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca3ULL},
+      {0xb0de65388cc8ada8ULL, 0x3b25a55f43294bccULL},
+      {0xdd15fe86affad912ULL, 0x49ef0eb713f39ebfULL},
+      {0x8a2dbf142dfcc7abULL, 0x6e3569326c784338ULL},
+      {0xacb92ed9397bf996ULL, 0x49c2c37f07965405ULL},
+      {0xd7e77a8f87daf7fbULL, 0xdc33745ec97be907ULL},
+      {0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a4ULL},
+      {0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0dULL},
+      {0xd2d80db02aabd62bULL, 0xf50a3fa490c30191ULL},
+      {0x83c7088e1aab65dbULL, 0x792667c6da79e0fbULL},
+      {0xa4b8cab1a1563f52ULL, 0x577001b891185939ULL},
+      {0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f87ULL},
+      {0x80b05e5ac60b6178ULL, 0x544f8158315b05b5ULL},
+      {0xa0dc75f1778e39d6ULL, 0x696361ae3db1c722ULL},
+      {0xc913936dd571c84cULL, 0x03bc3a19cd1e38eaULL},
+      {0xfb5878494ace3a5fULL, 0x04ab48a04065c724ULL},
+      {0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c77ULL},
+      {0xc45d1df942711d9aULL, 0x3ba5d0bd324f8395ULL},
+      {0xf5746577930d6500ULL, 0xca8f44ec7ee3647aULL},
+      {0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1eccULL},
+      {0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67fULL},
+      {0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101fULL},
+      {0x95d04aee3b80ece5ULL, 0xbba1f1d158724a13ULL},
+      {0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc98ULL},
+      {0xea1575143cf97226ULL, 0xf52d09d71a3293beULL},
+      {0x924d692ca61be758ULL, 0x593c2626705f9c57ULL},
+      {0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836dULL},
+      {0xe498f455c38b997aULL, 0x0b6dfb9c0f956448ULL},
+      {0x8edf98b59a373fecULL, 0x4724bd4189bd5eadULL},
+      {0xb2977ee300c50fe7ULL, 0x58edec91ec2cb658ULL},
+      {0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3eeULL},
+      {0x8b865b215899f46cULL, 0xbd79e0d20082ee75ULL},
+      {0xae67f1e9aec07187ULL, 0xecd8590680a3aa12ULL},
+      {0xda01ee641a708de9ULL, 0xe80e6f4820cc9496ULL},
+      {0x884134fe908658b2ULL, 0x3109058d147fdcdeULL},
+      {0xaa51823e34a7eedeULL, 0xbd4b46f0599fd416ULL},
+      {0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91bULL},
+      {0x850fadc09923329eULL, 0x03e2cf6bc604ddb1ULL},
+      {0xa6539930bf6bff45ULL, 0x84db8346b786151dULL},
+      {0xcfe87f7cef46ff16ULL, 0xe612641865679a64ULL},
+      {0x81f14fae158c5f6eULL, 0x4fcb7e8f3f60c07fULL},
+      {0xa26da3999aef7749ULL, 0xe3be5e330f38f09eULL},
+      {0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc6ULL},
+      {0xfdcb4fa002162a63ULL, 0x73d9732fc7c8f7f7ULL},
+      {0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afbULL},
+      {0xc646d63501a1511dULL, 0xb281e1fd541501b9ULL},
+      {0xf7d88bc24209a565ULL, 0x1f225a7ca91a4227ULL},
+      {0x9ae757596946075fULL, 0x3375788de9b06959ULL},
+      {0xc1a12d2fc3978937ULL, 0x0052d6b1641c83afULL},
+      {0xf209787bb47d6b84ULL, 0xc0678c5dbd23a49bULL},
+      {0x9745eb4d50ce6332ULL, 0xf840b7ba963646e1ULL},
+      {0xbd176620a501fbffULL, 0xb650e5a93bc3d899ULL},
+      {0xec5d3fa8ce427affULL, 0xa3e51f138ab4cebfULL},
+      {0x93ba47c980e98cdfULL, 0xc66f336c36b10138ULL},
+      {0xb8a8d9bbe123f017ULL, 0xb80b0047445d4185ULL},
+      {0xe6d3102ad96cec1dULL, 0xa60dc059157491e6ULL},
+      {0x9043ea1ac7e41392ULL, 0x87c89837ad68db30ULL},
+      {0xb454e4a179dd1877ULL, 0x29babe4598c311fcULL},
+      {0xe16a1dc9d8545e94ULL, 0xf4296dd6fef3d67bULL},
+      {0x8ce2529e2734bb1dULL, 0x1899e4a65f58660dULL},
+      {0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f90ULL},
+      {0xdc21a1171d42645dULL, 0x76707543f4fa1f74ULL},
+      {0x899504ae72497ebaULL, 0x6a06494a791c53a9ULL},
+      {0xabfa45da0edbde69ULL, 0x0487db9d17636893ULL},
+      {0xd6f8d7509292d603ULL, 0x45a9d2845d3c42b7ULL},
+      {0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b3ULL},
+      {0xa7f26836f282b732ULL, 0x8e6cac7768d7141fULL},
+      {0xd1ef0244af2364ffULL, 0x3207d795430cd927ULL},
+      {0x8335616aed761f1fULL, 0x7f44e6bd49e807b9ULL},
+      {0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a7ULL},
+      {0xcd036837130890a1ULL, 0x36dba887c37a8c10ULL},
+      {0x802221226be55a64ULL, 0xc2494954da2c978aULL},
+      {0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6dULL},
+      {0xc83553c5c8965d3dULL, 0x6f92829494e5acc8ULL},
+      {0xfa42a8b73abbf48cULL, 0xcb772339ba1f17faULL},
+      {0x9c69a97284b578d7ULL, 0xff2a760414536efcULL},
+      {0xc38413cf25e2d70dULL, 0xfef5138519684abbULL},
+      {0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d6aULL},
+      {0x98bf2f79d5993802ULL, 0xef2f773ffbd97a62ULL},
+      {0xbeeefb584aff8603ULL, 0xaafb550ffacfd8fbULL},
+      {0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf39ULL},
+      {0x952ab45cfa97a0b2ULL, 0xdd945a747bf26184ULL},
+      {0xba756174393d88dfULL, 0x94f971119aeef9e5ULL},
+      {0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85eULL},
+      {0x91abb422ccb812eeULL, 0xac62e055c10ab33bULL},
+      {0xb616a12b7fe617aaULL, 0x577b986b314d600aULL},
+      {0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80cULL},
+      {0x8e41ade9fbebc27dULL, 0x14588f13be847308ULL},
+      {0xb1d219647ae6b31cULL, 0x596eb2d8ae258fc9ULL},
+      {0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bcULL},
+      {0x8aec23d680043beeULL, 0x25de7bb9480d5855ULL},
+      {0xada72ccc20054ae9ULL, 0xaf561aa79a10ae6bULL},
+      {0xd910f7ff28069da4ULL, 0x1b2ba1518094da05ULL},
+      {0x87aa9aff79042286ULL, 0x90fb44d2f05d0843ULL},
+      {0xa99541bf57452b28ULL, 0x353a1607ac744a54ULL},
+      {0xd3fa922f2d1675f2ULL, 0x42889b8997915ce9ULL},
+      {0x847c9b5d7c2e09b7ULL, 0x69956135febada12ULL},
+      {0xa59bc234db398c25ULL, 0x43fab9837e699096ULL},
+      {0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bcULL},
+      {0x8161afb94b44f57dULL, 0x1d1be0eebac278f6ULL},
+      {0xa1ba1ba79e1632dcULL, 0x6462d92a69731733ULL},
+      {0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcffULL},
+      {0xfcb2cb35e702af78ULL, 0x5cda735244c3d43fULL},
+      {0x9defbf01b061adabULL, 0x3a0888136afa64a8ULL},
+      {0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd1ULL},
+      {0xf6c69a72a3989f5bULL, 0x8aad549e57273d46ULL},
+      {0x9a3c2087a63f6399ULL, 0x36ac54e2f678864cULL},
+      {0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7deULL},
+      {0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d6ULL},
+      {0x969eb7c47859e743ULL, 0x9f644ae5a4b1b326ULL},
+      {0xbc4665b596706114ULL, 0x873d5d9f0dde1fefULL},
+      {0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7ebULL},
+      {0x9316ff75dd87cbd8ULL, 0x09a7f12442d588f3ULL},
+      {0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb30ULL},
+      {0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5fbULL},
+      {0x8fa475791a569d10ULL, 0xf96e017d694487bdULL},
+      {0xb38d92d760ec4455ULL, 0x37c981dcc395a9adULL},
+      {0xe070f78d3927556aULL, 0x85bbe253f47b1418ULL},
+      {0x8c469ab843b89562ULL, 0x93956d7478ccec8fULL},
+      {0xaf58416654a6babbULL, 0x387ac8d1970027b3ULL},
+      {0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319fULL},
+      {0x88fcf317f22241e2ULL, 0x441fece3bdf81f04ULL},
+      {0xab3c2fddeeaad25aULL, 0xd527e81cad7626c4ULL},
+      {0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b075ULL},
+      {0x85c7056562757456ULL, 0xf6872d5667844e4aULL},
+      {0xa738c6bebb12d16cULL, 0xb428f8ac016561dcULL},
+      {0xd106f86e69d785c7ULL, 0xe13336d701beba53ULL},
+      {0x82a45b450226b39cULL, 0xecc0024661173474ULL},
+      {0xa34d721642b06084ULL, 0x27f002d7f95d0191ULL},
+      {0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f5ULL},
+      {0xff290242c83396ceULL, 0x7e67047175a15272ULL},
+      {0x9f79a169bd203e41ULL, 0x0f0062c6e984d387ULL},
+      {0xc75809c42c684dd1ULL, 0x52c07b78a3e60869ULL},
+      {0xf92e0c3537826145ULL, 0xa7709a56ccdf8a83ULL},
+      {0x9bbcc7a142b17ccbULL, 0x88a66076400bb692ULL},
+      {0xc2abf989935ddbfeULL, 0x6acff893d00ea436ULL},
+      {0xf356f7ebf83552feULL, 0x0583f6b8c4124d44ULL},
+      {0x98165af37b2153deULL, 0xc3727a337a8b704bULL},
+      {0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5dULL},
+      {0xeda2ee1c7064130cULL, 0x1162def06f79df74ULL},
+      {0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba9ULL},
+      {0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173693ULL},
+      {0xe8111c87c5c1ba99ULL, 0xc8fa8db6ccdd0438ULL},
+      {0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a3ULL},
+      {0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4cULL},
+      {0xe2a0b5dc971f303aULL, 0x2e44ae64840fd61eULL},
+      {0x8da471a9de737e24ULL, 0x5ceaecfed289e5d3ULL},
+      {0xb10d8e1456105dadULL, 0x7425a83e872c5f48ULL},
+      {0xdd50f1996b947518ULL, 0xd12f124e28f7771aULL},
+      {0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa70ULL},
+      {0xace73cbfdc0bfb7bULL, 0x636cc64d1001550cULL},
+      {0xd8210befd30efa5aULL, 0x3c47f7e05401aa4fULL},
+      {0x8714a775e3e95c78ULL, 0x65acfaec34810a72ULL},
+      {0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0eULL},
+      {0xd31045a8341ca07cULL, 0x1ede48111209a051ULL},
+      {0x83ea2b892091e44dULL, 0x934aed0aab460433ULL},
+      {0xa4e4b66b68b65d60ULL, 0xf81da84d56178540ULL},
+      {0xce1de40642e3f4b9ULL, 0x36251260ab9d668fULL},
+      {0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b42601aULL},
+      {0xa1075a24e4421730ULL, 0xb24cf65b8612f820ULL},
+      {0xc94930ae1d529cfcULL, 0xdee033f26797b628ULL},
+      {0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b2ULL},
+      {0x9d412e0806e88aa5ULL, 0x8e1f289560ee864fULL},
+      {0xc491798a08a2ad4eULL, 0xf1a6f2bab92a27e3ULL},
+      {0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dcULL},
+      {0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef2aULL},
+      {0xbff610b0cc6edd3fULL, 0x17fd090a58d32af4ULL},
+      {0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b1ULL},
+      {0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98fULL},
+      {0xbb764c4ca7a4440fULL, 0x9d6d1ad41abe37f2ULL},
+      {0xea53df5fd18d5513ULL, 0x84c86189216dc5eeULL},
+      {0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb5ULL},
+      {0xb7118682dbb66a77ULL, 0x3fbc8c33221dc2a2ULL},
+      {0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334bULL},
+      {0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400fULL},
+      {0xb2c71d5bca9023f8ULL, 0x743e20e9ef511013ULL},
+      {0xdf78e4b2bd342cf6ULL, 0x914da9246b255417ULL},
+      {0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548fULL},
+      {0xae9672aba3d0c320ULL, 0xa184ac2473b529b2ULL},
+      {0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741fULL},
+      {0x8865899617fb1871ULL, 0x7e2fa67c7a658893ULL},
+      {0xaa7eebfb9df9de8dULL, 0xddbb901b98feeab8ULL},
+      {0xd51ea6fa85785631ULL, 0x552a74227f3ea566ULL},
+      {0x8533285c936b35deULL, 0xd53a88958f872760ULL},
+      {0xa67ff273b8460356ULL, 0x8a892abaf368f138ULL},
+      {0xd01fef10a657842cULL, 0x2d2b7569b0432d86ULL},
+      {0x8213f56a67f6b29bULL, 0x9c3b29620e29fc74ULL},
+      {0xa298f2c501f45f42ULL, 0x8349f3ba91b47b90ULL},
+      {0xcb3f2f7642717713ULL, 0x241c70a936219a74ULL},
+      {0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0111ULL},
+      {0x9ec95d1463e8a506ULL, 0xf4363804324a40abULL},
+      {0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d6ULL},
+      {0xf81aa16fdc1b81daULL, 0xdd94b7868e94050bULL},
+      {0x9b10a4e5e9913128ULL, 0xca7cf2b4191c8327ULL},
+      {0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f1ULL},
+      {0xf24a01a73cf2dccfULL, 0xbc633b39673c8cedULL},
+      {0x976e41088617ca01ULL, 0xd5be0503e085d814ULL},
+      {0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e19ULL},
+      {0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219fULL},
+      {0x93e1ab8252f33b45ULL, 0xcabb90e5c942b504ULL},
+      {0xb8da1662e7b00a17ULL, 0x3d6a751f3b936244ULL},
+      {0xe7109bfba19c0c9dULL, 0x0cc512670a783ad5ULL},
+      {0x906a617d450187e2ULL, 0x27fb2b80668b24c6ULL},
+      {0xb484f9dc9641e9daULL, 0xb1f9f660802dedf7ULL},
+      {0xe1a63853bbd26451ULL, 0x5e7873f8a0396974ULL},
+      {0x8d07e33455637eb2ULL, 0xdb0b487b6423e1e9ULL},
+      {0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda63ULL},
+      {0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fcULL},
+      {0x89b9b3e11b6329baULL, 0xa9e904c87fcb0a9eULL},
+      {0xac2820d9623bf429ULL, 0x546345fa9fbdcd45ULL},
+      {0xd732290fbacaf133ULL, 0xa97c177947ad4096ULL},
+      {0x867f59a9d4bed6c0ULL, 0x49ed8eabcccc485eULL},
+      {0xa81f301449ee8c70ULL, 0x5c68f256bfff5a75ULL},
+      {0xd226fc195c6a2f8cULL, 0x73832eec6fff3112ULL},
+      {0x83585d8fd9c25db7ULL, 0xc831fd53c5ff7eacULL},
+      {0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e56ULL},
+      {0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ecULL},
+      {0x80444b5e7aa7cf85ULL, 0x7980d163cf5b81b4ULL},
+      {0xa0555e361951c366ULL, 0xd7e105bcc3326220ULL},
+      {0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa8ULL},
+      {0xfa856334878fc150ULL, 0xb14f98f6f0feb952ULL},
+      {0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d4ULL},
+      {0xc3b8358109e84f07ULL, 0x0a862f80ec4700c9ULL},
+      {0xf4a642e14c6262c8ULL, 0xcd27bb612758c0fbULL},
+      {0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789dULL},
+      {0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c4ULL},
+      {0xeeea5d5004981478ULL, 0x1858ccfce06cac75ULL},
+      {0x95527a5202df0ccbULL, 0x0f37801e0c43ebc9ULL},
+      {0xbaa718e68396cffdULL, 0xd30560258f54e6bbULL},
+      {0xe950df20247c83fdULL, 0x47c6b82ef32a206aULL},
+      {0x91d28b7416cdd27eULL, 0x4cdc331d57fa5442ULL},
+      {0xb6472e511c81471dULL, 0xe0133fe4adf8e953ULL},
+      {0xe3d8f9e563a198e5ULL, 0x58180fddd97723a7ULL},
+      {0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7649ULL},
+      {0xb201833b35d63f73ULL, 0x2cd2cc6551e513dbULL},
+      {0xde81e40a034bcf4fULL, 0xf8077f7ea65e58d2ULL},
+      {0x8b112e86420f6191ULL, 0xfb04afaf27faf783ULL},
+      {0xadd57a27d29339f6ULL, 0x79c5db9af1f9b564ULL},
+      {0xd94ad8b1c7380874ULL, 0x18375281ae7822bdULL},
+      {0x87cec76f1c830548ULL, 0x8f2293910d0b15b6ULL},
+      {0xa9c2794ae3a3c69aULL, 0xb2eb3875504ddb23ULL},
+      {0xd433179d9c8cb841ULL, 0x5fa60692a46151ecULL},
+      {0x849feec281d7f328ULL, 0xdbc7c41ba6bcd334ULL},
+      {0xa5c7ea73224deff3ULL, 0x12b9b522906c0801ULL},
+      {0xcf39e50feae16befULL, 0xd768226b34870a01ULL},
+      {0x81842f29f2cce375ULL, 0xe6a1158300d46641ULL},
+      {0xa1e53af46f801c53ULL, 0x60495ae3c1097fd1ULL},
+      {0xca5e89b18b602368ULL, 0x385bb19cb14bdfc5ULL},
+      {0xfcf62c1dee382c42ULL, 0x46729e03dd9ed7b6ULL},
+      {0x9e19db92b4e31ba9ULL, 0x6c07a2c26a8346d2ULL},
+  };
 
-  bool _mytoml_is_hex_digit(char c)
-  {
-    return ((c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f'));
-  }
+  // "00" to "99", for writing two digits at a time
+  static const char _mytoml_digit_pairs[] =
+      "0001020304050607080910111213141516171819"
+      "2021222324252627282930313233343536373839"
+      "4041424344454647484950515253545556575859"
+      "6061626364656667686970717273747576777879"
+      "8081828384858687888990919293949596979899";
 
-  bool _mytoml_is_number_start(char c)
+  static uint64_t _mytoml_float_round_to_odd(const uint64_t *g, uint64_t cp)
   {
-    return ((c == '+' || c == '-') || _mytoml_is_digit(c));
+    uint64_t xhi, xlo, yhi, ylo;
+    _mytoml_float_mul128(g[1], cp, &xhi, &xlo);
+    _mytoml_float_mul128(g[0], cp, &yhi, &ylo);
+    ylo += xhi;
+    yhi += ylo < xhi;
+    return yhi | (ylo > 1);
   }
 
-  bool _mytoml_is_bare_ascii(char c)
+  void _mytoml_float_to_decimal(double f, uint64_t *digits, int *exp)
   {
-    return ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
-            (c == '_' || c == '-') || _mytoml_is_digit(c));
+    uint64_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    uint64_t m = bits & (((uint64_t)1 << 52) - 1);
+    int e = (int)(bits >> 52 & 0x7FF);
+    // f is c * 2^q
+    uint64_t c = e ? m | (uint64_t)1 << 52 : m;
+    int q = e ? e - 1075 : -1074;
+    bool even = (c & 1) == 0;
+    // at a power of two the double below is half as far as the one above
+    bool closer = m == 0 && e > 1;
+    uint64_t cbl = 4 * c - 2 + closer;
+    uint64_t cb = 4 * c;
+    uint64_t cbr = 4 * c + 2;
+    // k = floor(log10(2^q)), or of 3/4 * 2^q when the lower gap is closer
+    int k = (q * 1262611 - (closer ? 524031 : 0)) >> 22;
+    int h = q + ((-k * 1741647) >> 19) + 1;
+    const uint64_t *g =
+        _mytoml_float_format_pow10_table[-k - MYTOML_FLOAT_FORMAT_MIN_POW10];
+    uint64_t vbl = _mytoml_float_round_to_odd(g, cbl << h);
+    uint64_t vb = _mytoml_float_round_to_odd(g, cb << h);
+    uint64_t vbr = _mytoml_float_round_to_odd(g, cbr << h);
+    // the interval that reads back as f, its bounds included when c is even
+    uint64_t lower = vbl + !even;
+    uint64_t upper = vbr - !even;
+    uint64_t s = vb / 4;
+    uint64_t d = 0;
+    bool found = false;
+    if (s >= 10)
+    {
+      // one digit less, if only one of its neighbours is inside
+      uint64_t sp = s / 10;
+      bool up_inside = lower <= 40 * sp;
+      bool wp_inside = 40 * sp + 40 <= upper;
+      if (up_inside != wp_inside)
+      {
+        d = sp + wp_inside;
+        k++;
+        found = true;
+      }
+    }
+    if (!found)
+    {
+      bool u_inside = lower <= 4 * s;
+      bool w_inside = 4 * s + 4 <= upper;
+      if (u_inside != w_inside)
+      {
+        d = s + w_inside;
+      }
+      else
+      {
+        // both or neither are inside, take the closest, ties to even
+        uint64_t mid = 4 * s + 2;
+        d = s + (vb > mid || (vb == mid && (s & 1)));
+      }
+    }
+    while (d % 10 == 0)
+    {
+      d /= 10;
+      k++;
+    }
+    *digits = d;
+    *exp = k;
   }
 
-  bool _mytoml_is_control(char c)
+  static size_t _mytoml_format_uint(uint64_t v, char *out)
   {
-    return ((c >= 0x0 && c <= 0x8) || (c >= 0xA && c <= 0x1F) || (c == 0x7F));
+    char tmp[20];
+    char *p = tmp + sizeof(tmp);
+    while (v >= 100)
+    {
+      p -= 2;
+      memcpy(p, _mytoml_digit_pairs + 2 * (v % 100), 2);
+      v /= 100;
+    }
+    if (v >= 10)
+    {
+      p -= 2;
+      memcpy(p, _mytoml_digit_pairs + 2 * v, 2);
+    }
+    else
+    {
+      *--p = (char)('0' + v);
+    }
+    size_t len = (size_t)(tmp + sizeof(tmp) - p);
+    memcpy(out, p, len);
+    return len;
   }
 
-  bool _mytoml_is_control_multi(char c)
+  size_t _mytoml_format_int(int64_t i, char *out)
   {
-    return ((c >= 0x0 && c <= 0x8) || (c == 0xB || c == 0xC) ||
-            (c >= 0xE && c <= 0x1F) || (c == 0x7F));
+    if (i < 0)
+    {
+      *out = '-';
+      return 1 + _mytoml_format_uint(0 - (uint64_t)i, out + 1);
+    }
+    return _mytoml_format_uint((uint64_t)i, out);
   }
 
-  bool _mytoml_is_control_literal(char c)
+  static inline char *_mytoml_format_two_digits(char *p, int v)
   {
-    return (((c != 0x9) && (c != 0xA) && (c >= 0x0 && c <= 0x1F)) || (c == 0x7F));
+    memcpy(p, _mytoml_digit_pairs + 2 * v, 2);
+    return p + 2;
   }
 
-  bool _mytoml_is_number_end(char c, const char *end)
+  size_t _mytoml_format_datetime(const TomlDatetime *dt, char *out)
   {
-    for (size_t i = 0; i < strlen(end); i++)
+    char *p = out;
+    if (dt->flags & MYTOML_DATETIME_DATE)
     {
-      if (c == end[i])
-        return true;
+      int year, month, day;
+      _mytoml_datetime_civil(dt->days, &year, &month, &day);
+      p = _mytoml_format_two_digits(p, year / 100);
+      p = _mytoml_format_two_digits(p, year % 100);
+      *p++ = '-';
+      p = _mytoml_format_two_digits(p, month);
+      *p++ = '-';
+      p = _mytoml_format_two_digits(p, day);
+      if (dt->flags & MYTOML_DATETIME_TIME)
+        *p++ = 'T';
     }
-    return false;
-  }
-
-  bool _mytoml_is_decimal_point(char c) { return (c == '.'); }
-
-  bool _mytoml_is_underscore(char c) { return (c == '_'); }
-
-  bool _mytoml_is_array_start(char c) { return (c == '['); }
-
-  bool _mytoml_is_array_end(char c) { return (c == ']'); }
-
-  bool _mytoml_is_array_seperator(char c) { return (c == ','); }
-
-  bool _mytoml_is_date(int year, int month, int day)
-  {
-    switch (month)
+    if (dt->flags & MYTOML_DATETIME_TIME)
     {
-    case 0: // January
-      return (day >= 1 && day <= 31);
-    case 1: // February
-      return (
-          (day >= 1 && day <= 28) ||
-          (day == 29 && year % 4 == 0 && year % 100 != 0) ||
-          (day == 29 && year % 4 == 0 && year % 100 == 0 && year % 400 == 0));
-    case 2: // March
-      return (day >= 1 && day <= 31);
-    case 3: // April
-      return (day >= 1 && day <= 30);
-    case 4: // May
-      return (day >= 1 && day <= 31);
-    case 5: // June
-      return (day >= 1 && day <= 30);
-    case 6: // July
-      return (day >= 1 && day <= 31);
-    case 7: // August
-      return (day >= 1 && day <= 31);
-    case 8: // September
-      return (day >= 1 && day <= 30);
-    case 9: // October
-      return (day >= 1 && day <= 31);
-    case 10: // November
-      return (day >= 1 && day <= 30);
-    case 11: // December
-      return (day >= 1 && day <= 31);
-    default:
-      return false;
+      int64_t seconds = dt->nanos / 1000000000;
+      p = _mytoml_format_two_digits(p, (int)(seconds / 3600));
+      *p++ = ':';
+      p = _mytoml_format_two_digits(p, (int)(seconds / 60 % 60));
+      *p++ = ':';
+      p = _mytoml_format_two_digits(p, (int)(seconds % 60));
+      if (dt->digits)
+      {
+        // the nine digits of the nanoseconds, cut to those written
+        char frac[9];
+        uint32_t ns = (uint32_t)(dt->nanos % 1000000000);
+        for (int i = 8; i >= 0; i--, ns /= 10)
+          frac[i] = (char)('0' + ns % 10);
+        *p++ = '.';
+        memcpy(p, frac, dt->digits);
+        p += dt->digits;
+      }
     }
-    return false;
+    if (dt->flags & MYTOML_DATETIME_ZULU)
+    {
+      *p++ = 'Z';
+    }
+    else if (dt->flags & MYTOML_DATETIME_OFFSET)
+    {
+      int offset = dt->offset;
+      *p++ = offset < 0 ? '-' : '+';
+      if (offset < 0)
+        offset = -offset;
+      p = _mytoml_format_two_digits(p, offset / 60);
+      *p++ = ':';
+      p = _mytoml_format_two_digits(p, offset % 60);
+    }
+    return (size_t)(p - out);
   }
 
-  bool _mytoml_is_valid_datetime(struct tm *datetime)
+  size_t _mytoml_format_float(double f, bool scientific, char *out)
   {
-    return ((datetime->tm_hour >= 0 && datetime->tm_hour <= 23) &&
-            (datetime->tm_min >= 0 && datetime->tm_min <= 59) &&
-            (datetime->tm_sec >= 0 && datetime->tm_sec <= 59) &&
-            _mytoml_is_date(datetime->tm_year + 1900, datetime->tm_mon,
-                            datetime->tm_mday));
+    char *p = out;
+    if (isnan(f))
+    {
+      memcpy(p, "nan", 3);
+      return 3;
+    }
+    if (signbit(f))
+      *p++ = '-';
+    if (isinf(f))
+    {
+      memcpy(p, "inf", 3);
+      return (size_t)(p + 3 - out);
+    }
+    if (f == 0)
+    {
+      memcpy(p, "0.0", 3);
+      return (size_t)(p + 3 - out);
+    }
+    uint64_t digits;
+    int exp;
+    _mytoml_float_to_decimal(f, &digits, &exp);
+    char d[20];
+    int n = (int)_mytoml_format_uint(digits, d);
+    // digits before the point
+    int point = n + exp;
+    if (!scientific && point >= -5 && point <= 21)
+    {
+      if (point <= 0)
+      {
+        memcpy(p, "0.", 2);
+        memset(p + 2, '0', (size_t)-point);
+        p += 2 - point;
+        memcpy(p, d, (size_t)n);
+        p += n;
+      }
+      else if (point < n)
+      {
+        memcpy(p, d, (size_t)point);
+        p[point] = '.';
+        memcpy(p + point + 1, d + point, (size_t)(n - point));
+        p += n + 1;
+      }
+      else
+      {
+        memcpy(p, d, (size_t)n);
+        memset(p + n, '0', (size_t)(point - n));
+        p += point;
+        memcpy(p, ".0", 2);
+        p += 2;
+      }
+    }
+    else
+    {
+      *p++ = d[0];
+      if (n > 1)
+      {
+        *p++ = '.';
+        memcpy(p, d + 1, (size_t)(n - 1));
+        p += n - 1;
+      }
+      *p++ = 'e';
+      p += _mytoml_format_int(point - 1, p);
+    }
+    return (size_t)(p - out);
   }
 
   //-----------------------------------------------------------------------------
@@ -1211,80 +5509,55 @@ extern "C"
   TomlKey *_mytoml_parser_bare_key(Tokenizer *tok, char end, TomlKeyType branch,
                                    TomlKeyType leaf)
   {
-    char id[MYTOML_MAX_ID_LENGTH] = {0};
-    int idx = 0;
-    bool done = false;
-
-    while (_mytoml_tokenizer_has_token(tok))
+    Token t;
+    if (_mytoml_lexer_next(tok, &t) != T_BARE)
     {
-      RETURN_IF_FAILED(idx < MYTOML_MAX_ID_LENGTH, "buffer overflow\n");
-      if (_mytoml_is_dot(_mytoml_tokenizer_get_token(tok)))
-      {
-        RETURN_IF_FAILED(idx != 0, "key cannot be empty\n");
-        TomlKey *subkey = _mytoml_value_new_key(branch);
-        memcpy(subkey->id, id, strlen(id));
-        return subkey;
-      }
-      else if (_mytoml_tokenizer_get_token(tok) == end)
+      if (_mytoml_is_dot(_mytoml_tokenizer_get_token(tok)) ||
+          _mytoml_tokenizer_get_token(tok) == end)
       {
-        RETURN_IF_FAILED(idx != 0, "key cannot be empty\n");
-        TomlKey *subkey = _mytoml_value_new_key(leaf);
-        memcpy(subkey->id, id, strlen(id));
-        return subkey;
-      }
-      else if (_mytoml_is_whitesapce(_mytoml_tokenizer_get_token(tok)))
-      {
-        // bare keys cannot contain whitespace inside each
-        // key, so we use the `done` variable to track it
-        done = true;
-        _mytoml_parser_parse_whitespace(tok);
-      }
-      else if (_mytoml_is_bare_ascii(_mytoml_tokenizer_get_token(tok)) &&
-               !done)
-      {
-        id[idx++] = _mytoml_tokenizer_get_token(tok);
-        _mytoml_tokenizer_next_token(tok);
+        LOG_ERR("key cannot be empty\n");
       }
       else
       {
         LOG_ERR("unknown character %c\n", _mytoml_tokenizer_get_token(tok));
-        break;
       }
+      return NULL;
     }
-    return NULL;
+    TomlId id =
+        _mytoml_parser_intern_id(tok, _mytoml_lexer_text(tok, &t), t.len);
+    RETURN_IF_FAILED(id.str, "failed to allocate key\n");
+    _mytoml_tokenizer_advance(tok, t.len);
+    // bare keys cannot contain whitespace, so the key has to
+    // end at the next non-whitespace character
+    return _mytoml_parser_key_end(tok, id, end, branch, leaf);
   }
 
   TomlKey *_mytoml_parser_basic_quoted_key(Tokenizer *tok, char end,
                                            TomlKeyType branch, TomlKeyType leaf)
   {
-    char id[MYTOML_MAX_ID_LENGTH] = {0};
-    int idx = 0;
+    TomlId id = {"", 0, 0};
+    size_t cap = 0;
+
+    // keys without escapes are copied straight from the input
+    Token t;
+    if (_mytoml_lexer_next(tok, &t) == T_BASIC_STRING)
+    {
+      id = _mytoml_parser_intern_id(tok, _mytoml_lexer_text(tok, &t) + 1,
+                                    t.len - 2);
+      RETURN_IF_FAILED(id.str, "failed to allocate key\n");
+      _mytoml_tokenizer_advance(tok, t.len);
+      return _mytoml_parser_key_end(tok, id, end, branch, leaf);
+    }
+    _mytoml_tokenizer_next_token(tok);
 
     while (_mytoml_tokenizer_has_token(tok))
     {
-      RETURN_IF_FAILED(idx < MYTOML_MAX_ID_LENGTH, "buffer overflow\n");
       if (_mytoml_is_basic_string_start(_mytoml_tokenizer_get_token(tok)))
       {
         _mytoml_tokenizer_next_token(tok);
-        if (_mytoml_is_whitesapce(_mytoml_tokenizer_get_token(tok)))
-        {
-          _mytoml_parser_parse_whitespace(tok);
-        }
-        if (_mytoml_is_dot(_mytoml_tokenizer_get_token(tok)))
-        {
-          TomlKey *subkey = _mytoml_value_new_key(branch);
-          memcpy(subkey->id, id, strlen(id));
-          return subkey;
-        }
-        else if (_mytoml_tokenizer_get_token(tok) == end)
-        {
-          TomlKey *subkey = _mytoml_value_new_key(leaf);
-          memcpy(subkey->id, id, strlen(id));
-          return subkey;
-        }
-        LOG_ERR("unknown character %c after end of key\n",
-                _mytoml_tokenizer_get_token(tok));
-        break;
+        id = _mytoml_parser_intern_id(tok, id.str, id.len);
+        RETURN_IF_FAILED(id.str, "failed to allocate key\n");
+        return _mytoml_parser_key_end(tok, id, end, branch, leaf);
       }
       else if (_mytoml_is_newline(_mytoml_tokenizer_get_token(tok)))
       {
@@ -1299,15 +5572,10 @@ extern "C"
         RETURN_IF_FAILED(c != 0, "unknown escape sequence \\%c\n",
                          _mytoml_tokenizer_get_token(tok));
         RETURN_IF_FAILED(c < 5, "parsed escape sequence is too long\n");
-        for (int i = 0; i < c; i++)
-        {
-          id[idx++] = escaped[i];
-          RETURN_IF_FAILED(idx < MYTOML_MAX_ID_LENGTH, "buffer overflow\n");
-        }
-        // _mytoml_parser_parse_escape will parse everything and move on to the
-        // next token so we call _mytoml_tokenizer_backtrace here to offset the
-        // _mytoml_tokenizer_next_token call outside
-        _mytoml_tokenizer_backtrace(tok, 1);
+        bool ok = _mytoml_value_id_append(&id, &cap, escaped, c);
+        RETURN_IF_FAILED(ok, "failed to allocate key\n");
+        // _mytoml_parser_parse_escape already moved on to the next token
+        continue;
       }
       else if (_mytoml_is_control(_mytoml_tokenizer_get_token(tok)))
       {
@@ -1316,7 +5584,9 @@ extern "C"
       }
       else
       {
-        id[idx++] = _mytoml_tokenizer_get_token(tok);
+        char c = _mytoml_tokenizer_get_token(tok);
+        bool ok = _mytoml_value_id_append(&id, &cap, &c, 1);
+        RETURN_IF_FAILED(ok, "failed to allocate key\n");
       }
       _mytoml_tokenizer_next_token(tok);
     }
@@ -1327,34 +5597,29 @@ extern "C"
                                              TomlKeyType branch,
                                              TomlKeyType leaf)
   {
-    char id[MYTOML_MAX_ID_LENGTH] = {0};
-    int idx = 0;
+    TomlId id = {"", 0, 0};
+    size_t cap = 0;
+
+    // keys without escapes are copied straight from the input
+    Token t;
+    if (_mytoml_lexer_next(tok, &t) == T_LITERAL_STRING)
+    {
+      id = _mytoml_parser_intern_id(tok, _mytoml_lexer_text(tok, &t) + 1,
+                                    t.len - 2);
+      RETURN_IF_FAILED(id.str, "failed to allocate key\n");
+      _mytoml_tokenizer_advance(tok, t.len);
+      return _mytoml_parser_key_end(tok, id, end, branch, leaf);
+    }
+    _mytoml_tokenizer_next_token(tok);
 
     while (_mytoml_tokenizer_has_token(tok))
     {
-      RETURN_IF_FAILED(idx < MYTOML_MAX_ID_LENGTH, "buffer overflow\n");
       if (_mytoml_is_literal_string_start(_mytoml_tokenizer_get_token(tok)))
       {
         _mytoml_tokenizer_next_token(tok);
-        if (_mytoml_is_whitesapce(_mytoml_tokenizer_get_token(tok)))
-        {
-          _mytoml_parser_parse_whitespace(tok);
-        }
-        if (_mytoml_is_dot(_mytoml_tokenizer_get_token(tok)))
-        {
-          TomlKey *subkey = _mytoml_value_new_key(branch);
-          memcpy(subkey->id, id, strlen(id));
-          return subkey;
-        }
-        else if (_mytoml_tokenizer_get_token(tok) == end)
-        {
-          TomlKey *subkey = _mytoml_value_new_key(leaf);
-          memcpy(subkey->id, id, strlen(id));
-          return subkey;
-        }
-        LOG_ERR("unknown character %c after end of key\n",
-                _mytoml_tokenizer_get_token(tok));
-        break;
+        id = _mytoml_parser_intern_id(tok, id.str, id.len);
+        RETURN_IF_FAILED(id.str, "failed to allocate key\n");
+        return _mytoml_parser_key_end(tok, id, end, branch, leaf);
       }
       else if (_mytoml_is_newline(_mytoml_tokenizer_get_token(tok)))
       {
@@ -1368,13 +5633,72 @@ extern "C"
       }
       else
       {
-        id[idx++] = _mytoml_tokenizer_get_token(tok);
+        char c = _mytoml_tokenizer_get_token(tok);
+        bool ok = _mytoml_value_id_append(&id, &cap, &c, 1);
+        RETURN_IF_FAILED(ok, "failed to allocate key\n");
       }
       _mytoml_tokenizer_next_token(tok);
     }
     return NULL;
   }
 
+  TomlKey *_mytoml_parser_key_end(Tokenizer *tok, TomlId id, char end,
+                                  TomlKeyType branch, TomlKeyType leaf)
+  {
+    _mytoml_parser_parse_whitespace(tok);
+    TomlKeyType type;
+    if (_mytoml_is_dot(_mytoml_tokenizer_get_token(tok)))
+    {
+      type = branch;
+    }
+    else if (_mytoml_tokenizer_get_token(tok) == end)
+    {
+      type = leaf;
+    }
+    else
+    {
+      LOG_ERR("unknown character %c after end of key\n",
+              _mytoml_tokenizer_get_token(tok));
+      return NULL;
+    }
+    TomlKey *subkey = _mytoml_value_new_key(type);
+    RETURN_IF_FAILED(subkey, "failed to allocate key\n");
+    subkey->id = id;
+    return subkey;
+  }
+
+  TomlId _mytoml_parser_intern_id(Tokenizer *tok, const char *s, size_t len)
+  {
+    TomlId probe = {s, (khint32_t)len, _mytoml_id_hash_bytes(s, len)};
+    khiter_t k = kh_get(atom, tok->atoms, probe);
+    if (k != kh_end(tok->atoms))
+    {
+      return kh_key(tok->atoms, k);
+    }
+    TomlId id = _mytoml_value_new_id(s, len);
+    if (!id.str)
+    {
+      return id;
+    }
+    // the pool only lives as long as the parse, so keep its
+    // buckets on the C heap rather than in the document arena
+    TomlArena *arena = _mytoml_arena_current;
+    _mytoml_arena_current = NULL;
+    int ret;
+    kh_put(atom, tok->atoms, id, &ret);
+    _mytoml_arena_current = arena;
+    if (ret < 0)
+    {
+      id.str = NULL;
+    }
+    else if (arena)
+    {
+      arena->ids++;
+      arena->id_bytes += MYTOML_ARENA_ROUND(len + 1);
+    }
+    return id;
+  }
+
   TomlKey *_mytoml_parser_parse_key(Tokenizer *tok, TomlKey *key,
                                     bool expecting)
   {
@@ -1399,23 +5723,21 @@ extern "C"
       else if (_mytoml_is_basic_string_start(
                    _mytoml_tokenizer_get_token(tok)))
       {
-        _mytoml_tokenizer_next_token(tok);
         TomlKey *subkey =
             _mytoml_parser_basic_quoted_key(tok, '=', TOML_KEY, TOML_KEYLEAF);
         RETURN_IF_FAILED(subkey, "failed to parse basic quoted key\n");
         subkey = _mytoml_value_add_sub_key(key, subkey);
-        RETURN_IF_FAILED(subkey, "failed to add subkey to key %s\n", key->id);
+        RETURN_IF_FAILED(subkey, "failed to add subkey to key %s\n", key->id.str);
         return _mytoml_parser_parse_key(tok, subkey, false);
       }
       else if (_mytoml_is_literal_string_start(
                    _mytoml_tokenizer_get_token(tok)))
       {
-        _mytoml_tokenizer_next_token(tok);
         TomlKey *subkey =
             _mytoml_parser_literal_quoted_key(tok, '=', TOML_KEY, TOML_KEYLEAF);
         RETURN_IF_FAILED(subkey, "failed to parse literal quoted key\n");
         subkey = _mytoml_value_add_sub_key(key, subkey);
-        RETURN_IF_FAILED(subkey, "failed to add subkey to key %s\n", key->id);
+        RETURN_IF_FAILED(subkey, "failed to add subkey to key %s\n", key->id.str);
         return _mytoml_parser_parse_key(tok, subkey, false);
       }
       else
@@ -1424,7 +5746,7 @@ extern "C"
             _mytoml_parser_bare_key(tok, '=', TOML_KEY, TOML_KEYLEAF);
         RETURN_IF_FAILED(subkey, "failed to parse bare key\n");
         subkey = _mytoml_value_add_sub_key(key, subkey);
-        RETURN_IF_FAILED(subkey, "failed to add subkey to key %s\n", key->id);
+        RETURN_IF_FAILED(subkey, "failed to add subkey to key %s\n", key->id.str);
         return _mytoml_parser_parse_key(tok, subkey, false);
       }
     }
@@ -1455,23 +5777,21 @@ extern "C"
       else if (_mytoml_is_basic_string_start(
                    _mytoml_tokenizer_get_token(tok)))
       {
-        _mytoml_tokenizer_next_token(tok);
         TomlKey *subkey =
             _mytoml_parser_basic_quoted_key(tok, ']', TOML_TABLE, TOML_TABLELEAF);
         RETURN_IF_FAILED(subkey, "failed to parse basic quoted key\n");
         subkey = _mytoml_value_add_sub_key(key, subkey);
-        RETURN_IF_FAILED(subkey, "failed to add key to subkey %s\n", key->id);
+        RETURN_IF_FAILED(subkey, "failed to add key to subkey %s\n", key->id.str);
         return _mytoml_parser_parse_table(tok, subkey, false);
       }
       else if (_mytoml_is_literal_string_start(
                    _mytoml_tokenizer_get_token(tok)))
       {
-        _mytoml_tokenizer_next_token(tok);
         TomlKey *subkey = _mytoml_parser_literal_quoted_key(tok, ']', TOML_TABLE,
                                                             TOML_TABLELEAF);
         RETURN_IF_FAILED(subkey, "failed to parse literal quoted key\n");
         subkey = _mytoml_value_add_sub_key(key, subkey);
-        RETURN_IF_FAILED(subkey, "failed to add key to subkey %s\n", key->id);
+        RETURN_IF_FAILED(subkey, "failed to add key to subkey %s\n", key->id.str);
         return _mytoml_parser_parse_table(tok, subkey, false);
       }
       else
@@ -1480,7 +5800,7 @@ extern "C"
             _mytoml_parser_bare_key(tok, ']', TOML_TABLE, TOML_TABLELEAF);
         RETURN_IF_FAILED(subkey, "failed to parse bare key\n");
         subkey = _mytoml_value_add_sub_key(key, subkey);
-        RETURN_IF_FAILED(subkey, "failed to add key to subkey %s\n", key->id);
+        RETURN_IF_FAILED(subkey, "failed to add key to subkey %s\n", key->id.str);
         return _mytoml_parser_parse_table(tok, subkey, false);
       }
     }
@@ -1514,23 +5834,21 @@ extern "C"
       else if (_mytoml_is_basic_string_start(
                    _mytoml_tokenizer_get_token(tok)))
       {
-        _mytoml_tokenizer_next_token(tok);
         TomlKey *subkey = _mytoml_parser_basic_quoted_key(tok, ']', TOML_TABLE,
                                                           TOML_ARRAYTABLE);
         RETURN_IF_FAILED(subkey, "failed to parse basic quoted key\n");
         subkey = _mytoml_value_add_sub_key(key, subkey);
-        RETURN_IF_FAILED(subkey, "failed to add key to subkey %s\n", key->id);
+        RETURN_IF_FAILED(subkey, "failed to add key to subkey %s\n", key->id.str);
         return _mytoml_parser_parse_array_table(tok, subkey, false);
       }
       else if (_mytoml_is_literal_string_start(
                    _mytoml_tokenizer_get_token(tok)))
       {
-        _mytoml_tokenizer_next_token(tok);
         TomlKey *subkey = _mytoml_parser_literal_quoted_key(tok, ']', TOML_TABLE,
                                                             TOML_ARRAYTABLE);
         RETURN_IF_FAILED(subkey, "failed to parse literal quoted key\n");
         subkey = _mytoml_value_add_sub_key(key, subkey);
-        RETURN_IF_FAILED(subkey, "failed to add key to subkey %s\n", key->id);
+        RETURN_IF_FAILED(subkey, "failed to add key to subkey %s\n", key->id.str);
         return _mytoml_parser_parse_array_table(tok, subkey, false);
       }
       else
@@ -1539,7 +5857,7 @@ extern "C"
             _mytoml_parser_bare_key(tok, ']', TOML_TABLE, TOML_ARRAYTABLE);
         RETURN_IF_FAILED(subkey, "failed to parse bare key\n");
         subkey = _mytoml_value_add_sub_key(key, subkey);
-        RETURN_IF_FAILED(subkey, "failed to add key to subkey %s\n", key->id);
+        RETURN_IF_FAILED(subkey, "failed to add key to subkey %s\n", key->id.str);
         return _mytoml_parser_parse_array_table(tok, subkey, false);
       }
     }
@@ -1549,23 +5867,39 @@ extern "C"
   TomlKey *_mytoml_parser_parse_key_value(Tokenizer *tok, TomlKey *key,
                                           TomlKey *root)
   {
-    if (_mytoml_is_comment_start(_mytoml_tokenizer_get_token(tok)))
+    // a key may only follow whitespace that we skipped right
+    // before, at the beginning of a line
+    bool indented = tok->newline;
+    tok->newline = false;
+    // one table lookup picks the statement, anything without a
+    // case of its own can only start a key
+    switch (_mytoml_char_class(_mytoml_tokenizer_get_token(tok)))
+    {
+    case C_COMMENT:
     {
       bool ok = _mytoml_parser_parse_comment(tok);
       RETURN_IF_FAILED(ok, "invalid comment\n");
       return key;
     }
-    else if (_mytoml_is_whitesapce(_mytoml_tokenizer_get_token(tok)))
+    case C_BLANK:
     {
+      tok->newline =
+          _mytoml_tokenizer_get_previous_token(tok) == '\0' ||
+          _mytoml_is_newline(_mytoml_tokenizer_get_previous_token(tok));
       _mytoml_parser_parse_whitespace(tok);
       return key;
     }
-    else if (_mytoml_parser_parse_newline(tok))
+    case C_RETURN:
+    case C_NEWLINE:
     {
+      if (!_mytoml_parser_parse_newline(tok))
+      {
+        break;
+      }
       _mytoml_tokenizer_next_token(tok);
       return key;
     }
-    else if (_mytoml_is_table_start(_mytoml_tokenizer_get_token(tok)))
+    case C_BRACKET:
     {
       _mytoml_tokenizer_next_token(tok);
       TomlKey *table;
@@ -1579,15 +5913,17 @@ extern "C"
         // store it in the `value->arr` attribute of the `key`.
         // Each redefinition marks an new element in that array.
         // The key-value pairs are added to the `subkeys` of a
-        // "pseudo" key that lives at `table->value->arr[ table->idx ].
+        // "pseudo" key that is the last element of `table->value->arr`.
         if (table->value == NULL)
         {
           table->value = _mytoml_value_new_array();
+          RETURN_IF_FAILED(table->value, "failed to add array of tables\n");
         }
-        RETURN_IF_FAILED(table->idx < MYTOML_MAX_ARRAY_LENGTH - 1,
-                         "buffer overflow\n");
-        table->value->arr[++(table->idx)] =
+        TomlValue *element =
             _mytoml_value_new_table(_mytoml_value_new_key(TOML_TABLE));
+        RETURN_IF_FAILED(element, "failed to add array table element\n");
+        bool ok = _mytoml_value_array_push(table->value, element);
+        RETURN_IF_FAILED(ok, "failed to add array table element\n");
       }
       else
       {
@@ -1596,17 +5932,20 @@ extern "C"
       }
       return table;
     }
-    else if (_mytoml_tokenizer_get_previous_token(tok) == '\0' ||
-             _mytoml_is_newline(_mytoml_tokenizer_get_previous_token(tok)) ||
-             // ignore white space found at the beginning of
-             // a line while parsing a key
-             (_mytoml_is_whitesapce(
-                  _mytoml_tokenizer_get_previous_token(tok)) &&
-              tok->newline))
+    default:
+      break;
+    }
+
+    if (_mytoml_tokenizer_get_previous_token(tok) == '\0' ||
+        _mytoml_is_newline(_mytoml_tokenizer_get_previous_token(tok)) ||
+        // ignore white space found at the beginning of
+        // a line while parsing a key
+        (_mytoml_is_whitesapce(_mytoml_tokenizer_get_previous_token(tok)) &&
+         indented))
     {
       TomlKey *subkey = _mytoml_parser_parse_key(tok, key, true);
       RETURN_IF_FAILED(subkey, "failed to parse key\n");
-      TomlValue *v = _mytoml_parser_parse_value(tok, "# \n");
+      TomlValue *v = _mytoml_parser_parse_value(tok, "# \r\n");
       RETURN_IF_FAILED(v, "failed to parse value\n");
       // If we parsed an inlinetable, to keep it in sync
       // with our datastructure, we add the keys from the
@@ -1618,17 +5957,14 @@ extern "C"
       // `KEYLEAF` to prevent re-definition.
       if (v->type == TOML_INLINETABLE)
       {
-        TomlKey *h = (TomlKey *)(v->data);
+        TomlKey *h = v->table;
         subkey->type = TOML_KEY;
-        for (khiter_t ki = kh_begin(h->subkeys); ki != kh_end(h->subkeys); ++ki)
+        size_t it = 0;
+        for (TomlKey *sub; (sub = toml_key_next(h, &it));)
         {
-          if (kh_exist(h->subkeys, ki))
-          {
-            TomlKey *e =
-                _mytoml_value_add_sub_key(subkey, kh_value(h->subkeys, ki));
-            RETURN_IF_FAILED(e, "could not add inline table key %s\n",
-                             kh_value(h->subkeys, ki)->id);
-          }
+          TomlKey *e = _mytoml_value_add_sub_key(subkey, sub);
+          RETURN_IF_FAILED(e, "could not add inline table key %s\n",
+                           sub->id.str);
         }
         subkey->type = TOML_KEYLEAF;
       }
@@ -1644,52 +5980,127 @@ extern "C"
     return NULL;
   }
 
+  TomlKey *_mytoml_parser_parse_input(Input input, const TomlOptions *options,
+                                      const char *name)
+  {
+    TomlOptions defaults = toml_options_default();
+    if (options == NULL)
+    {
+      options = &defaults;
+    }
+    input.limit = options->max_input_size;
+
+    // the parse, and the document it returns, allocate through
+    // the allocator picked here
+    const TomlAllocator *outer = _mytoml_allocator_current;
+    _mytoml_allocator_current =
+        options->allocator ? options->allocator : &_mytoml_allocator_global;
+    TomlKey *root = _mytoml_parser_parse_document(input, name);
+    _mytoml_allocator_current = outer;
+    return root;
+  }
+
+  TomlKey *_mytoml_parser_parse_document(Input input, const char *name)
+  {
+    Tokenizer *tok = _mytoml_new_tokenizer(input);
+    RETURN_IF_FAILED(tok, "Failed to allocate memory for %s\n", name);
+    bool ok = _mytoml_tokenizer_load_input(tok);
+    FUNC_IF_FAILED(ok, _mytoml_tokenizer_delete, tok);
+    RETURN_IF_FAILED(ok, "Failed to load input from %s\n", name);
+    _mytoml_tokenizer_next_token(tok);
+
+    TomlArena *arena = _mytoml_arena_new(_mytoml_allocator());
+    FUNC_IF_FAILED(arena, _mytoml_tokenizer_delete, tok);
+    RETURN_IF_FAILED(arena, "Failed to allocate memory for %s\n", name);
+    TomlArena *outer = _mytoml_arena_current;
+    _mytoml_arena_current = arena;
+
+    TomlKey *root = _mytoml_value_new_key(TOML_TABLE);
+    if (root)
+    {
+      root->id = _mytoml_parser_intern_id(tok, "root", strlen("root"));
+      root->arena = arena;
+    }
+    ok = root && root->id.str;
+    if (!ok)
+    {
+      _mytoml_arena_current = outer;
+    }
+    FUNC_IF_FAILED(ok, _mytoml_tokenizer_delete, tok);
+    // the root is in the arena, if there is one
+    FUNC_IF_FAILED(ok, _mytoml_arena_delete, arena);
+    RETURN_IF_FAILED(ok, "Failed to allocate memory for %s\n", name);
+
+    int line, col;
+    TomlKey *key = root;
+    while (_mytoml_tokenizer_has_token(tok) != 0)
+    {
+      key = _mytoml_parser_parse_key_value(tok, key, root);
+      if (key == NULL)
+      {
+        _mytoml_arena_current = outer;
+        _mytoml_tokenizer_position(tok, tok->cursor - 1, &line, &col);
+      }
+      FUNC_IF_FAILED(key, _mytoml_tokenizer_delete, tok);
+      FUNC_IF_FAILED(key, toml_free, root);
+      RETURN_IF_FAILED(key,
+                       "Encountered an error while parsing %s\n"
+                       "At line %d column %d\n",
+                       name, line + 1, col);
+    }
+
+    _mytoml_arena_current = outer;
+    bool failed = tok->input.failed;
+    _mytoml_tokenizer_delete(tok);
+    FUNC_IF_FAILED(!failed, toml_free, root);
+    RETURN_IF_FAILED(!failed, "Failed to read input from %s\n", name);
+    return root;
+  }
+
   //-----------------------------------------------------------------------------
   // [SECTION] Myjson Parser Value
   //-----------------------------------------------------------------------------
 
-  char *_mytoml_parser_parse_basic_string(Tokenizer *tok, char *value,
+  char *_mytoml_parser_parse_basic_string(Tokenizer *tok, size_t *len,
                                           bool multi)
   {
-    int idx = 0;
+    size_t idx = 0;
+    char *value;
     while (_mytoml_tokenizer_has_token(tok))
     {
-      RETURN_IF_FAILED(idx < MYTOML_MAX_STRING_LENGTH, "buffer overflow\n");
+      // room for the longest write of one step, an escape
+      value = _mytoml_tokenizer_scratch(tok, idx + 4);
+      RETURN_IF_FAILED(value, "could not grow string\n");
       if (_mytoml_is_basic_string_start(_mytoml_tokenizer_get_token(tok)))
       {
         if (!multi)
         {
           _mytoml_tokenizer_next_token(tok);
+          value[idx] = '\0';
+          *len = idx;
           return value;
         }
         else
         {
-          int a = _mytoml_tokenizer_next_token(tok);
-          int b = _mytoml_tokenizer_next_token(tok);
-          if (_mytoml_is_basic_string_start(_mytoml_tokenizer_get_token(tok)) &&
-              _mytoml_is_basic_string_start(
-                  _mytoml_tokenizer_get_previous_token(tok)))
+          if (_mytoml_is_basic_string_start(_mytoml_tokenizer_peek(tok, 1)) &&
+              _mytoml_is_basic_string_start(_mytoml_tokenizer_peek(tok, 2)))
           {
-            _mytoml_tokenizer_next_token(tok);
+            _mytoml_tokenizer_advance(tok, 3);
             if (_mytoml_is_basic_string_start(_mytoml_tokenizer_get_token(tok)))
             {
               value[idx++] = '"';
               _mytoml_tokenizer_next_token(tok);
             }
-            RETURN_IF_FAILED(idx < MYTOML_MAX_STRING_LENGTH, "buffer overflow\n");
             if (_mytoml_is_basic_string_start(_mytoml_tokenizer_get_token(tok)))
             {
               value[idx++] = '"';
               _mytoml_tokenizer_next_token(tok);
             }
+            value[idx] = '\0';
+            *len = idx;
             return value;
           }
-          else
-          {
-            value[idx++] = '"';
-            _mytoml_tokenizer_backtrace(tok, a + b - 1);
-            continue;
-          }
+          value[idx++] = '"';
         }
       }
       else if (_mytoml_parser_parse_newline(tok) && !multi)
@@ -1731,12 +6142,9 @@ extern "C"
           for (int i = 0; i < c; i++)
           {
             value[idx++] = escaped[i];
-            RETURN_IF_FAILED(idx < MYTOML_MAX_STRING_LENGTH, "buffer overflow\n");
           }
-          // _mytoml_parser_parse_escape will parse everything and move on to the
-          // next token so we call _mytoml_tokenizer_backtrace here to offset the
-          // _mytoml_tokenizer_next_token call outside
-          _mytoml_tokenizer_backtrace(tok, 1);
+          // _mytoml_parser_parse_escape already moved on to the next token
+          continue;
         }
       }
       else if (!multi && _mytoml_is_control(_mytoml_tokenizer_get_token(tok)))
@@ -1750,6 +6158,20 @@ extern "C"
         LOG_ERR("control characters need to be escaped\n");
         break;
       }
+      else if (_mytoml_is_basic_string_char(_mytoml_tokenizer_get_token(tok)))
+      {
+        // copy the whole run of plain characters at once
+        size_t from = tok->cursor - 1;
+        size_t count =
+            _mytoml_lexer_scan(tok, from, SCAN_BASIC_STRING) - from;
+        value = _mytoml_tokenizer_scratch(tok, idx + count);
+        RETURN_IF_FAILED(value, "could not grow string\n");
+        memcpy(value + idx, tok->input.stream + (from - tok->input.base),
+               count);
+        idx += count;
+        _mytoml_tokenizer_advance(tok, count);
+        continue;
+      }
       else
       {
         value[idx++] = _mytoml_tokenizer_get_token(tok);
@@ -1759,50 +6181,48 @@ extern "C"
     return NULL;
   }
 
-  char *_mytoml_parser_parse_literal_string(Tokenizer *tok, char *value,
+  char *_mytoml_parser_parse_literal_string(Tokenizer *tok, size_t *len,
                                             bool multi)
   {
-    int idx = 0;
+    size_t idx = 0;
+    char *value;
     while (_mytoml_tokenizer_has_token(tok))
     {
-      RETURN_IF_FAILED(idx < MYTOML_MAX_STRING_LENGTH, "buffer overflow\n");
+      // room for the longest write of one step, two closing quotes
+      value = _mytoml_tokenizer_scratch(tok, idx + 2);
+      RETURN_IF_FAILED(value, "could not grow string\n");
       if (_mytoml_is_literal_string_start(_mytoml_tokenizer_get_token(tok)))
       {
         if (!multi)
         {
           _mytoml_tokenizer_next_token(tok);
+          value[idx] = '\0';
+          *len = idx;
           return value;
         }
         else
         {
-          int a = _mytoml_tokenizer_next_token(tok);
-          int b = _mytoml_tokenizer_next_token(tok);
-          if (_mytoml_is_literal_string_start(_mytoml_tokenizer_get_token(tok)) &&
-              _mytoml_is_literal_string_start(
-                  _mytoml_tokenizer_get_previous_token(tok)))
+          if (_mytoml_is_literal_string_start(_mytoml_tokenizer_peek(tok, 1)) &&
+              _mytoml_is_literal_string_start(_mytoml_tokenizer_peek(tok, 2)))
           {
-            _mytoml_tokenizer_next_token(tok);
+            _mytoml_tokenizer_advance(tok, 3);
             if (_mytoml_is_literal_string_start(
                     _mytoml_tokenizer_get_token(tok)))
             {
               value[idx++] = '\'';
               _mytoml_tokenizer_next_token(tok);
             }
-            RETURN_IF_FAILED(idx < MYTOML_MAX_STRING_LENGTH, "buffer overflow\n");
             if (_mytoml_is_literal_string_start(
                     _mytoml_tokenizer_get_token(tok)))
             {
               value[idx++] = '\'';
               _mytoml_tokenizer_next_token(tok);
             }
+            value[idx] = '\0';
+            *len = idx;
             return value;
           }
-          else
-          {
-            value[idx++] = '\'';
-            _mytoml_tokenizer_backtrace(tok, a + b - 1);
-            continue;
-          }
+          value[idx++] = '\'';
         }
       }
       else if (_mytoml_parser_parse_newline(tok) && !multi)
@@ -1817,6 +6237,20 @@ extern "C"
         LOG_ERR("control characters need to be escaped\n");
         break;
       }
+      else if (_mytoml_is_literal_string_char(_mytoml_tokenizer_get_token(tok)))
+      {
+        // copy the whole run of plain characters at once
+        size_t from = tok->cursor - 1;
+        size_t count =
+            _mytoml_lexer_scan(tok, from, SCAN_LITERAL_STRING) - from;
+        value = _mytoml_tokenizer_scratch(tok, idx + count);
+        RETURN_IF_FAILED(value, "could not grow string\n");
+        memcpy(value + idx, tok->input.stream + (from - tok->input.base),
+               count);
+        idx += count;
+        _mytoml_tokenizer_advance(tok, count);
+        continue;
+      }
       else
       {
         value[idx++] = _mytoml_tokenizer_get_token(tok);
@@ -1826,409 +6260,135 @@ extern "C"
     return NULL;
   }
 
-  Datetime *_mytoml_parser_parse_datetime(Tokenizer *tok, char *value,
-                                          const char *num_end, struct tm *time)
+  // true when the 8 bytes at `s` hold a digit wherever `shape` has a '0'
+  // and the byte of `shape` everywhere else, checked a word at a time
+  static inline bool _mytoml_datetime_match(const char *s, const char *shape)
   {
-    Datetime *dt = NULL;
-    int idx = 0;
-    // check to allow only 1 whitespace character
-    int spaces = 0;
-    while (_mytoml_tokenizer_has_token(tok))
-    {
-      RETURN_IF_FAILED(idx < MYTOML_MAX_STRING_LENGTH, "buffer overflow\n");
-      if ((_mytoml_is_whitesapce(_mytoml_tokenizer_get_token(tok)) && spaces) ||
-          (!_mytoml_is_whitesapce(_mytoml_tokenizer_get_token(tok)) &&
-           _mytoml_is_number_end(_mytoml_tokenizer_get_token(tok), num_end)))
-      {
-        int millis = 0;
-        char year[5] = {0};
-        char mon[3] = {0};
-        char mday[3] = {0};
-        char hour[3] = {0};
-        char min[3] = {0};
-        char sec[3] = {0};
-        char delim[2] = {0};
-        char tz[2] = {0};
-        char off_s[2] = {0};
-        char off_h[3] = {0};
-        char off_m[3] = {0};
-
-        char *end;
-        unsigned long num;
-        int t;
-
-        // DATETIME with millisecond and offset
-        t = sscanf(value, "%4c-%2c-%2c%1c%2c:%2c:%2c.%d%1c%2c:%2c", year, mon,
-                   mday, delim, hour, min, sec, &millis, off_s, off_h, off_m);
-        if (t == 11)
-        {
-          RETURN_IF_FAILED(strlen(delim) == 1, "invalid delimiter\n");
-          RETURN_IF_FAILED(strlen(off_s) == 1, "invalid offset sign\n");
-          RETURN_IF_FAILED(
-              (delim[0] == 'T' || delim[0] == 't' || delim[0] == ' '),
-              "invalid delimiter\n");
-          RETURN_IF_FAILED((off_s[0] == '+' || off_s[0] == '-'),
-                           "invalid offset sign\n");
-
-          CHECK_DATE();
-          CHECK_TIME();
-          RETURN_IF_FAILED(_mytoml_is_valid_datetime(time),
-                           "specified offset datetime is not valid\n");
-
-          CHECK_DATETIME(off_h, 2, "invalid offset hour\n");
-          RETURN_IF_FAILED((num >= 0Ul && num <= 23Ul), "invalid offset hour\n");
-          // TODO : Fix
-          //  time->tm_gmtoff = num * 60 * 60;
-          CHECK_DATETIME(off_m, 2, "invalid offset minute\n");
-          RETURN_IF_FAILED((num >= 0Ul && num <= 59Ul),
-                           "invalid offset minute\n");
-          // TODO : Fix
-          //  time->tm_gmtoff += num;
-
-          // TODO : Fix
-          // if (off_s[0] == '-')
-          // {
-          //     time->tm_gmtoff *= -1;
-          // }
-          if (delim[0] == ' ')
-          {
-            spaces = 0;
-          }
-
-          double mlen = floor(log10(abs(millis))) + 1;
-          if (mlen == 1)
-            millis *= 100;
-          if (mlen == 2)
-            millis *= 10;
-
-          RETURN_IF_FAILED(
-              (strlen(value) ==
-               (strlen("YYYY-mm-DDTHH:MM:SS.-HH:MM") + mlen + spaces)),
-              "datetime has incorrect number of characters\n");
-
-          dt = (Datetime *)calloc(1, sizeof(Datetime));
-          dt->type = TOML_DATETIME;
-          dt->dt = time;
-          mlen = (mlen > 3) ? mlen : 3;
-          dt->millis = millis;
-          int sz = strlen("%Y-%m-%dT%H:%M:%S.-HH:MM") + mlen + 1;
-          FUNC_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT, free, dt);
-          RETURN_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT,
-                           "datetime string is too long");
-          snprintf(dt->format, sz, "%%Y-%%m-%%dT%%H:%%M:%%S.%d%c%s:%s", millis,
-                   off_s[0], off_h, off_m);
-          return dt;
-        }
-        // DATETIME with offset
-        t = sscanf(value, "%4c-%2c-%2c%1c%2c:%2c:%2c%1c%2c:%2c", year, mon, mday,
-                   delim, hour, min, sec, off_s, off_h, off_m);
-        if (t == 10)
-        {
-          RETURN_IF_FAILED(strlen(delim) == 1, "invalid delimiter\n");
-          RETURN_IF_FAILED(strlen(off_s) == 1, "invalid offset sign\n");
-          RETURN_IF_FAILED(
-              (delim[0] == 'T' || delim[0] == 't' || delim[0] == ' '),
-              "invalid delimiter\n");
-          RETURN_IF_FAILED((off_s[0] == '+' || off_s[0] == '-'),
-                           "invalid offset sign\n");
-
-          CHECK_DATE();
-          CHECK_TIME();
-          RETURN_IF_FAILED(_mytoml_is_valid_datetime(time),
-                           "specified offset datetime is not valid\n");
-
-          CHECK_DATETIME(off_h, 2, "invalid offset hour\n");
-          RETURN_IF_FAILED((num >= 0 && num <= 23), "invalid offset hour\n");
-          // time->tm_gmtoff = num * 60 * 60;
-          CHECK_DATETIME(off_m, 2, "invalid offset minute\n");
-          RETURN_IF_FAILED((num >= 0 && num <= 59), "invalid offset minute\n");
-          // time->tm_gmtoff += num;
-
-          // if (off_s[0] == '-')
-          // {
-          //     time->tm_gmtoff *= -1;
-          // }
-          if (delim[0] == ' ')
-          {
-            spaces = 0;
-          }
-
-          RETURN_IF_FAILED(
-              (strlen(value) == (strlen("YYYY-mm-DDTHH:MM:SS-HH:MM") + spaces)),
-              "datetime has incorrect number of characters\n");
-
-          dt = (Datetime *)calloc(1, sizeof(Datetime));
-          dt->type = TOML_DATETIME;
-          dt->dt = time;
-          int sz = strlen("%Y-%m-%dT%H:%M:%S-HH:MM") + 1;
-          FUNC_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT, free, dt);
-          RETURN_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT,
-                           "datetime string is too long");
-          snprintf(dt->format, sz, "%%Y-%%m-%%dT%%H:%%M:%%S%c%s:%s", off_s[0],
-                   off_h, off_m);
-          return dt;
-        }
-        // DATETIME with millisecond and timezone
-        t = sscanf(value, "%4c-%2c-%2c%1c%2c:%2c:%2c.%d%1c", year, mon, mday,
-                   delim, hour, min, sec, &millis, tz);
-        if (t == 9)
-        {
-          RETURN_IF_FAILED(strlen(delim) == 1, "invalid delimiter\n");
-          RETURN_IF_FAILED(strlen(tz) == 1, "invalid timezone\n");
-          RETURN_IF_FAILED(
-              (delim[0] == 'T' || delim[0] == 't' || delim[0] == ' '),
-              "invalid delimiter\n");
-          RETURN_IF_FAILED((tz[0] == 'Z' || tz[0] == 'z'), "invalid timezone\n");
-
-          CHECK_DATE();
-          CHECK_TIME();
-          RETURN_IF_FAILED(_mytoml_is_valid_datetime(time),
-                           "specified offset datetime is not valid\n");
-
-          // time->tm_zone = "UTC";
-
-          if (delim[0] == ' ')
-          {
-            spaces = 0;
-          }
-
-          double mlen = floor(log10(abs(millis))) + 1;
-          if (mlen == 1)
-            millis *= 100;
-          if (mlen == 2)
-            millis *= 10;
-
-          RETURN_IF_FAILED((strlen(value) ==
-                            (strlen("YYYY-mm-DDTHH:MM:SS.Z") + mlen + spaces)),
-                           "datetime has incorrect number of characters\n");
-
-          dt = (Datetime *)calloc(1, sizeof(Datetime));
-          dt->type = TOML_DATETIME;
-          dt->dt = time;
-          mlen = (mlen > 3) ? mlen : 3;
-          dt->millis = millis;
-          int sz = strlen("%Y-%m-%dT%H:%M:%S.Z") + mlen + 1;
-          FUNC_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT, free, dt);
-          RETURN_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT,
-                           "datetime string is too long");
-          snprintf(dt->format, sz, "%%Y-%%m-%%dT%%H:%%M:%%S.%dZ", millis);
-          return dt;
-        }
-        // DATETIMELOCAL with millisecond
-        t = sscanf(value, "%4c-%2c-%2c%1c%2c:%2c:%2c.%d", year, mon, mday, delim,
-                   hour, min, sec, &millis);
-        if (t == 8)
-        {
-          RETURN_IF_FAILED(strlen(delim) == 1, "invalid delimiter\n");
-          RETURN_IF_FAILED(
-              (delim[0] == 'T' || delim[0] == 't' || delim[0] == ' '),
-              "invalid delimiter\n");
-
-          CHECK_DATE();
-          CHECK_TIME();
-          RETURN_IF_FAILED(_mytoml_is_valid_datetime(time),
-                           "specified local datetime is not valid\n");
-
-          if (delim[0] == ' ')
-          {
-            spaces = 0;
-          }
-
-          double mlen = floor(log10(abs(millis))) + 1;
-          if (mlen == 1)
-            millis *= 100;
-          if (mlen == 2)
-            millis *= 10;
-
-          RETURN_IF_FAILED(
-              (strlen(value) == (strlen("YYYY-mm-DDTHH:MM:SS.") + mlen + spaces)),
-              "datetime has incorrect number of characters\n");
-
-          dt = (Datetime *)calloc(1, sizeof(Datetime));
-          dt->type = TOML_DATETIMELOCAL;
-          dt->dt = time;
-          mlen = (mlen > 3) ? mlen : 3;
-          dt->millis = millis;
-          int sz = strlen("%Y-%m-%dT%H:%M:%S.") + mlen + 1;
-          FUNC_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT, free, dt);
-          RETURN_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT,
-                           "datetime string is too long");
-          snprintf(dt->format, sz, "%%Y-%%m-%%dT%%H:%%M:%%S.%d", millis);
-          return dt;
-        }
-        // DATETIME with timezone
-        t = sscanf(value, "%4c-%2c-%2c%1c%2c:%2c:%2c%1c", year, mon, mday, delim,
-                   hour, min, sec, tz);
-        if (t == 8)
-        {
-          RETURN_IF_FAILED(strlen(delim) == 1, "invalid delimiter\n");
-          RETURN_IF_FAILED(strlen(tz) == 1, "invalid timezone\n");
-          RETURN_IF_FAILED(
-              (delim[0] == 'T' || delim[0] == 't' || delim[0] == ' '),
-              "invalid delimiter\n");
-          RETURN_IF_FAILED((tz[0] == 'Z' || tz[0] == 'z'), "invalid timezone\n");
-
-          CHECK_DATE();
-          CHECK_TIME();
-          RETURN_IF_FAILED(_mytoml_is_valid_datetime(time),
-                           "specified offset datetime is not valid\n");
-
-          // time->tm_zone = "UTC";
-
-          if (delim[0] == ' ')
-          {
-            spaces = 0;
-          }
-
-          double mlen = floor(log10(abs(millis))) + 1;
-          if (mlen == 1)
-            millis *= 100;
-          if (mlen == 2)
-            millis *= 10;
-
-          RETURN_IF_FAILED(
-              (strlen(value) == (strlen("YYYY-mm-DDTHH:MM:SSZ") + spaces)),
-              "datetime has incorrect number of characters\n");
-
-          dt = (Datetime *)calloc(1, sizeof(Datetime));
-          dt->type = TOML_DATETIME;
-          dt->dt = time;
-          int sz = strlen("%Y-%m-%dT%H:%M:%SZ") + 1;
-          FUNC_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT, free, dt);
-          RETURN_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT,
-                           "datetime string is too long");
-          snprintf(dt->format, sz, "%%Y-%%m-%%dT%%H:%%M:%%SZ");
-          return dt;
-        }
-        // DATETIMELOCAL
-        t = sscanf(value, "%4c-%2c-%2c%1c%2c:%2c:%2c", year, mon, mday, delim,
-                   hour, min, sec);
-        if (t == 7)
-        {
-          RETURN_IF_FAILED(strlen(delim) == 1, "invalid delimiter\n");
-          RETURN_IF_FAILED(
-              (delim[0] == 'T' || delim[0] == 't' || delim[0] == ' '),
-              "invalid delimiter\n");
-
-          CHECK_DATE();
-          CHECK_TIME();
-          RETURN_IF_FAILED(_mytoml_is_valid_datetime(time),
-                           "specified local datetime is not valid\n");
+    const uint64_t ones = 0x0101010101010101ULL;
+    uint64_t x, p;
+    memcpy(&x, s, 8);
+    memcpy(&p, shape, 8);
+    // 0xFF in the lanes where `shape` has a '0'
+    uint64_t t = p ^ (ones * '0');
+    uint64_t zero = ~(((t & ones * 0x7F) + ones * 0x7F) | t) & ones * 0x80;
+    uint64_t digits = (zero >> 7) * 0xFF;
+    uint64_t high = ones * 0xF0;
+    uint64_t want = ones * '0' & digits;
+    // a digit is 0x30 to 0x39: high nibble 3, and still 3 after adding 6;
+    // neither add carries out of a lane once the other lanes matched
+    return ((x ^ p) & ~digits) == 0 && (x & high & digits) == want &&
+           ((x + ones * 0x06) & high & digits) == want;
+  }
 
-          if (delim[0] == ' ')
-          {
-            spaces = 0;
-          }
+  static inline int _mytoml_datetime_two_digits(const char *s)
+  {
+    return (s[0] - '0') * 10 + (s[1] - '0');
+  }
 
-          RETURN_IF_FAILED(
-              (strlen(value) == (strlen("YYYY-mm-DDTHH:MM:SS") + spaces)),
-              "datetime has incorrect number of characters\n");
-
-          dt = (Datetime *)calloc(1, sizeof(Datetime));
-          dt->type = TOML_DATETIMELOCAL;
-          dt->dt = time;
-          int sz = strlen("%Y-%m-%dT%H:%M:%S");
-          FUNC_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT, free, dt);
-          RETURN_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT,
-                           "datetime string is too long");
-          memcpy(dt->format, "%Y-%m-%dT%H:%M:%S", sz);
-          return dt;
-        }
-        // DATELOCAL
-        t = sscanf(value, "%4c-%2c-%2c", year, mon, mday);
-        if (t == 3)
-        {
-          CHECK_DATE();
-          RETURN_IF_FAILED(_mytoml_is_valid_datetime(time),
-                           "specified local date is not valid\n");
-
-          RETURN_IF_FAILED((strlen(value) == (strlen("YYYY-mm-DD") + spaces)),
-                           "date has incorrect number of characters\n");
-
-          dt = (Datetime *)calloc(1, sizeof(Datetime));
-          dt->type = TOML_DATELOCAL;
-          dt->dt = time;
-          int sz = strlen("%Y-%m-%d");
-          FUNC_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT, free, dt);
-          RETURN_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT,
-                           "datetime string is too long");
-          memcpy(dt->format, "%Y-%m-%d", sz);
-          return dt;
-        }
-        // TIMELOCAL with millisecond
-        t = sscanf(value, "%2c:%2c:%2c.%d", hour, min, sec, &millis);
-        if (t == 4)
-        {
-          CHECK_TIME();
-          time->tm_year = 0;
-          time->tm_mon = 0;
-          time->tm_mday = 1;
-          RETURN_IF_FAILED(_mytoml_is_valid_datetime(time),
-                           "specified local time is not valid\n");
-
-          double mlen = floor(log10(abs(millis))) + 1;
-          if (mlen == 1)
-            millis *= 100;
-          if (mlen == 2)
-            millis *= 10;
-
-          RETURN_IF_FAILED(
-              (strlen(value) == (strlen("HH:MM:SS.") + mlen + spaces)),
-              "time has incorrect number of characters\n");
-
-          dt = (Datetime *)calloc(1, sizeof(Datetime));
-          dt->type = TOML_TIMELOCAL;
-          dt->dt = time;
-          mlen = (mlen > 3) ? mlen : 3;
-          dt->millis = millis;
-          int sz = strlen("%H:%M:%S.") + mlen + 1;
-          FUNC_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT, free, dt);
-          RETURN_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT,
-                           "datetime string is too long");
-          snprintf(dt->format, sz, "%%H:%%M:%%S.%d", millis);
-          return dt;
-        }
-        // TIMELOCAL
-        t = sscanf(value, "%2c:%2c:%2c", hour, min, sec);
-        if (t == 3)
-        {
-          CHECK_TIME();
-          time->tm_year = 0;
-          time->tm_mon = 0;
-          time->tm_mday = 1;
-          RETURN_IF_FAILED(_mytoml_is_valid_datetime(time),
-                           "specified local time is not valid\n");
-
-          RETURN_IF_FAILED((strlen(value) == (strlen("HH:MM:SS") + spaces)),
-                           "time has incorrect number of characters\n");
-
-          dt = (Datetime *)calloc(1, sizeof(Datetime));
-          dt->type = TOML_TIMELOCAL;
-          dt->dt = time;
-          int sz = strlen("%H:%M:%S");
-          FUNC_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT, free, dt);
-          RETURN_IF_FAILED(sz < MYTOML_MAX_DATE_FORMAT,
-                           "datetime string is too long");
-          memcpy(dt->format, "%H:%M:%S", sz);
-          return dt;
-        }
-#undef CHECK_TIME
-#undef CHECK_DATE
-#undef CHECK_DATETIME
-        LOG_ERR("could not parse %s as datetime\n", value);
-        break;
+  bool _mytoml_parser_parse_datetime_span(const char *s, size_t len,
+                                          TomlDatetime *dt)
+  {
+    size_t pos = 0;
+    memset(dt, 0, sizeof(*dt));
+    if (len >= 10 && s[4] == '-')
+    {
+      if (!_mytoml_datetime_match(s, "0000-00-") ||
+          !_mytoml_datetime_match(s + 2, "00-00-00"))
+        return false;
+      int year = _mytoml_datetime_two_digits(s) * 100 +
+                 _mytoml_datetime_two_digits(s + 2);
+      int month = _mytoml_datetime_two_digits(s + 5);
+      int day = _mytoml_datetime_two_digits(s + 8);
+      if (!_mytoml_is_date(year, month - 1, day))
+        return false;
+      dt->days = _mytoml_datetime_days(year, month, day);
+      dt->flags = MYTOML_DATETIME_DATE;
+      pos = 10;
+      if (pos == len)
+        return true;
+      if (s[pos] != 'T' && s[pos] != 't' && s[pos] != ' ')
+        return false;
+      pos++;
+    }
+    if (len - pos < 8 || !_mytoml_datetime_match(s + pos, "00:00:00"))
+      return false;
+    int hour = _mytoml_datetime_two_digits(s + pos);
+    int minute = _mytoml_datetime_two_digits(s + pos + 3);
+    int second = _mytoml_datetime_two_digits(s + pos + 6);
+    if (hour > 23 || minute > 59 || second > 59)
+      return false;
+    dt->nanos = (int64_t)((hour * 60 + minute) * 60 + second) * 1000000000;
+    dt->flags |= MYTOML_DATETIME_TIME;
+    pos += 8;
+    if (pos < len && s[pos] == '.')
+    {
+      size_t from = ++pos;
+      int64_t fraction = 0;
+      while (pos < len && _mytoml_is_digit(s[pos]))
+      {
+        if (pos - from < 9)
+          fraction = fraction * 10 + (s[pos] - '0');
+        pos++;
+      }
+      if (pos == from)
+        return false;
+      dt->digits = (uint8_t)(pos - from < 9 ? pos - from : 9);
+      for (int i = dt->digits; i < 9; i++)
+        fraction *= 10;
+      dt->nanos += fraction;
+    }
+    if (pos < len && (dt->flags & MYTOML_DATETIME_DATE))
+    {
+      if (s[pos] == 'Z' || s[pos] == 'z')
+      {
+        dt->flags |= MYTOML_DATETIME_OFFSET | MYTOML_DATETIME_ZULU;
+        pos++;
       }
       else
       {
-        if (_mytoml_is_whitesapce(_mytoml_tokenizer_get_token(tok)))
-        {
-          spaces++;
-        }
-        value[idx++] = _mytoml_tokenizer_get_token(tok);
+        if (len - pos < 6 || (s[pos] != '+' && s[pos] != '-') ||
+            !_mytoml_is_digit(s[pos + 1]) || !_mytoml_is_digit(s[pos + 2]) ||
+            s[pos + 3] != ':' || !_mytoml_is_digit(s[pos + 4]) ||
+            !_mytoml_is_digit(s[pos + 5]))
+          return false;
+        int hours = _mytoml_datetime_two_digits(s + pos + 1);
+        int minutes = _mytoml_datetime_two_digits(s + pos + 4);
+        if (hours > 23 || minutes > 59)
+          return false;
+        minutes += hours * 60;
+        dt->offset = (int16_t)(s[pos] == '-' ? -minutes : minutes);
+        dt->flags |= MYTOML_DATETIME_OFFSET;
+        pos += 6;
       }
-      _mytoml_tokenizer_next_token(tok);
     }
-    return NULL;
+    return pos == len;
+  }
+
+  TomlDatetime *_mytoml_parser_parse_datetime(Tokenizer *tok,
+                                              const char *num_end,
+                                              TomlDatetime *dt)
+  {
+    Token t;
+    _mytoml_lexer_number(tok, &t);
+    size_t end = t.start + t.len;
+    // a space may stand in for the `T`, then a time follows the date
+    if (t.len == 10 && _mytoml_tokenizer_fill(tok, end + 1) &&
+        tok->input.stream[end - tok->input.base] == ' ' &&
+        _mytoml_is_digit(tok->input.stream[end + 1 - tok->input.base]))
+    {
+      end = _mytoml_lexer_run(tok, end + 1, _mytoml_is_number_char);
+    }
+    const char *s = _mytoml_lexer_text(tok, &t);
+    size_t len = end - t.start;
+    RETURN_IF_FAILED(_mytoml_parser_parse_datetime_span(s, len, dt),
+                     "could not parse %.*s as datetime\n", (int)len, s);
+    size_t next = end - tok->input.base;
+    RETURN_IF_FAILED(next == tok->input.length ||
+                         _mytoml_is_whitesapce(tok->input.stream[next]) ||
+                         _mytoml_is_number_end(tok->input.stream[next], num_end),
+                     "unexpected %c after datetime\n", tok->input.stream[next]);
+    _mytoml_tokenizer_advance(tok, len);
+    return dt;
   }
 
   double _mytoml_parser_parse_lnf_nan(Tokenizer *tok, bool negative)
@@ -2277,7 +6437,6 @@ extern "C"
     bool sep = true;
     while (_mytoml_tokenizer_has_token(tok))
     {
-      RETURN_IF_FAILED(arr->len < MYTOML_MAX_ARRAY_LENGTH, "buffer overflow\n");
       if (_mytoml_is_array_end(_mytoml_tokenizer_get_token(tok)))
       {
         _mytoml_tokenizer_next_token(tok);
@@ -2305,9 +6464,10 @@ extern "C"
       else
       {
         RETURN_IF_FAILED(sep, "expected , between elements\n");
-        TomlValue *v = _mytoml_parser_parse_value(tok, "#,] \n");
+        TomlValue *v = _mytoml_parser_parse_value(tok, "#,] \r\n");
         RETURN_IF_FAILED(v, "could not parse value\n");
-        arr->arr[arr->len++] = v;
+        bool ok = _mytoml_value_array_push(arr, v);
+        RETURN_IF_FAILED(ok, "could not grow array\n");
         sep = false;
       }
     }
@@ -2360,13 +6520,13 @@ extern "C"
   TomlKey *_mytoml_parser_parse_inline_tabel(Tokenizer *tok)
   {
     TomlKey *keys = _mytoml_value_new_key(TOML_TABLE);
+    RETURN_IF_FAILED(keys, "failed to allocate inline table\n");
     bool sep = true;
     bool first = true;
     while (_mytoml_tokenizer_has_token(tok))
     {
       if (_mytoml_is_inline_table_end(_mytoml_tokenizer_get_token(tok)))
       {
-        FUNC_IF_FAILED((!sep || first), _mytoml_value_delete_key, keys);
         RETURN_IF_FAILED((!sep || first),
                          "cannot have trailing comma in inline table\n");
         _mytoml_tokenizer_next_token(tok);
@@ -2375,7 +6535,6 @@ extern "C"
       else if (_mytoml_is_inline_table_seperator(
                    _mytoml_tokenizer_get_token(tok)))
       {
-        FUNC_IF_FAILED(!sep, _mytoml_value_delete_key, keys);
         RETURN_IF_FAILED(!sep, "expected key-value but got , instead");
         sep = true;
         _mytoml_tokenizer_next_token(tok);
@@ -2391,29 +6550,22 @@ extern "C"
       }
       else
       {
-        FUNC_IF_FAILED(sep, _mytoml_value_delete_key, keys);
         RETURN_IF_FAILED(sep, "expected , between elements\n");
         TomlKey *k = _mytoml_parser_parse_key(tok, keys, true);
-        FUNC_IF_FAILED(k, _mytoml_value_delete_key, keys);
         RETURN_IF_FAILED(k, "failed to parse key\n");
         TomlValue *v = _mytoml_parser_parse_value(tok, ", }");
-        FUNC_IF_FAILED(v, _mytoml_value_delete_key, keys);
         RETURN_IF_FAILED(v, "failed to parse value\n");
         // refer to inline table comment in `keys.c`
         if (v->type == TOML_INLINETABLE)
         {
-          TomlKey *h = (TomlKey *)(v->data);
+          TomlKey *h = v->table;
           k->type = TOML_KEY;
-          for (khiter_t ki = kh_begin(h->subkeys); ki != kh_end(h->subkeys);
-               ++ki)
+          size_t it = 0;
+          for (TomlKey *sub; (sub = toml_key_next(h, &it));)
           {
-            if (kh_exist(h->subkeys, ki))
-            {
-              TomlKey *e = _mytoml_value_add_sub_key(k, kh_value(h->subkeys, ki));
-              FUNC_IF_FAILED(e, _mytoml_value_delete_key, keys);
-              RETURN_IF_FAILED(e, "could not add inline table key %s\n",
-                               kh_value(h->subkeys, ki)->id);
-            }
+            TomlKey *e = _mytoml_value_add_sub_key(k, sub);
+            RETURN_IF_FAILED(e, "could not add inline table key %s\n",
+                             sub->id.str);
           }
           k->type = TOML_KEYLEAF;
         }
@@ -2431,31 +6583,30 @@ extern "C"
 
   bool _mytoml_parser_parse_comment(Tokenizer *tok)
   {
-    while (_mytoml_tokenizer_has_token(tok))
+    Token t;
+    _mytoml_lexer_next(tok, &t);
+    _mytoml_tokenizer_advance(tok, t.len);
+    // a comment runs up to the first control character,
+    // which has to be the end of the line or the input
+    if (!_mytoml_tokenizer_has_token(tok))
+    {
+      return true;
+    }
+    if (_mytoml_parser_parse_newline(tok))
     {
       _mytoml_tokenizer_next_token(tok);
-      if (_mytoml_parser_parse_newline(tok))
-      {
-        _mytoml_tokenizer_next_token(tok);
-        return true;
-      }
-      if (_mytoml_is_control(_mytoml_tokenizer_get_token(tok)))
-      {
-        return false;
-      }
+      return true;
     }
-    return true;
+    return false;
   }
 
   void _mytoml_parser_parse_whitespace(Tokenizer *tok)
   {
-    while (_mytoml_tokenizer_has_token(tok))
+    Token t;
+    if (_mytoml_is_whitesapce(_mytoml_tokenizer_get_token(tok)))
     {
-      if (!_mytoml_is_whitesapce(_mytoml_tokenizer_get_token(tok)))
-      {
-        break;
-      }
-      _mytoml_tokenizer_next_token(tok);
+      _mytoml_lexer_next(tok, &t);
+      _mytoml_tokenizer_advance(tok, t.len);
     }
   }
 
@@ -2465,113 +6616,68 @@ extern "C"
     {
       return true;
     }
-    else if (_mytoml_is_return(_mytoml_tokenizer_get_token(tok)))
+    else if (_mytoml_is_return(_mytoml_tokenizer_get_token(tok)) &&
+             _mytoml_is_newline(_mytoml_tokenizer_peek(tok, 1)))
     {
-      bool a = _mytoml_tokenizer_next_token(tok);
-      if (_mytoml_is_newline(_mytoml_tokenizer_get_token(tok)))
-      {
-        return true;
-      }
-      else
-      {
-        _mytoml_tokenizer_backtrace(tok, a);
-      }
+      _mytoml_tokenizer_next_token(tok);
+      return true;
     }
     return false;
   }
 
-  int _mytoml_parser_parse_unicode(Tokenizer *tok, char *escaped, int len)
+  int _mytoml_parser_parse_unicode(Tokenizer *tok, char *escaped, int len,
+                                   int digits)
   {
-    int digits = 0;
     char code[9] = {0};
-    while (_mytoml_tokenizer_has_token(tok))
+    for (int i = 0; i < digits; i++)
     {
-      if (digits > 8)
+      if (!_mytoml_tokenizer_has_token(tok) ||
+          !(_mytoml_is_hex_digit(_mytoml_tokenizer_get_token(tok)) ||
+            _mytoml_is_digit(_mytoml_tokenizer_get_token(tok))))
       {
         LOG_ERR("Invalid unicode escape code\n");
-        break;
-      }
-      if (_mytoml_is_hex_digit(_mytoml_tokenizer_get_token(tok)) ||
-          _mytoml_is_digit(_mytoml_tokenizer_get_token(tok)))
-      {
-        code[digits++] = _mytoml_tokenizer_get_token(tok);
-        _mytoml_tokenizer_next_token(tok);
-        continue;
-      }
-      else
-      {
-        if (digits != 4 && digits != 8)
-        {
-          LOG_ERR("Invalid unicode escape code\n");
-          break;
-        }
-        char *end;
-        unsigned long num = strtoul(code, &end, 16);
-        if (end != code + digits)
-        {
-          LOG_ERR("Invalid unicode escape code\n");
-          break;
-        }
-        // Unicode Scalar Values: %x80-D7FF / %xE000-10FFFF
-        if ((num >= 0x0 && num <= 0xD7FF) || (num >= 0xE000 && num <= 0x10FFFF))
-        {
-          // UTF-8 encoding
-          if (num <= 0x0 && num <= 0x7F)
-          {
-            if (len < 1)
-            {
-              LOG_ERR("escaped array is not long enough\n");
-              break;
-            }
-            escaped[0] = (num) & 0b01111111;
-            return 1;
-          }
-          else if (num >= 0x80 && num <= 0x7FF)
-          {
-            if (len < 2)
-            {
-              LOG_ERR("escaped array is not long enough\n");
-              break;
-            }
-            escaped[0] = (0b11000000 | (num >> 6)) & 0b11011111;
-            escaped[1] = (0b10000000 | (num)) & 0b10111111;
-            return 2;
-          }
-          else if ((num >= 0x800 && num <= 0xFFFF))
-          {
-            if (len < 3)
-            {
-              LOG_ERR("escaped array is not long enough\n");
-              break;
-            }
-            escaped[0] = (0b11100000 | (num >> 12)) & 0b11101111;
-            escaped[1] = (0b10000000 | (num >> 6)) & 0b10111111;
-            escaped[2] = (0b10000000 | (num)) & 0b10111111;
-            return 3;
-          }
-          else
-          {
-            if (len < 4)
-            {
-              LOG_ERR("escaped array is not long enough\n");
-              break;
-            }
-            escaped[0] = (0b11110000 | (num >> 18)) & 0b11110111;
-            escaped[1] = (0b10000000 | (num >> 12)) & 0b10111111;
-            escaped[2] = (0b10000000 | (num >> 6)) & 0b10111111;
-            escaped[3] = (0b10000000 | (num)) & 0b10111111;
-            return 4;
-          }
-          return 0;
-        }
-        else
-        {
-          LOG_ERR("Invalid unicode escape code\n");
-          break;
-        }
+        return 0;
       }
+      code[i] = _mytoml_tokenizer_get_token(tok);
+      _mytoml_tokenizer_next_token(tok);
     }
-    return 0;
+    unsigned long num = strtoul(code, NULL, 16);
+    // Unicode Scalar Values: %x0-D7FF / %xE000-10FFFF
+    if (num > 0x10FFFF || (num >= 0xD800 && num < 0xE000))
+    {
+      LOG_ERR("Invalid unicode escape code\n");
+      return 0;
+    }
+    // UTF-8 encoding
+    int size = num <= 0x7F ? 1 : num <= 0x7FF ? 2 : num <= 0xFFFF ? 3 : 4;
+    if (len < size)
+    {
+      LOG_ERR("escaped array is not long enough\n");
+      return 0;
+    }
+    if (size == 1)
+    {
+      escaped[0] = (num) & 0b01111111;
+    }
+    else if (size == 2)
+    {
+      escaped[0] = (0b11000000 | (num >> 6)) & 0b11011111;
+      escaped[1] = (0b10000000 | (num)) & 0b10111111;
+    }
+    else if (size == 3)
+    {
+      escaped[0] = (0b11100000 | (num >> 12)) & 0b11101111;
+      escaped[1] = (0b10000000 | (num >> 6)) & 0b10111111;
+      escaped[2] = (0b10000000 | (num)) & 0b10111111;
+    }
+    else
+    {
+      escaped[0] = (0b11110000 | (num >> 18)) & 0b11110111;
+      escaped[1] = (0b10000000 | (num >> 12)) & 0b10111111;
+      escaped[2] = (0b10000000 | (num >> 6)) & 0b10111111;
+      escaped[3] = (0b10000000 | (num)) & 0b10111111;
+    }
+    return size;
   }
 
   int _mytoml_parser_parse_escape(Tokenizer *tok, char *escaped, int len)
@@ -2628,13 +6734,13 @@ extern "C"
     case 'u':
     {
       _mytoml_tokenizer_next_token(tok);
-      int u = _mytoml_parser_parse_unicode(tok, escaped, len);
+      int u = _mytoml_parser_parse_unicode(tok, escaped, len, 4);
       return u;
     }
     case 'U':
     {
       _mytoml_tokenizer_next_token(tok);
-      int u = _mytoml_parser_parse_unicode(tok, escaped, len);
+      int u = _mytoml_parser_parse_unicode(tok, escaped, len, 8);
       return u;
     }
     default:
@@ -2643,35 +6749,60 @@ extern "C"
     return 0;
   }
 
-  double _mytoml_parser_parse_base_unit(Tokenizer *tok, int base, char *value,
-                                        const char *num_end)
+  bool _mytoml_parser_parse_int64(const char *s, size_t len, int base,
+                                  int64_t *out)
+  {
+    size_t i = 0;
+    bool negative = false;
+    if (len && (s[0] == '+' || s[0] == '-'))
+    {
+      negative = s[0] == '-';
+      i++;
+    }
+    if (i == len)
+      return false;
+    // the magnitude is accumulated unsigned, INT64_MIN has no positive twin
+    uint64_t limit = (uint64_t)INT64_MAX + negative;
+    uint64_t cutoff = limit / base;
+    unsigned cutlim = (unsigned)(limit % base);
+    uint64_t mag = 0;
+    for (; i < len; i++)
+    {
+      unsigned digit;
+      char c = s[i];
+      if (c >= '0' && c <= '9')
+        digit = c - '0';
+      else if (c >= 'a' && c <= 'f')
+        digit = c - 'a' + 10;
+      else if (c >= 'A' && c <= 'F')
+        digit = c - 'A' + 10;
+      else
+        return false;
+      if (digit >= (unsigned)base)
+        return false;
+      if (mag > cutoff || (mag == cutoff && digit > cutlim))
+        return false;
+      mag = mag * base + digit;
+    }
+    *out = negative ? -(int64_t)(mag - 1) - 1 : (int64_t)mag;
+    return true;
+  }
+
+  bool _mytoml_parser_parse_base_unit(Tokenizer *tok, int base,
+                                      const char *num_end, int64_t *out)
   {
-    int idx = 0;
-    double d = -1;
+    size_t idx = 0;
+    char *value;
     while (_mytoml_tokenizer_has_token(tok))
     {
-      if (idx >= MYTOML_MAX_STRING_LENGTH)
+      value = _mytoml_tokenizer_scratch(tok, idx + 1);
+      if (!value)
       {
-        LOG_ERR("buffer overflow\n");
-        break;
+        LOG_ERR("could not grow number\n");
+        return false;
       }
       if (_mytoml_is_number_end(_mytoml_tokenizer_get_token(tok), num_end))
       {
-        if (idx == 0)
-        {
-          LOG_ERR("incomplete non-decimal number\n");
-          break;
-        }
-        char *end;
-        unsigned long num = strtoul(value, &end, base);
-        if (end == value + idx)
-        {
-          d = (double)num;
-        }
-        else
-        {
-          LOG_ERR("could not convert %s to base %d\n", value, base);
-        }
         break;
       }
       else if (_mytoml_is_underscore(_mytoml_tokenizer_get_token(tok)))
@@ -2690,7 +6821,7 @@ extern "C"
         {
           LOG_ERR("stray %c character\n",
                   _mytoml_tokenizer_get_previous_token(tok));
-          break;
+          return false;
         }
       }
       else
@@ -2699,69 +6830,66 @@ extern "C"
       }
       _mytoml_tokenizer_next_token(tok);
     }
-    return d;
+    if (idx == 0)
+    {
+      LOG_ERR("incomplete non-decimal number\n");
+      return false;
+    }
+    value[idx] = '\0';
+    bool ok = value[0] != '+' && value[0] != '-' &&
+              _mytoml_parser_parse_int64(value, idx, base, out);
+    if (!ok)
+    {
+      LOG_ERR("could not convert %s to a base %d integer\n", value, base);
+    }
+    return ok;
   }
 
-  Number *_mytoml_parser_parse_number(Tokenizer *tok, char *value, double *d,
+  Number *_mytoml_parser_parse_number(Tokenizer *tok, double *d,
                                       const char *num_end, Number *n)
   {
-    int idx = 0;
+    size_t idx = 0;
+    char *value = NULL;
     n->type = TOML_INT;
     n->scientific = false;
     n->precision = 0;
     while (_mytoml_tokenizer_has_token(tok))
     {
-      RETURN_IF_FAILED(idx < MYTOML_MAX_STRING_LENGTH, "buffer overflow\n");
+      // room for the longest write of one step, a point and a digit
+      value = _mytoml_tokenizer_scratch(tok, idx + 2);
+      RETURN_IF_FAILED(value, "could not grow number\n");
       if (_mytoml_is_number_end(_mytoml_tokenizer_get_token(tok), num_end))
       {
-        char *end;
-        double num = strtod(value, &end);
-        RETURN_IF_FAILED(end == value + idx, "could not convert %s to double\n",
-                         value);
-        *d = num;
-        if (n->precision > 0)
-          n->precision--;
-        if (n->type == TOML_INT && num != 0)
-        {
-          RETURN_IF_FAILED(value[0] != '0',
-                           "cannot have leading zero for integers");
-          if (value[0] == '+' || value[0] == '-')
-          {
-            RETURN_IF_FAILED(value[1] != '0',
-                             "cannot have leading zero for signed integers");
-          }
-        }
-        return n;
+        break;
       }
       else if (idx == 0 && _mytoml_tokenizer_get_token(tok) == '0')
       {
-        double b;
+        int base;
         _mytoml_tokenizer_next_token(tok);
         if (_mytoml_tokenizer_get_token(tok) == 'x')
         {
           // hexadecimal
-          _mytoml_tokenizer_next_token(tok);
-          b = _mytoml_parser_parse_base_unit(tok, 16, value, num_end);
+          base = 16;
         }
         else if (_mytoml_tokenizer_get_token(tok) == 'o')
         {
           // octal
-          _mytoml_tokenizer_next_token(tok);
-          b = _mytoml_parser_parse_base_unit(tok, 8, value, num_end);
+          base = 8;
         }
         else if (_mytoml_tokenizer_get_token(tok) == 'b')
         {
           // binary
-          _mytoml_tokenizer_next_token(tok);
-          b = _mytoml_parser_parse_base_unit(tok, 2, value, num_end);
+          base = 2;
         }
         else
         {
           value[idx++] = '0';
           continue;
         }
-        RETURN_IF_FAILED(b != -1, "invalid non-decimal number\n");
-        *d = b;
+        _mytoml_tokenizer_next_token(tok);
+        RETURN_IF_FAILED(
+            _mytoml_parser_parse_base_unit(tok, base, num_end, &n->integer),
+            "invalid non-decimal number\n");
         return n;
       }
       else if (_mytoml_is_decimal_point(_mytoml_tokenizer_get_token(tok)) ||
@@ -2773,7 +6901,6 @@ extern "C"
           n->type = TOML_FLOAT;
           n->precision = 1;
         }
-        RETURN_IF_FAILED(idx < MYTOML_MAX_STRING_LENGTH, "buffer overflow\n");
         _mytoml_tokenizer_next_token(tok);
         if (_mytoml_is_digit(_mytoml_tokenizer_get_token(tok)) &&
             _mytoml_is_digit(_mytoml_tokenizer_get_prev_prev_token(tok)))
@@ -2835,178 +6962,159 @@ extern "C"
       }
       _mytoml_tokenizer_next_token(tok);
     }
-    char *end;
-    double num = strtod(value, &end);
-    RETURN_IF_FAILED(end == value + idx, "could not convert %s to double\n",
-                     value);
-    *d = num;
-    if (n->precision > 0)
-      n->precision--;
-    if (n->type == TOML_INT && num != 0)
+    value = _mytoml_tokenizer_scratch(tok, idx);
+    RETURN_IF_FAILED(value, "could not grow number\n");
+    value[idx] = '\0';
+    if (n->type == TOML_INT)
     {
-      RETURN_IF_FAILED(value[0] != '0', "cannot have leading zero for integers");
-      if (value[0] == '+' || value[0] == '-')
+      RETURN_IF_FAILED(_mytoml_parser_parse_int64(value, idx, 10, &n->integer),
+                       "could not convert %s to a 64-bit integer\n", value);
+      if (n->integer != 0)
       {
-        RETURN_IF_FAILED(value[1] != '0',
-                         "cannot have leading zero for signed integers");
+        RETURN_IF_FAILED(value[0] != '0',
+                         "cannot have leading zero for integers");
+        if (value[0] == '+' || value[0] == '-')
+        {
+          RETURN_IF_FAILED(value[1] != '0',
+                           "cannot have leading zero for signed integers");
+        }
       }
+      return n;
     }
-    return n;
-  }
-
-  TomlValue *_mytoml_parser_parse_value(Tokenizer *tok, const char *num_end)
-  {
-    while (_mytoml_tokenizer_has_token(tok))
+    Number fast;
+    if (_mytoml_float_parse_span(value, idx, d, &fast))
     {
-      RETURN_IF_FAILED(!_mytoml_parser_parse_newline(tok),
-                       "got a newline before any value\n");
-      if (_mytoml_is_whitesapce(_mytoml_tokenizer_get_token(tok)))
-      {
-        _mytoml_parser_parse_whitespace(tok);
-        continue;
-      }
-      else if (_mytoml_is_basic_string_start(
-                   _mytoml_tokenizer_get_token(tok)))
-      {
-        char value[MYTOML_MAX_STRING_LENGTH] = {0};
-        char *s;
-        _mytoml_tokenizer_next_token(tok);
-        if (_mytoml_tokenizer_has_token(tok) &&
-            _mytoml_is_basic_string_start(_mytoml_tokenizer_get_token(tok)))
-        {
-          _mytoml_tokenizer_next_token(tok);
-          if (_mytoml_tokenizer_has_token(tok) &&
-              _mytoml_is_basic_string_start(_mytoml_tokenizer_get_token(tok)))
-          {
-            _mytoml_tokenizer_next_token(tok);
-            s = _mytoml_parser_parse_basic_string(tok, value, true);
-          }
-          else if (_mytoml_is_whitesapce(_mytoml_tokenizer_get_token(tok)) ||
-                   _mytoml_parser_parse_newline(tok))
-          {
-            s = value;
-          }
-          else
-          {
-            LOG_ERR("cannot start string with 2 double-quotes\n");
-            break;
-          }
-        }
-        else
-        {
-          s = _mytoml_parser_parse_basic_string(tok, value, false);
-        }
-        RETURN_IF_FAILED(s, "could not parse basic string\n");
-        TomlValue *v = _mytoml_value_new_string(value);
-        return v;
+      if (n->precision > 0)
+        n->precision--;
+      return n;
+    }
+    // what the fast path turns down, such as leading zeros, is converted
+    // digit by digit
+    RETURN_IF_FAILED(_mytoml_float_parse_decimal(value, idx, d),
+                     "could not convert %s to double\n", value);
+    if (n->precision > 0)
+      n->precision--;
+    return n;
+  }
+
+  TomlValue *_mytoml_parser_parse_value(Tokenizer *tok, const char *num_end)
+  {
+    while (_mytoml_tokenizer_has_token(tok))
+    {
+      Token t;
+      CharClass c = _mytoml_char_class(_mytoml_tokenizer_get_token(tok));
+      switch (c)
+      {
+      case C_NEWLINE:
+      case C_RETURN:
+      {
+        RETURN_IF_FAILED(!_mytoml_parser_parse_newline(tok),
+                         "got a newline before any value\n");
+        LOG_ERR("unknown value type\n");
+        return NULL;
       }
-      else if (_mytoml_is_literal_string_start(
-                   _mytoml_tokenizer_get_token(tok)))
+      case C_BLANK:
+      {
+        _mytoml_parser_parse_whitespace(tok);
+        continue;
+      }
+      case C_BASIC_QUOTE:
+      case C_LITERAL_QUOTE:
       {
-        char value[MYTOML_MAX_STRING_LENGTH] = {0};
+        if (_mytoml_lexer_next(tok, &t) != T_PUNCT)
+        {
+          // strings without escapes are copied straight from the input
+          const char *text = _mytoml_lexer_text(tok, &t);
+          TomlValue *v = _mytoml_value_new_stringn(text + 1, t.len - 2);
+          _mytoml_tokenizer_advance(tok, t.len);
+          return v;
+        }
+        bool basic = (c == C_BASIC_QUOTE);
+        char quote = _mytoml_tokenizer_get_token(tok);
         char *s;
+        size_t len = 0;
         _mytoml_tokenizer_next_token(tok);
         if (_mytoml_tokenizer_has_token(tok) &&
-            _mytoml_is_literal_string_start(_mytoml_tokenizer_get_token(tok)))
+            _mytoml_tokenizer_get_token(tok) == quote)
         {
           _mytoml_tokenizer_next_token(tok);
           if (_mytoml_tokenizer_has_token(tok) &&
-              _mytoml_is_literal_string_start(_mytoml_tokenizer_get_token(tok)))
+              _mytoml_tokenizer_get_token(tok) == quote)
           {
             _mytoml_tokenizer_next_token(tok);
-            s = _mytoml_parser_parse_literal_string(tok, value, true);
+            s = basic ? _mytoml_parser_parse_basic_string(tok, &len, true)
+                      : _mytoml_parser_parse_literal_string(tok, &len, true);
           }
           else if (_mytoml_is_whitesapce(_mytoml_tokenizer_get_token(tok)) ||
                    _mytoml_parser_parse_newline(tok))
           {
-            s = value;
+            s = (char *)"";
           }
           else
           {
-            LOG_ERR("cannot start string with 2 single-quotes\n");
-            break;
+            LOG_ERR("cannot start string with 2 %s-quotes\n",
+                    basic ? "double" : "single");
+            return NULL;
           }
         }
         else
         {
-          s = _mytoml_parser_parse_literal_string(tok, value, false);
+          s = basic ? _mytoml_parser_parse_basic_string(tok, &len, false)
+                    : _mytoml_parser_parse_literal_string(tok, &len, false);
         }
-        RETURN_IF_FAILED(s, "could not parse literal string\n");
-        TomlValue *v = _mytoml_value_new_string(value);
+        RETURN_IF_FAILED(s, "could not parse %s string\n",
+                         basic ? "basic" : "literal");
+        TomlValue *v = _mytoml_value_new_stringn(s, len);
         return v;
       }
-      else if (_mytoml_is_number_start(_mytoml_tokenizer_get_token(tok)))
+      case C_DIGIT:
+      case C_SIGN:
       {
-        char value[MYTOML_MAX_STRING_LENGTH] = {0};
-        // try parsing date time
-        bool a = _mytoml_tokenizer_next_token(tok);
-        bool b = _mytoml_tokenizer_next_token(tok);
-        if (_mytoml_tokenizer_has_token(tok) &&
-            _mytoml_tokenizer_get_token(tok) == ':')
+        // the shape of the number token tells dates and times
+        // (`HH:` or `YYYY-`) apart from numbers
+        _mytoml_lexer_number(tok, &t);
+        const char *span = _mytoml_lexer_text(tok, &t);
+        if ((t.len > 2 && _mytoml_is_digit(span[0]) &&
+             _mytoml_is_digit(span[1]) && span[2] == ':') ||
+            (t.len > 4 && _mytoml_is_digit(span[0]) &&
+             _mytoml_is_digit(span[1]) && _mytoml_is_digit(span[2]) &&
+             _mytoml_is_digit(span[3]) && span[4] == '-'))
         {
-          _mytoml_tokenizer_backtrace(tok, a + b);
-          struct tm *time = (struct tm *)calloc(1, sizeof(struct tm));
-          Datetime *dt = _mytoml_parser_parse_datetime(tok, value, num_end, time);
-          FUNC_IF_FAILED(dt, free, time);
-          RETURN_IF_FAILED(dt, "could not parse time\n");
-          TomlValue *v = _mytoml_value_new_datetime(dt->dt, dt->type, dt->format,
-                                                    dt->millis);
-          free(dt);
-          free(time);
-          return v;
-        }
-        else if (!_mytoml_is_digit(_mytoml_tokenizer_get_previous_token(tok)) ||
-                 !_mytoml_is_digit(_mytoml_tokenizer_get_token(tok)))
-        {
-          _mytoml_tokenizer_backtrace(tok, a + b);
+          TomlDatetime dt;
+          RETURN_IF_FAILED(_mytoml_parser_parse_datetime(tok, num_end, &dt),
+                           "could not parse datetime\n");
+          return _mytoml_value_new_datetime(&dt);
         }
-        else
+        double d = 0;
+        Number num;
+        // well formed floats are converted straight from the input, the
+        // parser walks everything else and reports the errors
+        size_t next = t.start + t.len - tok->input.base;
+        if (_mytoml_float_parse_span(span, t.len, &d, &num) &&
+            (next == tok->input.length ||
+             _mytoml_is_number_end(tok->input.stream[next], num_end)))
         {
-          bool c = _mytoml_tokenizer_next_token(tok);
-          bool d = _mytoml_tokenizer_next_token(tok);
-          if (_mytoml_tokenizer_has_token(tok) &&
-              _mytoml_tokenizer_get_token(tok) == '-')
-          {
-            _mytoml_tokenizer_backtrace(tok, a + b + c + d);
-            struct tm *time = (struct tm *)calloc(1, sizeof(struct tm));
-            Datetime *dt =
-                _mytoml_parser_parse_datetime(tok, value, num_end, time);
-            FUNC_IF_FAILED(dt, free, time);
-            RETURN_IF_FAILED(dt, "could not parse datetime\n");
-            TomlValue *v = _mytoml_value_new_datetime(dt->dt, dt->type,
-                                                      dt->format, dt->millis);
-            free(dt);
-            free(time);
-            return v;
-          }
-          else
-          {
-            _mytoml_tokenizer_backtrace(tok, a + b + c + d);
-          }
+          _mytoml_tokenizer_advance(tok, t.len);
+          return _mytoml_value_new_number(&d, num.type, num.precision,
+                                          num.scientific);
         }
-        double *d = (double *)calloc(1, sizeof(double));
-        Number *num = (Number *)calloc(1, sizeof(Number));
-        Number *n = _mytoml_parser_parse_number(tok, value, d, num_end, num);
-        FUNC_IF_FAILED(n, free, d);
-        FUNC_IF_FAILED(n, free, n);
+        Number *n = _mytoml_parser_parse_number(tok, &d, num_end, &num);
         RETURN_IF_FAILED(n, "could not parse number\n");
-        TomlValue *v =
-            _mytoml_value_new_number(d, n->type, n->precision, n->scientific);
-        free(d);
-        free(n);
-        return v;
+        if (n->type == TOML_INT)
+          return _mytoml_value_new_integer(n->integer);
+        return _mytoml_value_new_number(&d, n->type, n->precision,
+                                        n->scientific);
       }
-      else if (_mytoml_is_array_start(_mytoml_tokenizer_get_token(tok)))
+      case C_BRACKET:
       {
         TomlValue *v = _mytoml_value_new_array();
+        RETURN_IF_FAILED(v, "could not allocate array\n");
         _mytoml_tokenizer_next_token(tok);
         TomlValue *val = _mytoml_parser_parse_array(tok, v);
-        FUNC_IF_FAILED(val, _mytoml_value_delete, v);
         RETURN_IF_FAILED(val, "could not parse array\n");
         return val;
       }
-      else if (_mytoml_is_inline_table_start(
-                   _mytoml_tokenizer_get_token(tok)))
+      case C_BRACE:
       {
         _mytoml_tokenizer_next_token(tok);
         TomlKey *keys = _mytoml_parser_parse_inline_tabel(tok);
@@ -3014,8 +7122,7 @@ extern "C"
         TomlValue *v = _mytoml_value_new_table(keys);
         return v;
       }
-      else if (_mytoml_tokenizer_get_token(tok) == 't' ||
-               _mytoml_tokenizer_get_token(tok) == 'f')
+      case C_BOOL:
       {
         double b = _mytoml_parser_parse_boolean(tok);
         RETURN_IF_FAILED((b == 1 || b == 0),
@@ -3023,18 +7130,18 @@ extern "C"
         TomlValue *v = _mytoml_value_new_number(&b, TOML_BOOL, 0, false);
         return v;
       }
-      else if (_mytoml_tokenizer_get_token(tok) == 'i' ||
-               _mytoml_tokenizer_get_token(tok) == 'n')
+      case C_SPECIAL:
       {
         double f = _mytoml_parser_parse_lnf_nan(tok, false);
         RETURN_IF_FAILED(f, "expecting inf or nan but could not parse\n");
         TomlValue *v = _mytoml_value_new_number(&f, TOML_FLOAT, 0, false);
         return v;
       }
-      else
+      default:
       {
         LOG_ERR("unknown value type\n");
-        break;
+        return NULL;
+      }
       }
     }
     return NULL;
@@ -3073,97 +7180,69 @@ extern "C"
 {
 #endif // __cplusplus
 
-  MYTOML_API TomlKey *toml_load_file_name(char *file)
+  MYTOML_API TomlOptions toml_options_default(void)
   {
-    TomlKey *root = _mytoml_value_new_key(TOML_TABLE);
-    memcpy(root->id, "root", strlen("root"));
+    TomlOptions options = {.max_input_size = MYTOML_MAX_FILE_SIZE,
+                           .allocator = NULL};
+    return options;
+  };
 
-    Input input = {.type = I_File, .file.name = file};
-    Tokenizer *tok = _mytoml_new_tokenizer(input);
-    bool ok = _mytoml_tokenizer_load_input(tok);
-    RETURN_IF_FAILED(ok, "Failed to load input from %s\n", input.file.name);
-    _mytoml_tokenizer_next_token(tok);
+  MYTOML_API void toml_set_allocator(const TomlAllocator *allocator)
+  {
+    _mytoml_allocator_global =
+        allocator ? *allocator : _mytoml_allocator_libc;
+  };
 
-    int line, col;
-    TomlKey *key = root;
-    while (_mytoml_tokenizer_has_token(tok) != 0)
-    {
-      key = _mytoml_parser_parse_key_value(tok, key, root);
-      line = tok->line;
-      col = tok->col;
-      FUNC_IF_FAILED(key, _mytoml_tokenizer_delete, tok);
-      FUNC_IF_FAILED(key, toml_free, root);
-      RETURN_IF_FAILED(key,
-                       "Encountered an error while parsing %s\n"
-                       "At line %d column %d\n",
-                       file, line + 1, col);
-    }
+  MYTOML_API TomlKey *toml_load_file_name(char *file)
+  {
+    return toml_load_file_name_opts(file, NULL);
+  };
 
-    _mytoml_tokenizer_delete(tok);
-    return root;
+  MYTOML_API TomlKey *toml_load_file_name_opts(char *file,
+                                               const TomlOptions *options)
+  {
+    Input input = {.type = I_File, .file.name = file};
+    return _mytoml_parser_parse_input(input, options, file);
   };
 
   MYTOML_API TomlKey *toml_load_file(FILE *file)
   {
-    TomlKey *root = _mytoml_value_new_key(TOML_TABLE);
-    memcpy(root->id, "root", strlen("root"));
-
-    Input input = {.type = I_File, .file.pointer = file};
-    Tokenizer *tok = _mytoml_new_tokenizer(input);
-    bool ok = _mytoml_tokenizer_load_input(tok);
-    RETURN_IF_FAILED(ok, "Failed to load input from %s\n", "FILE");
-    _mytoml_tokenizer_next_token(tok);
-
-    int line, col;
-    TomlKey *key = root;
-    while (_mytoml_tokenizer_has_token(tok) != 0)
-    {
-      key = _mytoml_parser_parse_key_value(tok, key, root);
-      line = tok->line;
-      col = tok->col;
-      FUNC_IF_FAILED(key, _mytoml_tokenizer_delete, tok);
-      FUNC_IF_FAILED(key, toml_free, root);
-      RETURN_IF_FAILED(key,
-                       "Encountered an error while parsing %s\n"
-                       "At line %d column %d\n",
-                       "FILE", line + 1, col);
-    }
+    return toml_load_file_opts(file, NULL);
+  };
 
-    _mytoml_tokenizer_delete(tok);
-    return root;
+  MYTOML_API TomlKey *toml_load_file_opts(FILE *file, const TomlOptions *options)
+  {
+    Input input = {.type = I_FILE, .file.pointer = file};
+    return _mytoml_parser_parse_input(input, options, "FILE");
   };
 
   MYTOML_API TomlKey *toml_loads(const char *toml)
   {
-    TomlKey *root = _mytoml_value_new_key(TOML_TABLE);
-    memcpy(root->id, "root", strlen("root"));
-
-    Input input = {.type = I_STREAM, .stream = strdup(toml)};
-    Tokenizer *tok = _mytoml_new_tokenizer(input);
-    _mytoml_tokenizer_next_token(tok);
+    return toml_loadsn(toml, strlen(toml));
+  };
 
-    int line, col;
-    TomlKey *key = root;
-    while (_mytoml_tokenizer_has_token(tok) != 0)
-    {
-      key = _mytoml_parser_parse_key_value(tok, key, root);
-      line = tok->line;
-      col = tok->col;
-      FUNC_IF_FAILED(key, _mytoml_tokenizer_delete, tok);
-      FUNC_IF_FAILED(key, toml_free, root);
-      RETURN_IF_FAILED(key,
-                       "Encountered an error while parsing %s\n"
-                       "At line %d column %d\n",
-                       "FILE", line + 1, col);
-    }
+  MYTOML_API TomlKey *toml_loadsn(const char *toml, size_t len)
+  {
+    return toml_loadsn_opts(toml, len, NULL);
+  };
 
-    _mytoml_tokenizer_delete(tok);
-    return root;
+  MYTOML_API TomlKey *toml_loadsn_opts(const char *toml, size_t len,
+                                       const TomlOptions *options)
+  {
+    // the caller's buffer is parsed in place and never written to,
+    // so it does not need to be NUL terminated
+    Input input = {.type = I_STREAM,
+                   .stream = toml,
+                   .length = len,
+                   .storage = S_BORROWED};
+    return _mytoml_parser_parse_input(input, options, "STRING");
   };
 
   MYTOML_API void toml_key_dump_file(TomlKey *object, FILE *file)
   {
-    fprintf(file, "%s", toml_key_dumps(object));
+    const char *buffer = toml_key_dumps(object);
+    fprintf(file, "%s", buffer);
+    _mytoml_free((void *)buffer);
   };
 
   MYTOML_API void toml_key_dump_file_name(TomlKey *object, const char *file)
@@ -3172,11 +7251,14 @@ extern "C"
     stream = fopen(file, "w");
     const char *buffer = toml_key_dumps(object);
     fwrite(buffer, strlen(buffer), 1, stream);
+    _mytoml_free((void *)buffer);
   };
 
   MYTOML_API void toml_value_dump_file(TomlValue *object, FILE *file)
   {
-    fprintf(file, "%s", toml_value_dumps(object));
+    const char *buffer = toml_value_dumps(object);
+    fprintf(file, "%s", buffer);
+    _mytoml_free((void *)buffer);
   };
 
   MYTOML_API void toml_value_dump_file_name(TomlValue *object, const char *file)
@@ -3185,11 +7267,12 @@ extern "C"
     stream = fopen(file, "w");
     const char *buffer = toml_value_dumps(object);
     fwrite(buffer, strlen(buffer), 1, stream);
+    _mytoml_free((void *)buffer);
   };
 
   MYTOML_API const char *toml_key_dumps(TomlKey *k)
   {
-    char *buffer = "";
+    char *buffer = NULL;
     size_t size = 0;
     toml_key_dump_buffer(k, &buffer, &size);
     return buffer;
@@ -3197,7 +7280,7 @@ extern "C"
 
   MYTOML_API const char *toml_value_dumps(TomlValue *v)
   {
-    char *buffer = "";
+    char *buffer = NULL;
     size_t size = 0;
     toml_value_dump_buffer(v, &buffer, &size);
     return buffer;
@@ -3208,45 +7291,43 @@ extern "C"
     if (k->type == TOML_KEYLEAF && k->value != NULL &&
         k->value->type != TOML_INLINETABLE)
     {
-      _mytoml_append_to_buffer(buffer, size, "\"");
-      _mytoml_string_dump(k->id, buffer, size);
-      _mytoml_append_to_buffer(buffer, size, "\": ");
+      _mytoml_append_string(buffer, size, "\"");
+      _mytoml_string_dump(k->id.str, k->id.len, buffer, size);
+      _mytoml_append_string(buffer, size, "\": ");
       toml_value_dump_buffer(k->value, buffer, size);
     }
     else if (k->type == TOML_ARRAYTABLE)
     {
-      _mytoml_append_to_buffer(buffer, size, "\"");
-      _mytoml_string_dump(k->id, buffer, size);
-      _mytoml_append_to_buffer(buffer, size, "\": [\n");
-      for (size_t i = 0; i <= k->idx; i++)
+      _mytoml_append_string(buffer, size, "\"");
+      _mytoml_string_dump(k->id.str, k->id.len, buffer, size);
+      _mytoml_append_string(buffer, size, "\": [\n");
+      for (size_t i = 0; i < k->value->len; i++)
       {
         toml_value_dump_buffer(k->value->arr[i], buffer, size);
-        if (i != k->idx)
+        if (i + 1 != k->value->len)
         {
-          _mytoml_append_to_buffer(buffer, size, ",\n");
+          _mytoml_append_string(buffer, size, ",\n");
         }
       }
-      _mytoml_append_to_buffer(buffer, size, "\n]");
+      _mytoml_append_string(buffer, size, "\n]");
     }
     else
     {
-      _mytoml_append_to_buffer(buffer, size, "\"");
-      _mytoml_string_dump(k->id, buffer, size);
+      _mytoml_append_string(buffer, size, "\"");
+      _mytoml_string_dump(k->id.str, k->id.len, buffer, size);
 
-      _mytoml_append_to_buffer(buffer, size, "\": {\n");
-      int total = kh_size(k->subkeys);
-      for (khiter_t ki = kh_begin(k->subkeys); ki != kh_end(k->subkeys); ++ki)
+      _mytoml_append_string(buffer, size, "\": {\n");
+      khint32_t total = k->len;
+      size_t it = 0;
+      for (TomlKey *sub; (sub = toml_key_next(k, &it));)
       {
-        if (kh_exist(k->subkeys, ki))
+        toml_key_dump_buffer(sub, buffer, size);
+        if (--total > 0)
         {
-          toml_key_dump_buffer(kh_value(k->subkeys, ki), buffer, size);
-          if (--total > 0)
-          {
-            _mytoml_append_to_buffer(buffer, size, ",\n");
-          }
+          _mytoml_append_string(buffer, size, ",\n");
         }
       }
-      _mytoml_append_to_buffer(buffer, size, "\n}");
+      _mytoml_append_string(buffer, size, "\n}");
     }
   }
 
@@ -3257,134 +7338,93 @@ extern "C"
     {
     case TOML_STRING:
     {
-      _mytoml_append_to_buffer(buffer, size,
-                               "{\"type\": \"string\", \"value\": ");
-      _mytoml_string_dump((char *)v->data, buffer, size);
-      _mytoml_append_to_buffer(buffer, size, "\"}");
+      _mytoml_append_string(buffer, size,
+                            "{\"type\": \"string\", \"value\": \"");
+      _mytoml_string_dump(v->string, v->len, buffer, size);
+      _mytoml_append_string(buffer, size, "\"}");
       break;
     }
     case TOML_FLOAT:
     {
-      _mytoml_append_to_buffer(buffer, size,
-                               "{\"type\": \"float\", \"value\": ");
-      double f = *(double *)(v->data);
-      if (f == (double)INFINITY)
-      {
-        _mytoml_append_to_buffer(buffer, size, "\"}");
-        _mytoml_append_to_buffer(buffer, size, "\"inf\"}");
-      }
-      else if (f == (double)-INFINITY)
-      {
-        _mytoml_append_to_buffer(buffer, size, "\"-inf\"}");
-      }
-      else if (isnan(f))
-      {
-        _mytoml_append_to_buffer(buffer, size, "\"nan\"}");
-      }
-      else if (v->scientific)
-      {
-        _mytoml_append_to_buffer(buffer, size, "\"%g\"}", f);
-      }
-      else if (f == 0.0)
-      {
-        _mytoml_append_to_buffer(buffer, size, "\"0.0\"}");
-      }
-      else
-      {
-        _mytoml_append_to_buffer(buffer, size, "\"%.*lf\"}", (int)v->precision,
-                                 f);
-      }
+      _mytoml_append_string(buffer, size,
+                            "{\"type\": \"float\", \"value\": \"");
+      char buf[MYTOML_NUMBER_FORMAT_SIZE];
+      size_t len = _mytoml_format_float(v->number, v->scientific, buf);
+      _mytoml_append_bytes(buffer, size, buf, len);
+      _mytoml_append_string(buffer, size, "\"}");
       break;
     }
     case TOML_INT:
     {
-      _mytoml_append_to_buffer(buffer, size,
-                               "{\"type\": \"integer\", \"value\": ");
-      _mytoml_append_to_buffer(buffer, size, "\"%.0lf\"}",
-                               *(double *)(v->data));
+      _mytoml_append_string(buffer, size,
+                            "{\"type\": \"integer\", \"value\": \"");
+      char buf[MYTOML_NUMBER_FORMAT_SIZE];
+      size_t len = _mytoml_format_int(v->integer, buf);
+      _mytoml_append_bytes(buffer, size, buf, len);
+      _mytoml_append_string(buffer, size, "\"}");
       break;
     }
     case TOML_BOOL:
     {
-      _mytoml_append_to_buffer(buffer, size,
-                               "{\"type\": \"bool\", \"value\": ");
-      if (*(double *)(v->data))
+      _mytoml_append_string(buffer, size,
+                            "{\"type\": \"bool\", \"value\": ");
+      if (v->boolean)
       {
-        _mytoml_append_to_buffer(buffer, size, "\"true\"}");
+        _mytoml_append_string(buffer, size, "\"true\"}");
       }
       else
       {
-        _mytoml_append_to_buffer(buffer, size, "\"false\"}");
+        _mytoml_append_string(buffer, size, "\"false\"}");
       }
       break;
     }
     case TOML_DATETIME:
-    {
-      _mytoml_append_to_buffer(buffer, size,
-                               "{\"type\": \"datetime\", \"value\": ");
-      char buf[255] = {0};
-      strftime(buf, sizeof(buf), v->format, (struct tm *)v->data);
-      _mytoml_append_to_buffer(buffer, size, "\"%s\"}", buf);
-      break;
-    }
     case TOML_DATETIMELOCAL:
-    {
-      _mytoml_append_to_buffer(buffer, size,
-                               "{\"type\": \"datetime-local\", \"value\": ");
-      char buf[255] = {0};
-      strftime(buf, sizeof(buf), v->format, (struct tm *)v->data);
-      _mytoml_append_to_buffer(buffer, size, "\"%s\"}", buf);
-      break;
-    }
     case TOML_DATELOCAL:
-    {
-      _mytoml_append_to_buffer(buffer, size,
-                               "{\"type\": \"date-local\", \"value\": ");
-      char buf[255] = {0};
-      strftime(buf, sizeof(buf), v->format, (struct tm *)v->data);
-      _mytoml_append_to_buffer(buffer, size, "\"%s\"}", buf);
-      break;
-    }
     case TOML_TIMELOCAL:
     {
-      _mytoml_append_to_buffer(buffer, size,
-                               "{\"type\": \"time-local\", \"value\": ");
-      char buf[255] = {0};
-      strftime(buf, sizeof(buf), v->format, (struct tm *)v->data);
-      _mytoml_append_to_buffer(buffer, size, "\"%s\"}", buf);
+      const char *name = v->type == TOML_DATETIME        ? "datetime"
+                         : v->type == TOML_DATETIMELOCAL ? "datetime-local"
+                         : v->type == TOML_DATELOCAL     ? "date-local"
+                                                         : "time-local";
+      _mytoml_append_string(buffer, size, "{\"type\": \"");
+      _mytoml_append_string(buffer, size, name);
+      _mytoml_append_string(buffer, size, "\", \"value\": \"");
+      char buf[MYTOML_DATETIME_FORMAT_SIZE];
+      size_t len = _mytoml_format_datetime(&v->datetime, buf);
+      _mytoml_append_bytes(buffer, size, buf, len);
+      _mytoml_append_string(buffer, size, "\"}");
       break;
     }
     case TOML_ARRAY:
     {
-      _mytoml_append_to_buffer(buffer, size, "[\n");
-      for (TomlValue **iter = v->arr; *iter != NULL; iter++)
+      _mytoml_append_string(buffer, size, "[\n");
+      for (size_t i = 0; i < v->len; i++)
       {
-        toml_value_dump_buffer(*iter, buffer, size);
-        if (*(iter + 1) != NULL)
+        toml_value_dump_buffer(v->arr[i], buffer, size);
+        if (i + 1 != v->len)
         {
-          _mytoml_append_to_buffer(buffer, size, ",\n");
+          _mytoml_append_string(buffer, size, ",\n");
         }
       }
-      _mytoml_append_to_buffer(buffer, size, "\n]");
+      _mytoml_append_string(buffer, size, "\n]");
       break;
     }
     case TOML_INLINETABLE:
     {
-      _mytoml_append_to_buffer(buffer, size, "{\n");
-      TomlKey *k = (TomlKey *)(v->data);
-      int total = kh_size(k->subkeys);
-      for (khiter_t ki = kh_begin(k->subkeys); ki != kh_end(k->subkeys); ++ki)
+      _mytoml_append_string(buffer, size, "{\n");
+      TomlKey *k = v->table;
+      khint32_t total = k->len;
+      size_t it = 0;
+      for (TomlKey *sub; (sub = toml_key_next(k, &it));)
       {
-        if (kh_exist(k->subkeys, ki))
+        toml_key_dump_buffer(sub, buffer, size);
+        if (--total > 0)
         {
-          toml_key_dump_buffer(kh_value(k->subkeys, ki), buffer, size);
-          if (--total > 0)
-          {
-            _mytoml_append_to_buffer(buffer, size, ",\n");
-          }
+          _mytoml_append_string(buffer, size, ",\n");
         }
       }
-      _mytoml_append_to_buffer(buffer, size, "\n}");
+      _mytoml_append_string(buffer, size, "\n}");
       break;
     }
     default:
@@ -3396,23 +7436,51 @@ extern "C"
   MYTOML_API void toml_json_dump(TomlKey *root)
   {
     printf("{\n");
-    int total = kh_size(root->subkeys);
-    for (khiter_t ki = kh_begin(root->subkeys); ki != kh_end(root->subkeys);
-         ki++)
+    khint32_t total = root->len;
+    size_t it = 0;
+    while (toml_key_next(root, &it))
     {
-      if (kh_exist(root->subkeys, ki))
+      // toml_key_dump_buffer(sub,buffer,size);
+      if (--total > 0)
       {
-        // toml_key_dump_buffer(kh_value(root->subkeys, ki),buffer,size);
-        if (--total > 0)
-        {
-          printf(",\n");
-        }
+        printf(",\n");
       }
     }
     printf("\n}\n");
   }
 
-  MYTOML_API void toml_free(TomlKey *toml) { _mytoml_value_delete_key(toml); }
+  MYTOML_API void toml_free(TomlKey *toml)
+  {
+    if (toml && toml->arena)
+    {
+      _mytoml_arena_delete(toml->arena);
+    }
+  }
+
+  MYTOML_API TomlMemoryStats toml_memory_stats(const TomlKey *root)
+  {
+    TomlMemoryStats stats;
+    memset(&stats, 0, sizeof(stats));
+    if (!root)
+      return stats;
+    _mytoml_stats_key(root, &stats);
+    if (root->arena)
+    {
+      const TomlArena *arena = root->arena;
+      stats.total_bytes = arena->reserved;
+      stats.id_count = arena->ids;
+      stats.id_bytes = arena->id_bytes;
+      size_t used = stats.key_bytes + stats.id_bytes + stats.string_bytes +
+                    stats.table_bytes;
+      for (int t = 0; t < MYTOML_VALUE_TYPE_COUNT; t++)
+      {
+        used += stats.value_bytes[t];
+      }
+      stats.slack_bytes = used < stats.total_bytes ? stats.total_bytes - used
+                                                   : 0;
+    }
+    return stats;
+  }
 
   MYTOML_API int *toml_get_int(TomlKey *key)
   {
@@ -3422,9 +7490,21 @@ extern "C"
       return NULL;
     if (!(key->value->type == TOML_INT))
       return NULL;
-    if (!(key->value->data))
+    int64_t i = key->value->integer;
+    if (i < INT_MIN || i > INT_MAX)
+      return NULL;
+    return &(key->value->narrow);
+  }
+
+  MYTOML_API int64_t *toml_get_int64(TomlKey *key)
+  {
+    if (!key)
+      return NULL;
+    if (!(key->value))
+      return NULL;
+    if (!(key->value->type == TOML_INT))
       return NULL;
-    return (int *)(key->value->data);
+    return &(key->value->integer);
   }
 
   MYTOML_API bool *toml_get_bool(TomlKey *key)
@@ -3435,9 +7515,7 @@ extern "C"
       return NULL;
     if (!(key->value->type == TOML_BOOL))
       return NULL;
-    if (!(key->value->data))
-      return NULL;
-    return (bool *)(key->value->data);
+    return &(key->value->boolean);
   }
 
   MYTOML_API char *toml_get_string(TomlKey *key)
@@ -3448,9 +7526,7 @@ extern "C"
       return NULL;
     if (!(key->value->type == TOML_STRING))
       return NULL;
-    if (!(key->value->data))
-      return NULL;
-    return (char *)(key->value->data);
+    return key->value->string;
   }
 
   MYTOML_API double *toml_get_float(TomlKey *key)
@@ -3461,9 +7537,7 @@ extern "C"
       return NULL;
     if (!(key->value->type == TOML_FLOAT))
       return NULL;
-    if (!(key->value->data))
-      return NULL;
-    return (double *)(key->value->data);
+    return &(key->value->number);
   }
 
   MYTOML_API TomlValue *toml_get_array(TomlKey *key)
@@ -3477,7 +7551,7 @@ extern "C"
     return key->value;
   }
 
-  MYTOML_API struct tm *toml_get_datetime(TomlKey *key)
+  MYTOML_API TomlDatetime *toml_get_datetime(TomlKey *key)
   {
     if (!key)
       return NULL;
@@ -3488,9 +7562,48 @@ extern "C"
           key->value->type == TOML_DATELOCAL ||
           key->value->type == TOML_TIMELOCAL))
       return NULL;
-    if (!(key->value->data))
-      return NULL;
-    return (struct tm *)(key->value->data);
+    return &(key->value->datetime);
+  }
+
+  MYTOML_API bool toml_datetime_epoch_ns(const TomlDatetime *dt, int64_t *out)
+  {
+    const int64_t ns = 1000000000;
+    if (!dt || !out)
+      return false;
+    int64_t seconds = (int64_t)dt->days * 86400 + dt->nanos / ns -
+                      (int64_t)dt->offset * 60;
+    int64_t fraction = dt->nanos % ns;
+    // seconds * ns + fraction must stay within int64_t
+    if (seconds > INT64_MAX / ns ||
+        (seconds == INT64_MAX / ns && fraction > INT64_MAX % ns))
+      return false;
+    if (seconds < INT64_MIN / ns - 1 ||
+        (seconds == INT64_MIN / ns - 1 && fraction < ns + INT64_MIN % ns))
+      return false;
+    *out = seconds < 0 ? (seconds + 1) * ns + (fraction - ns)
+                       : seconds * ns + fraction;
+    return true;
+  }
+
+  MYTOML_API void toml_datetime_fields(const TomlDatetime *dt,
+                                       TomlDatetimeFields *out)
+  {
+    if (!dt || !out)
+      return;
+    memset(out, 0, sizeof(*out));
+    if (dt->flags & MYTOML_DATETIME_DATE)
+    {
+      _mytoml_datetime_civil(dt->days, &out->year, &out->month, &out->day);
+    }
+    if (dt->flags & MYTOML_DATETIME_TIME)
+    {
+      int seconds = (int)(dt->nanos / 1000000000);
+      out->hour = seconds / 3600;
+      out->minute = seconds / 60 % 60;
+      out->second = seconds % 60;
+      out->nanosecond = (int)(dt->nanos % 1000000000);
+    }
+    out->offset = dt->offset;
   }
 
   MYTOML_API TomlKey *toml_get_key(TomlKey *key, const char *id)
@@ -3499,16 +7612,179 @@ extern "C"
     {
       return NULL;
     }
-    if (strcmp(key->id, id) == 0)
+    size_t len = strlen(id);
+    TomlId lookup = {id, (khint32_t)len, _mytoml_id_hash_bytes(id, len)};
+    if (_mytoml_id_equal(key->id, lookup))
     {
       return key;
     }
-    khiter_t k = kh_get(str, key->subkeys, id);
-    if (k != kh_end(key->subkeys))
+    TomlKey *sub = _mytoml_value_has_sub_key(key, lookup);
+    if (sub)
+    {
+      return sub;
+    }
+    LOG_ERR("node %s does not exist in subkeys of node %s", id, key->id.str);
+    return NULL;
+  }
+
+  MYTOML_API TomlFrozen *toml_freeze(const TomlKey *root)
+  {
+    if (!root)
+      return NULL;
+    FrozenBuilder b = {NULL, 0, 0, 0};
+    khint32_t header;
+    bool ok = _mytoml_frozen_reserve(&b, sizeof(TomlFrozen), &header) &&
+              _mytoml_frozen_key(&b, root, offsetof(TomlFrozen, root));
+    if (!ok)
+    {
+      _mytoml_free(b.data);
+      return NULL;
+    }
+    TomlFrozen *doc = (TomlFrozen *)b.data;
+    memcpy(doc->magic, MYTOML_FROZEN_MAGIC, sizeof(doc->magic));
+    doc->version = MYTOML_FROZEN_VERSION;
+    doc->size = (khint32_t)b.size;
+    return doc;
+  }
+
+  MYTOML_API void toml_frozen_free(TomlFrozen *doc) { _mytoml_free(doc); }
+
+  MYTOML_API size_t toml_frozen_size(const TomlFrozen *doc)
+  {
+    return doc ? doc->size : 0;
+  }
+
+  MYTOML_API const TomlFrozen *toml_frozen_load(const void *data, size_t size)
+  {
+    const TomlFrozen *doc = (const TomlFrozen *)data;
+    if (!data || (uintptr_t)data % MYTOML_FROZEN_ALIGN != 0 ||
+        size < sizeof(TomlFrozen) ||
+        memcmp(doc->magic, MYTOML_FROZEN_MAGIC, sizeof(doc->magic)) != 0 ||
+        doc->version != MYTOML_FROZEN_VERSION || doc->size > size ||
+        doc->size < sizeof(TomlFrozen))
+    {
+      LOG_ERR("not a frozen document\n");
+      return NULL;
+    }
+    size_t end = sizeof(TomlFrozen);
+    if (doc->root.type != TOML_INLINETABLE ||
+        !_mytoml_frozen_check(doc, &doc->root, &end, 0) || end != doc->size)
+    {
+      LOG_ERR("corrupt frozen document\n");
+      return NULL;
+    }
+    return doc;
+  }
+
+  MYTOML_API const TomlFrozenNode *toml_frozen_root(const TomlFrozen *doc)
+  {
+    return doc ? &doc->root : NULL;
+  }
+
+  MYTOML_API const TomlFrozenNode *toml_frozen_get(const TomlFrozen *doc,
+                                                   const TomlFrozenNode *table,
+                                                   const char *id)
+  {
+    if (!doc || !table || table->type != TOML_INLINETABLE)
+      return NULL;
+    if (table->len == 0)
+      return NULL;
+    const char *base = (const char *)doc;
+    const khint32_t *index = (const khint32_t *)(base + table->off);
+    // length and hash of `id` in one pass
+    size_t len = 0;
+    khint32_t hash = 0;
+    for (; id[len] != '\0'; len++)
+      hash = (hash << 5) - hash + (khint32_t)(unsigned char)id[len];
+    hash = _mytoml_frozen_mix(hash);
+    // small tables are a single bucket holding every entry
+    khint32_t i = 0, end = table->len;
+    const FrozenEntry *e;
+    if (table->len <= MYTOML_SMALL_TABLE_SIZE)
+    {
+      e = (const FrozenEntry *)((const char *)index +
+                                _mytoml_frozen_index_size(0));
+    }
+    else
+    {
+      khint32_t t = _mytoml_frozen_bucket(hash, index[0]);
+      e = _mytoml_frozen_entries(doc, table);
+      i = index[1 + t];
+      end = index[2 + t];
+    }
+    for (; i < end; i++)
+    {
+      if (e[i].hash == hash && e[i].key_len == len &&
+          memcmp(base + e[i].key, id, len) == 0)
+        return &e[i].value;
+    }
+    return NULL;
+  }
+
+  MYTOML_API const TomlFrozenNode *toml_frozen_at(const TomlFrozen *doc,
+                                                  const TomlFrozenNode *node,
+                                                  size_t i)
+  {
+    if (!doc || !node || i >= node->len)
+      return NULL;
+    const char *base = (const char *)doc;
+    if (node->type == TOML_ARRAY)
+      return (const TomlFrozenNode *)(base + node->off) + i;
+    if (node->type == TOML_INLINETABLE)
+      return &_mytoml_frozen_entries(doc, node)[i].value;
+    return NULL;
+  }
+
+  MYTOML_API const char *toml_frozen_key_at(const TomlFrozen *doc,
+                                            const TomlFrozenNode *table,
+                                            size_t i)
+  {
+    if (!doc || !table || table->type != TOML_INLINETABLE || i >= table->len)
+      return NULL;
+    return (const char *)doc + _mytoml_frozen_entries(doc, table)[i].key;
+  }
+
+  MYTOML_API const char *toml_frozen_string(const TomlFrozen *doc,
+                                            const TomlFrozenNode *node)
+  {
+    if (!doc || !node || node->type != TOML_STRING)
+      return NULL;
+    return (const char *)doc + node->off;
+  }
+
+  MYTOML_API const TomlDatetime *
+  toml_frozen_datetime(const TomlFrozen *doc, const TomlFrozenNode *node)
+  {
+    if (!doc || !node)
+      return NULL;
+    switch (node->type)
+    {
+    case TOML_DATETIME:
+    case TOML_DATELOCAL:
+    case TOML_TIMELOCAL:
+    case TOML_DATETIMELOCAL:
+      return (const TomlDatetime *)((const char *)doc + node->off);
+    default:
+      return NULL;
+    }
+  }
+
+  MYTOML_API TomlKey *toml_key_next(const TomlKey *key, size_t *it)
+  {
+    if (!key)
+      return NULL;
+    if (key->len <= MYTOML_SMALL_TABLE_SIZE)
+    {
+      return *it < key->len ? key->small->keys[(*it)++] : NULL;
+    }
+    const khash_t(id) *h = &key->subkeys->table;
+    for (; *it < kh_end(h); ++*it)
     {
-      return kh_value(key->subkeys, k);
+      if (kh_exist(h, *it))
+      {
+        return kh_value(h, (*it)++);
+      }
     }
-    LOG_ERR("node %s does not exist in subkeys of node %s", id, key->id);
     return NULL;
   }
 
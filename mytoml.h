@@ -117,10 +117,9 @@
 //-----------------------------------------------------------------------------
 
 #include <stdbool.h> //
+#include <stdint.h>  // for int64_t
 #include <stdio.h>   // for FILE
 
-#include "khash.h"
-
 #ifdef __cplusplus
 
 /** C++ Exclusive headers. */
@@ -137,53 +136,76 @@
 //-----------------------------------------------------------------------------
 
 /**
- * @def MYTOML_MAX_DATE_FORMAT
- * @brief Maximum length for date format strings.
- * @note Default is 64 [`2^6`].
+ * @def MYTOML_MAX_FILE_SIZE
+ * @brief Default maximum TOML input size in bytes.
+ * @details Used when no `TomlOptions` are given. It can be changed per parse
+ * with `TomlOptions::max_input_size`.
+ * @note Default is 1073741824 [`2^30`] (1GB).
  */
-#define MYTOML_MAX_DATE_FORMAT 64
+#define MYTOML_MAX_FILE_SIZE 1073741824
 
 /**
- * @def MYTOML_MAX_ID_LENGTH
- * @brief Maximum length for TOML key identifiers.
- * @note Default is 256 [`2^8`].
+ * @def MYTOML_USE_MMAP
+ * @brief Whether `toml_load_file_name` memory-maps regular files.
+ * @details When enabled, regular files are parsed straight from the page
+ * cache instead of being copied into a buffer first. Non-regular files (pipes,
+ * devices) and platforms without mmap fall back to buffered reads.
+ * @note Default is 1 (enabled).
  */
-#define MYTOML_MAX_ID_LENGTH 256
+#define MYTOML_USE_MMAP 1
 
 /**
- * @def MYTOML_MAX_STRING_LENGTH
- * @brief Maximum length for TOML string values.
- * @note Default is 4096 [`2^12`].
+ * @def MYTOML_MMAP_SEQUENTIAL
+ * @brief Whether mapped files are advised with `MADV_SEQUENTIAL`.
+ * @note Default is 1 (enabled).
  */
-#define MYTOML_MAX_STRING_LENGTH 4096
+#define MYTOML_MMAP_SEQUENTIAL 1
 
 /**
- * @def MYTOML_MAX_FILE_SIZE
- * @brief Maximum TOML file size in bytes.
- * @note Default is 1073741824 [`2^30`] (1GB).
+ * @def MYTOML_MMAP_POPULATE
+ * @brief Whether mapped files are prefaulted with `MAP_POPULATE` (Linux).
+ * @note Default is 0 (disabled).
  */
-#define MYTOML_MAX_FILE_SIZE 1073741824
+#define MYTOML_MMAP_POPULATE 0
 
 /**
- * @def MYTOML_MAX_NUM_LINES
- * @brief Maximum number of lines in a TOML file.
- * @note Default is 16777216 [`2^24`].
+ * @def MYTOML_STREAM_CHUNK_SIZE
+ * @brief Size in bytes of the window used to read `FILE*` streams.
+ * @details Streams are consumed incrementally through this window instead of
+ * being read whole, so pipes and sockets parse in bounded memory.
+ * @note Default is 65536 [`2^16`].
  */
-#define MYTOML_MAX_NUM_LINES 16777216
+#define MYTOML_STREAM_CHUNK_SIZE 65536
 
 /**
- * @def MYTOML_MAX_SUBKEYS
- * @brief Maximum number of subkeys per TOML key.
- * @note Default is 131072 [`2^17`].
+ * @def MYTOML_USE_SIMD
+ * @brief Whether comments, whitespace and strings are scanned with SIMD.
+ * @details On x86-64 with GCC or Clang the lexer picks AVX2 or SSE2 at
+ * runtime and skips these runs 32 or 16 bytes at a time. Other targets use the
+ * scalar scanners.
+ * @note Default is 1 (enabled).
  */
-#define MYTOML_MAX_SUBKEYS 131072
+#define MYTOML_USE_SIMD 1
 
 /**
- * @def MYTOML_MAX_ARRAY_LENGTH
- * @brief Maximum length of TOML arrays.
- * @note Default is 131072 [`2^17`].
+ * @def MYTOML_SMALL_TABLE_SIZE
+ * @brief Number of subkeys a key holds before it switches to a hash table.
+ * @details Up to this many subkeys are kept in insertion order in a small
+ * array that is searched by comparing precomputed hashes, four at a time with
+ * SSE2 when available. Keys without subkeys allocate nothing.
+ * @note Default is 8 [`2^3`]. At most 32.
  */
-#define MYTOML_MAX_ARRAY_LENGTH 131072
+#define MYTOML_SMALL_TABLE_SIZE 8
+
+/**
+ * @def MYTOML_ARENA_BLOCK_SIZE
+ * @brief Size in bytes of each block in a document arena.
+ * @details Keys, values and hash tables of a parsed document are carved out
+ * of these blocks. Requests larger than a quarter block get a block of their
+ * own.
+ * @note Default is 65536 [`2^16`].
+ */
+#define MYTOML_ARENA_BLOCK_SIZE 65536
 
 //-----------------------------------------------------------------------------
 // [SECTION] Function Macros
@@ -621,6 +643,12 @@ typedef enum TomlValueType_t
   TOML_DATETIMELOCAL /**< Local datetime value type. */
 } TomlValueType;
 
+/**
+ * @def MYTOML_VALUE_TYPE_COUNT
+ * @brief Number of `TomlValueType` values, for tables indexed by type.
+ */
+#define MYTOML_VALUE_TYPE_COUNT (TOML_DATETIMELOCAL + 1)
+
 /**
  * @enum TomlKeyType
  * @brief Enumerates all TOML key types recognized by the parser.
@@ -671,27 +699,133 @@ typedef enum TomlErrorType
  * @{
  */
 
+/**
+ * @def MYTOML_DATETIME_DATE
+ * @brief `TomlDatetime::flags` bit of a value with a date.
+ */
+#define MYTOML_DATETIME_DATE 0x01
+
+/**
+ * @def MYTOML_DATETIME_TIME
+ * @brief `TomlDatetime::flags` bit of a value with a time of day.
+ */
+#define MYTOML_DATETIME_TIME 0x02
+
+/**
+ * @def MYTOML_DATETIME_OFFSET
+ * @brief `TomlDatetime::flags` bit of a value with a UTC offset.
+ */
+#define MYTOML_DATETIME_OFFSET 0x04
+
+/**
+ * @def MYTOML_DATETIME_ZULU
+ * @brief `TomlDatetime::flags` bit of a zero offset written as `Z`.
+ */
+#define MYTOML_DATETIME_ZULU 0x08
+
+/**
+ * @struct TomlDatetime
+ * @brief A date, a time of day or both, packed into 16 bytes.
+ * @details The date and time are those written in the document, before the
+ * offset is applied. Parts the value does not have are 0.
+ * @see toml_datetime_epoch_ns
+ * @see toml_datetime_fields
+ */
+typedef struct TomlDatetime_t
+{
+  int64_t nanos;  /**< Nanoseconds since midnight. */
+  int32_t days;   /**< Days since 1970-01-01. */
+  int16_t offset; /**< UTC offset in minutes, east of Greenwich positive. */
+  uint8_t flags;  /**< `MYTOML_DATETIME_*` bits of the parts present. */
+  uint8_t digits; /**< Digits written after the point of the seconds. */
+} TomlDatetime;
+
+/**
+ * @struct TomlDatetimeFields
+ * @brief Broken-down fields of a `TomlDatetime`.
+ * @details Fields of the parts the value does not have are 0.
+ */
+typedef struct TomlDatetimeFields_t
+{
+  int year;       /**< Year, 0 to 9999. */
+  int month;      /**< Month, 1 to 12. */
+  int day;        /**< Day of the month, 1 to 31. */
+  int hour;       /**< Hour, 0 to 23. */
+  int minute;     /**< Minute, 0 to 59. */
+  int second;     /**< Second, 0 to 59. */
+  int nanosecond; /**< Nanoseconds, 0 to 999999999. */
+  int offset;     /**< UTC offset in minutes. */
+} TomlDatetimeFields;
+
+typedef struct TomlKey_t TomlKey;
+
 /**
  * @struct TomlValue
  * @brief Represents a TOML value and its associated metadata.
- * @details Used to store any TOML value type, including arrays, numbers,
- * strings, and datetimes.
+ * @details A tagged union: `type` tells which member holds the value.
+ * Numbers, booleans and datetimes are stored inline, strings and arrays are a
+ * pointer and a length, inline tables point to their own node. Arrays double
+ * from `MYTOML_ARRAY_MIN_CAPACITY` slots, so `len` also gives their capacity.
  */
 typedef struct TomlValue_t TomlValue;
 struct TomlValue_t
 {
-  TomlValueType type; /**< Type of TOML value. */
-  TomlValue **arr;    /**< Array of TOML values (for TOML_ARRAY type). */
-  int len;            /**< Length of array or value. */
-  void *data;         /**< Pointer to value data (non-array types). */
-  int precision;      /**< Numeric precision for floating-point values. */
-  bool scientific;    /**< Whether to print numbers in scientific notation. */
-  char
-      format[MYTOML_MAX_DATE_FORMAT]; /**< Format string for datetime values. */
+  TomlValueType type;       /**< Type of TOML value. */
+  unsigned short precision; /**< Digits after the point of a float. */
+  bool scientific;          /**< Whether a float is printed with an exponent. */
+  union
+  {
+    size_t len;             /**< Bytes in `string` or values in `arr`. */
+    int narrow;             /**< TOML_INT value as an `int`, when it fits. */
+  };
+  union
+  {
+    int64_t integer;        /**< TOML_INT value. */
+    double number;          /**< TOML_FLOAT value. */
+    bool boolean;           /**< TOML_BOOL value. */
+    char *string;           /**< TOML_STRING bytes, followed by a NUL. */
+    TomlValue **arr;        /**< TOML_ARRAY values. */
+    TomlKey *table;         /**< TOML_INLINETABLE keys. */
+    TomlDatetime datetime;  /**< Value of the datetime types. */
+  };
 };
 
 /** @} */
 
+/**
+ * @name TomlArena data type
+ * @{
+ */
+
+/**
+ * @struct TomlArena
+ * @brief Opaque bump allocator that owns all memory of a parsed document.
+ */
+typedef struct TomlArena_t TomlArena;
+
+/** @} */
+
+/**
+ * @name TomlId data type
+ * @{
+ */
+
+/**
+ * @struct TomlId
+ * @brief Key identifier stored as a pointer, a length and a hash.
+ * @details The bytes live in the document arena and are followed by a NUL,
+ * so `str` can also be printed as a C string. Ids are interned while a
+ * document is parsed, so equal ids of one document share the same `str`.
+ */
+typedef struct TomlId_t
+{
+  const char *str; /**< Identifier bytes. */
+  uint32_t len;    /**< Length of `str` in bytes, without the NUL. */
+  uint32_t hash;   /**< X31 hash of `str`. */
+} TomlId;
+
+/** @} */
+
 /**
  * @name TomlKey data type
  * @{
@@ -701,17 +835,41 @@ struct TomlValue_t
  * @struct TomlKey
  * @brief Represents a TOML key node in the parsed AST.
  * @details Each TOML key or table is represented as a TomlKey, with subkeys and
- * associated value.
+ * associated value. Use `toml_key_next` to visit the subkeys.
  */
-typedef struct TomlKey_t TomlKey;
-KHASH_MAP_INIT_STR(str, TomlKey *)
+/**
+ * @struct TomlSmallTable
+ * @brief Subkeys of a key with at most `MYTOML_SMALL_TABLE_SIZE` of them.
+ * @details Hashes are kept apart from the keys so they can be compared
+ * several at a time.
+ */
+typedef struct TomlSmallTable_t
+{
+  uint32_t hash[MYTOML_SMALL_TABLE_SIZE]; /**< `id.hash` of each subkey. */
+  TomlKey *keys[MYTOML_SMALL_TABLE_SIZE]; /**< Subkeys, in insertion order. */
+} TomlSmallTable;
+
+/**
+ * @struct TomlKeyTable
+ * @brief Opaque hash table of the subkeys of a key with more than
+ * `MYTOML_SMALL_TABLE_SIZE` of them.
+ * @details Visit it with `toml_key_next`.
+ */
+typedef struct TomlKeyTable_t TomlKeyTable;
+
 struct TomlKey_t
 {
-  TomlKeyType type;              /**< Type of TOML key. */
-  char id[MYTOML_MAX_ID_LENGTH]; /**< Key identifier string. */
-  khash_t(str) * subkeys;        /**< Hash map of subkeys. */
-  TomlValue *value;              /**< Value associated with this key. */
-  size_t idx;                    /**< Index for array tables. */
+  TomlKeyType type; /**< Type of TOML key. */
+  uint32_t len;     /**< Number of subkeys. */
+  TomlId id;        /**< Key identifier. */
+  union
+  {
+    TomlSmallTable *small; /**< Subkeys while `len` is at most
+                              `MYTOML_SMALL_TABLE_SIZE`, NULL for none. */
+    TomlKeyTable *subkeys; /**< Subkeys once there are more. */
+  };
+  TomlValue *value; /**< Value associated with this key. */
+  TomlArena *arena; /**< Document memory, set on the root only. */
 };
 
 /** @} */
@@ -736,6 +894,121 @@ typedef struct TomlError_t
 
 /** @} */
 
+/**
+ * @name TomlAllocator data type
+ * @{
+ */
+
+/**
+ * @struct TomlAllocator
+ * @brief Memory functions the library allocates through.
+ * @details Every function gets `ctx` as its last argument. `realloc_fn` and
+ * `free_fn` are only handed blocks that came from the same allocator, and
+ * `free_fn` is never handed NULL.
+ */
+typedef struct TomlAllocator_t
+{
+  void *(*malloc_fn)(size_t size, void *ctx);             /**< Allocate. */
+  void *(*realloc_fn)(void *ptr, size_t size, void *ctx); /**< Resize. */
+  void (*free_fn)(void *ptr, void *ctx);                  /**< Release. */
+  void *ctx; /**< User context passed to each function. */
+} TomlAllocator;
+
+/** @} */
+
+/**
+ * @name TomlOptions data type
+ * @{
+ */
+
+/**
+ * @struct TomlOptions
+ * @brief Options that apply to a single parse.
+ * @details Start from `toml_options_default()` and change the fields you
+ * need, so new fields keep their defaults.
+ */
+typedef struct TomlOptions_t
+{
+  size_t max_input_size; /**< Maximum input size in bytes, 0 for no limit. */
+  const TomlAllocator *allocator; /**< Allocator for this parse and the
+                                     document it returns, NULL to use the
+                                     one set with `toml_set_allocator`. */
+} TomlOptions;
+
+/** @} */
+
+/**
+ * @name TomlMemoryStats data type
+ * @{
+ */
+
+/**
+ * @struct TomlMemoryStats
+ * @brief Where the memory of a parsed document goes.
+ * @details Byte counts include the alignment padding of each allocation. The
+ * categories add up to `total_bytes`, with `slack_bytes` as the remainder.
+ */
+typedef struct TomlMemoryStats_t
+{
+  size_t total_bytes;  /**< Bytes the document holds from its allocator. */
+  size_t key_count;    /**< Keys, the root and inline table keys included. */
+  size_t key_bytes;    /**< Bytes of the key nodes. */
+  size_t id_count;     /**< Distinct key ids. */
+  size_t id_bytes;     /**< Bytes of key id text. */
+  size_t value_count[MYTOML_VALUE_TYPE_COUNT]; /**< Values by type. */
+  size_t value_bytes[MYTOML_VALUE_TYPE_COUNT]; /**< Bytes of the value nodes
+                                                  by type, with array
+                                                  slots. */
+  size_t string_bytes; /**< Bytes of string value text. */
+  size_t small_count;  /**< Subkey tables in `TomlSmallTable` form. */
+  size_t table_count;  /**< Subkey tables promoted to hash tables. */
+  size_t bucket_count; /**< Buckets allocated across the hash tables. */
+  size_t table_bytes;  /**< Bytes of both kinds of tables. */
+  size_t slack_bytes;  /**< Bytes held but not in use: block headers, unused
+                          block tails, padding, and buffers left behind by
+                          growth or by parsing. */
+} TomlMemoryStats;
+
+/** @} */
+
+/**
+ * @name TomlFrozen data type
+ * @{
+ */
+
+/**
+ * @struct TomlFrozen
+ * @brief Opaque read-only document packed into one buffer by `toml_freeze`.
+ * @details Nodes refer to each other by 32-bit offsets from the start of the
+ * buffer, so it can be copied, written out and read back with
+ * `toml_frozen_load`.
+ */
+typedef struct TomlFrozen_t TomlFrozen;
+
+/**
+ * @struct TomlFrozenNode
+ * @brief One value of a frozen document.
+ * @details Tables, inline or not, have the type `TOML_INLINETABLE`. An array
+ * of tables is a `TOML_ARRAY` of them. Numbers and booleans are read straight
+ * from the node, everything else through the `toml_frozen_*` accessors.
+ */
+typedef struct TomlFrozenNode_t
+{
+  TomlValueType type; /**< Type of the value. */
+  uint32_t len;      /**< Bytes of a string, values of an array or entries
+                         of a table. */
+  union
+  {
+    int64_t integer; /**< TOML_INT value. */
+    double number;   /**< TOML_FLOAT value. */
+    bool boolean;    /**< TOML_BOOL value. */
+    uint32_t off;  /**< Offset of the string bytes, the array values, the
+                       table index or the datetime. */
+  };
+} TomlFrozenNode;
+
+/** @} */
+
 /** @} */
 
 //-----------------------------------------------------------------------------
@@ -762,15 +1035,41 @@ extern "C"
    */
   MYTOML_API TomlKey *toml_load_file_name(char *file);
 
+  /**
+   * @brief Load and parse a TOML file from a filename with options.
+   * @param[in] file Path to TOML file.
+   * @param[in] options Parse options, or NULL for the defaults.
+   * @return Pointer to root TomlKey object, or NULL on failure.
+   * @note Frees memory with toml_free().
+   * @see toml_load_file_name
+   */
+  MYTOML_API TomlKey *toml_load_file_name_opts(char *file,
+                                               const TomlOptions *options);
+
   /**
    * @brief Load and parse a TOML file from a FILE pointer.
    * @param[in] file FILE pointer to TOML file.
    * @return Pointer to root TomlKey object, or NULL on failure.
+   * @note The stream is read incrementally from its current position and is
+   * never seeked, so pipes, sockets and `stdin` are supported. It is not
+   * closed.
    * @note Frees memory with toml_free().
    * @see toml_free
    */
   MYTOML_API TomlKey *toml_load_file(FILE *file);
 
+  /**
+   * @brief Load and parse a TOML file from a FILE pointer with options.
+   * @param[in] file FILE pointer to TOML file.
+   * @param[in] options Parse options, or NULL for the defaults.
+   * @return Pointer to root TomlKey object, or NULL on failure.
+   * @note At most one byte past `max_input_size` is read from the stream.
+   * @note Frees memory with toml_free().
+   * @see toml_load_file
+   */
+  MYTOML_API TomlKey *toml_load_file_opts(FILE *file,
+                                          const TomlOptions *options);
+
   /**
    * @brief Parse TOML from a string.
    * @param[in] toml TOML string to parse.
@@ -780,6 +1079,47 @@ extern "C"
    */
   MYTOML_API TomlKey *toml_loads(const char *toml);
 
+  /**
+   * @brief Parse TOML from a length-delimited buffer without copying it.
+   * @param[in] toml Buffer holding the TOML document.
+   * @param[in] len Number of bytes of @p toml to parse.
+   * @return Pointer to root TomlKey object, or NULL on failure.
+   * @note The buffer is read in place, so it does not need to be NUL
+   * terminated and may be a slice of a larger buffer. It is only accessed
+   * while this call runs and is never written to.
+   * @note Frees memory with toml_free().
+   * @see toml_free
+   */
+  MYTOML_API TomlKey *toml_loadsn(const char *toml, size_t len);
+
+  /**
+   * @brief Parse TOML from a length-delimited buffer with options.
+   * @param[in] toml Buffer holding the TOML document.
+   * @param[in] len Number of bytes of @p toml to parse.
+   * @param[in] options Parse options, or NULL for the defaults.
+   * @return Pointer to root TomlKey object, or NULL on failure.
+   * @note Frees memory with toml_free().
+   * @see toml_loadsn
+   */
+  MYTOML_API TomlKey *toml_loadsn_opts(const char *toml, size_t len,
+                                       const TomlOptions *options);
+
+  /**
+   * @brief Get the default parse options.
+   * @return Options with every field set to its default.
+   */
+  MYTOML_API TomlOptions toml_options_default(void);
+
+  /**
+   * @brief Set the allocator used when a parse is given none.
+   * @param[in] allocator Allocator to copy, or NULL to go back to `malloc`,
+   * `realloc` and `free`.
+   * @details Also used for the buffers returned by the dump functions, which
+   * must be released with its `free_fn`.
+   * @note Not thread-safe. Set it before any thread parses or dumps.
+   */
+  MYTOML_API void toml_set_allocator(const TomlAllocator *allocator);
+
   /**
    * @brief Dump TOML key to a FILE stream.
    * @param[in] object TOML key to dump.
@@ -819,7 +1159,7 @@ extern "C"
    * @param[in] k TOML key to serialize.
    * @return Pointer to string buffer (must be freed by caller).
    * @warning The returned string must be freed by the caller to avoid memory
-   * leaks.
+   * leaks, with the `free_fn` of the allocator set by `toml_set_allocator`.
    */
   MYTOML_API const char *toml_key_dumps(TomlKey *k);
 
@@ -828,7 +1168,7 @@ extern "C"
    * @param[in] v TOML value to serialize.
    * @return Pointer to string buffer (must be freed by caller).
    * @warning The returned string must be freed by the caller to avoid memory
-   * leaks.
+   * leaks, with the `free_fn` of the allocator set by `toml_set_allocator`.
    */
   MYTOML_API const char *toml_value_dumps(TomlValue *v);
 
@@ -860,17 +1200,41 @@ extern "C"
   MYTOML_API void toml_key_dump(TomlKey *root);
 
   /**
-   * @brief Free memory allocated for a TomlKey object and all its children.
-   * @param[in] toml Pointer to TomlKey object to free.
+   * @brief Free a parsed document and everything in it.
+   * @param[in] toml Root key returned by one of the load functions.
+   * @details All keys, values and strings of a document live in one arena, so
+   * this releases the whole document at once. Pointers into the document are
+   * invalid afterwards. Passing a key other than the root does nothing.
    */
   MYTOML_API void toml_free(TomlKey *toml);
 
+  /**
+   * @brief Report the memory use of a parsed document.
+   * @param[in] root Root key returned by one of the load functions.
+   * @return Counts and bytes by category, all zero when `root` is NULL.
+   * @details Walks the document and reads the totals its arena keeps, so the
+   * cost is one pass over the keys and values. Given a key other than the
+   * root, reports that subtree with `total_bytes`, `id_count`, `id_bytes` and
+   * `slack_bytes` left at 0.
+   */
+  MYTOML_API TomlMemoryStats toml_memory_stats(const TomlKey *root);
+
   /**
    * @brief Get integer value from TOML key.
    * @param[in] key TOML key to query.
+   * @return Pointer to integer value, or NULL if not an integer or if the
+   * value does not fit in an `int`. It points to a copy kept for this
+   * function, so writes through it are not seen by toml_get_int64().
+   * @deprecated Use toml_get_int64(), which covers the whole TOML range.
+   */
+  MYTOML_API MYTOML_DEPRECATED_ATTR int *toml_get_int(TomlKey *key);
+
+  /**
+   * @brief Get 64-bit integer value from TOML key.
+   * @param[in] key TOML key to query.
    * @return Pointer to integer value, or NULL if not an integer.
    */
-  MYTOML_API int *toml_get_int(TomlKey *key);
+  MYTOML_API int64_t *toml_get_int64(TomlKey *key);
 
   /**
    * @brief Get boolean value from TOML key.
@@ -903,9 +1267,28 @@ extern "C"
   /**
    * @brief Get datetime value from TOML key.
    * @param[in] key TOML key to query.
-   * @return Pointer to struct tm value, or NULL if not a datetime.
+   * @return Pointer to TomlDatetime value, or NULL if not a datetime.
+   */
+  MYTOML_API TomlDatetime *toml_get_datetime(TomlKey *key);
+
+  /**
+   * @brief Nanoseconds since the Unix epoch of a datetime.
+   * @param[in] dt Datetime to convert.
+   * @param[out] out Nanoseconds since 1970-01-01T00:00:00Z.
+   * @return false if the instant is out of the `int64_t` range, years 1677 to
+   * 2262.
+   * @note Local dates and datetimes are taken as UTC, a local time gives the
+   * nanoseconds since midnight.
    */
-  MYTOML_API struct tm *toml_get_datetime(TomlKey *key);
+  MYTOML_API bool toml_datetime_epoch_ns(const TomlDatetime *dt, int64_t *out);
+
+  /**
+   * @brief Broken-down fields of a datetime.
+   * @param[in] dt Datetime to split.
+   * @param[out] out Fields as written in the document.
+   */
+  MYTOML_API void toml_datetime_fields(const TomlDatetime *dt,
+                                       TomlDatetimeFields *out);
 
   /**
    * @brief Find a subkey by identifier.
@@ -915,6 +1298,132 @@ extern "C"
    */
   MYTOML_API TomlKey *toml_get_key(TomlKey *key, const char *id);
 
+  /**
+   * @brief Step through the subkeys of a TOML key.
+   * @param[in] key TOML key whose subkeys to visit.
+   * @param[in,out] it Iterator, set to 0 before the first call.
+   * @return Next subkey, or NULL once all of them were returned.
+   * @details Small tables are visited in insertion order, larger ones in
+   * hash order. The elements of an array of tables are the `table` keys of
+   * its `value->arr`, not subkeys of the key itself.
+   * @code
+   * size_t it = 0;
+   * for (TomlKey *sub; (sub = toml_key_next(key, &it));)
+   *   puts(sub->id.str);
+   * @endcode
+   */
+  MYTOML_API TomlKey *toml_key_next(const TomlKey *key, size_t *it);
+
+  /** @} */
+
+  /**
+   * @name Frozen documents
+   * @{
+   */
+
+  /**
+   * @brief Pack a parsed document into one read-only buffer.
+   * @param[in] root Root key returned by one of the load functions.
+   * @return Frozen document, or NULL when out of memory, when it would not
+   * fit 32-bit offsets or when arrays and tables nest more than 1024 deep.
+   * Free it with `toml_frozen_free`.
+   * @details Keys of every table are sorted by their hash and bucketed by
+   * its top bits, about one key per bucket, behind an index of where each
+   * bucket starts. A lookup reads the index and compares the few entries of
+   * one bucket; tables of up to `MYTOML_SMALL_TABLE_SIZE` keys are a single
+   * bucket scanned in turn. The values of arrays and tables are stored next
+   * to each other. `root` is left untouched and can be freed.
+   */
+  MYTOML_API TomlFrozen *toml_freeze(const TomlKey *root);
+
+  /**
+   * @brief Free a document returned by `toml_freeze`.
+   * @param[in] doc Frozen document, may be NULL.
+   */
+  MYTOML_API void toml_frozen_free(TomlFrozen *doc);
+
+  /**
+   * @brief Size of a frozen document in bytes.
+   * @param[in] doc Frozen document.
+   * @return Bytes to copy when moving or saving the document.
+   */
+  MYTOML_API size_t toml_frozen_size(const TomlFrozen *doc);
+
+  /**
+   * @brief Use a copy of a frozen document.
+   * @param[in] data Bytes of a document made by `toml_freeze` with the same
+   * build of the library, aligned to 8 bytes.
+   * @param[in] size Number of bytes at `data`.
+   * @return `data` as a frozen document, or NULL when it is not one.
+   * @details Every offset, length, bucket and key hash is checked against the
+   * layout `toml_freeze` writes, in one pass over the document, so `data`
+   * may come from an untrusted source. Documents of another layout version
+   * are refused.
+   */
+  MYTOML_API const TomlFrozen *toml_frozen_load(const void *data, size_t size);
+
+  /**
+   * @brief Root table of a frozen document.
+   * @param[in] doc Frozen document.
+   * @return Root node.
+   */
+  MYTOML_API const TomlFrozenNode *toml_frozen_root(const TomlFrozen *doc);
+
+  /**
+   * @brief Find a key in a frozen table.
+   * @param[in] doc Frozen document.
+   * @param[in] table Table node to search.
+   * @param[in] id Key to look up.
+   * @return Value of the key, or NULL if `table` is not a table or has no
+   * such key.
+   */
+  MYTOML_API const TomlFrozenNode *toml_frozen_get(const TomlFrozen *doc,
+                                                   const TomlFrozenNode *table,
+                                                   const char *id);
+
+  /**
+   * @brief Value at a position of a frozen array or table.
+   * @param[in] doc Frozen document.
+   * @param[in] node Array or table node.
+   * @param[in] i Position, below `node->len`.
+   * @return Element `i` of an array or the value of entry `i` of a table, or
+   * NULL when out of range.
+   */
+  MYTOML_API const TomlFrozenNode *toml_frozen_at(const TomlFrozen *doc,
+                                                  const TomlFrozenNode *node,
+                                                  size_t i);
+
+  /**
+   * @brief Key at a position of a frozen table.
+   * @param[in] doc Frozen document.
+   * @param[in] table Table node.
+   * @param[in] i Position, below `table->len`.
+   * @return Key of entry `i`, or NULL when out of range. Entries are in hash
+   * order, not in document or alphabetical order.
+   */
+  MYTOML_API const char *toml_frozen_key_at(const TomlFrozen *doc,
+                                            const TomlFrozenNode *table,
+                                            size_t i);
+
+  /**
+   * @brief String of a frozen node.
+   * @param[in] doc Frozen document.
+   * @param[in] node Node to read.
+   * @return Bytes of the string, `node->len` long and followed by a NUL, or
+   * NULL if not a string.
+   */
+  MYTOML_API const char *toml_frozen_string(const TomlFrozen *doc,
+                                            const TomlFrozenNode *node);
+
+  /**
+   * @brief Datetime of a frozen node.
+   * @param[in] doc Frozen document.
+   * @param[in] node Node to read.
+   * @return Pointer to TomlDatetime value, or NULL if not a datetime.
+   */
+  MYTOML_API const TomlDatetime *
+  toml_frozen_datetime(const TomlFrozen *doc, const TomlFrozenNode *node);
+
   /** @} */
 
 #ifdef __cplusplus
@@ -0,0 +1,101 @@
+/*
+    Every allocation of a parse may fail. Whichever one does, the
+    parse returns NULL, and everything it took from the allocator
+    is handed back.
+*/
+
+#include "check.h"
+#include "mytoml.h"
+
+#include <stdio.h>  // for snprintf
+#include <stdlib.h> // for malloc
+#include <string.h> // for strcmp
+
+typedef struct Budget
+{
+  long left;  // allocations that still succeed
+  long calls; // allocations asked for
+  long live;  // blocks not yet freed
+} Budget;
+
+static void *budget_malloc(size_t size, void *ctx)
+{
+  Budget *b = (Budget *)ctx;
+  b->calls++;
+  if (b->left-- <= 0)
+    return NULL;
+  void *p = malloc(size);
+  b->live += p != NULL;
+  return p;
+}
+
+static void *budget_realloc(void *ptr, size_t size, void *ctx)
+{
+  Budget *b = (Budget *)ctx;
+  b->calls++;
+  if (b->left-- <= 0)
+    return NULL;
+  void *p = realloc(ptr, size);
+  b->live += p != NULL && ptr == NULL;
+  return p;
+}
+
+static void budget_free(void *ptr, void *ctx)
+{
+  ((Budget *)ctx)->live--;
+  free(ptr);
+}
+
+int main(void)
+{
+  // arrays that grow, more than MYTOML_SMALL_TABLE_SIZE keys, escapes,
+  // inline tables, arrays of tables and every value type
+  static char text[1 << 16];
+  size_t len = 0;
+  len += (size_t)snprintf(text + len, sizeof(text) - len,
+                          "title = \"a\\tb\"\n[[fruit]]\nname = 'x'\n"
+                          "[[fruit]]\nname = \"y\"\n");
+  for (int i = 0; i < 60; i++)
+    len += (size_t)snprintf(
+        text + len, sizeof(text) - len,
+        "[t%d]\na = %d\nb = 1.5\nc = \"s%d\\n\"\nd = 1979-05-27T07:32:00Z\n"
+        "e = [1, [2, 3], {x = 1, y = 'z'}]\nf = {p = true, q.r = 2}\n"
+        "g = 1\nh = 2\ni = 3\nj = 4\nk = 5\nl = 6\nm = 7\n",
+        i, i, i);
+
+  Budget budget = {0, 0, 0};
+  TomlAllocator allocator = {budget_malloc, budget_realloc, budget_free,
+                             &budget};
+  TomlOptions options = toml_options_default();
+  options.allocator = &allocator;
+
+  // a parse with no failure counts the allocations and gives the
+  // same document as one on the default allocator
+  budget.left = 1L << 30;
+  TomlKey *root = toml_loadsn_opts(text, len, &options);
+  CHECK(root);
+  long total = budget.calls;
+  CHECK(total > 0);
+  TomlKey *reference = toml_loadsn(text, len);
+  const char *expected = reference ? toml_key_dumps(reference) : NULL;
+  const char *dump = root ? toml_key_dumps(root) : NULL;
+  CHECK(dump && expected && strcmp(dump, expected) == 0);
+  free((void *)dump);
+  free((void *)expected);
+  toml_free(reference);
+  toml_free(root);
+  CHECK(budget.live == 0);
+
+  for (long fail = 0; fail < total; fail++)
+  {
+    budget.left = fail;
+    budget.calls = 0;
+    budget.live = 0;
+    root = toml_loadsn_opts(text, len, &options);
+    CHECK(root == NULL);
+    toml_free(root);
+    CHECK(budget.live == 0);
+  }
+
+  return CHECK_RESULT();
+}
@@ -0,0 +1,75 @@
+/*
+    Arrays grow as they are filled, with no cap on their length:
+    inline arrays, nested arrays and arrays of tables well past the
+    131072 slots arrays used to be limited to.
+*/
+
+#include "check.h"
+#include "mytoml.h"
+
+#include <stdio.h>  // for sprintf
+#include <stdlib.h> // for malloc
+#include <string.h> // for strcmp
+
+#define MANY 200000
+
+int main(void)
+{
+  char *text = (char *)malloc((size_t)MANY * 48);
+  CHECK(text);
+  if (!text)
+    return CHECK_RESULT();
+
+  // a long inline array of integers, then of strings and nested arrays
+  size_t len = (size_t)sprintf(text, "a = [");
+  for (int i = 0; i < MANY; i++)
+    len += (size_t)sprintf(text + len, "%d,", i);
+  len += (size_t)sprintf(text + len, "]\nb = [\n");
+  for (int i = 0; i < MANY; i++)
+    len += (size_t)sprintf(text + len, "  ['s%d', [%d]],\n", i, i);
+  len += (size_t)sprintf(text + len, "]\n");
+  TomlKey *root = toml_loadsn(text, len);
+  CHECK(root);
+  TomlKey *a = root ? toml_get_key(root, "a") : NULL;
+  CHECK(a && a->value->type == TOML_ARRAY && a->value->len == MANY);
+  for (int i = 0; a && i < MANY; i++)
+  {
+    if (a->value->arr[i]->integer != i)
+    {
+      CHECK(a->value->arr[i]->integer == i);
+      break;
+    }
+  }
+  TomlKey *b = root ? toml_get_key(root, "b") : NULL;
+  CHECK(b && b->value->len == MANY);
+  if (b && b->value->len == MANY)
+  {
+    TomlValue *last = b->value->arr[MANY - 1];
+    CHECK(last->type == TOML_ARRAY && last->len == 2);
+    CHECK(last->arr[1]->arr[0]->integer == MANY - 1);
+    char expected[16];
+    sprintf(expected, "s%d", MANY - 1);
+    CHECK(strcmp(last->arr[0]->string, expected) == 0);
+  }
+  TomlMemoryStats stats = root ? toml_memory_stats(root) : (TomlMemoryStats){0};
+  CHECK(stats.value_count[TOML_ARRAY] == 2 + 2 * (size_t)MANY);
+  toml_free(root);
+
+  // an array of tables grows the same way
+  len = 0;
+  for (int i = 0; i < MANY; i++)
+    len += (size_t)sprintf(text + len, "[[t]]\nv = %d\n", i);
+  root = toml_loadsn(text, len);
+  CHECK(root);
+  TomlKey *t = root ? toml_get_key(root, "t") : NULL;
+  CHECK(t && t->value->len == MANY);
+  if (t && t->value->len == MANY)
+  {
+    TomlKey *v = toml_get_key(t->value->arr[MANY - 1]->table, "v");
+    CHECK(v && *toml_get_int64(v) == MANY - 1);
+  }
+  toml_free(root);
+  free(text);
+
+  return CHECK_RESULT();
+}
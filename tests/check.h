@@ -0,0 +1,28 @@
+/*
+    Checks shared by the tests. A failed `CHECK` prints where it
+    failed and is counted, so one run reports every failure, and
+    `CHECK_RESULT` gives the exit code ctest looks at.
+*/
+
+#ifndef MYTOML_TESTS_CHECK_H
+#define MYTOML_TESTS_CHECK_H
+
+#include <stdio.h> // for fprintf
+
+static int check_failures = 0;
+
+#define CHECK(COND)                                                            \
+  do                                                                           \
+  {                                                                            \
+    if (!(COND))                                                               \
+    {                                                                          \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #COND); \
+      check_failures++;                                                        \
+    }                                                                          \
+  } while (0)
+
+#define CHECK_RESULT()                                                         \
+  (check_failures ? (fprintf(stderr, "%d checks failed\n", check_failures), 1) \
+                  : 0)
+
+#endif // MYTOML_TESTS_CHECK_H
@@ -0,0 +1,124 @@
+/*
+    The packed datetime value: fields, offsets in minutes,
+    nanoseconds and the conversion to nanoseconds since the epoch
+    at the edges of the int64_t range.
+*/
+
+#include "check.h"
+#include "mytoml.h"
+
+#include <stdint.h> // for INT64_MAX
+#include <stdio.h>  // for snprintf
+#include <stdlib.h> // for free
+#include <string.h> // for strstr
+
+// parses `x = text` into `out`, returns its type or -1 if not a datetime
+static int parse_datetime(const char *text, TomlDatetime *out)
+{
+  char doc[128];
+  snprintf(doc, sizeof(doc), "x = %s\n", text);
+  TomlKey *root = toml_loads(doc);
+  TomlKey *key = root ? toml_get_key(root, "x") : NULL;
+  TomlDatetime *dt = key ? toml_get_datetime(key) : NULL;
+  int type = dt ? (int)key->value->type : -1;
+  if (dt)
+    *out = *dt;
+  toml_free(root);
+  return type;
+}
+
+int main(void)
+{
+  static const struct
+  {
+    const char *text;
+    int type;
+    int year, month, day, hour, minute, second, nanosecond, offset;
+    bool epoch;
+    int64_t ns;
+  } valid[] = {
+      {"1979-05-27T07:32:00Z", TOML_DATETIME, 1979, 5, 27, 7, 32, 0, 0, 0, true,
+       296638320000000000},
+      {"1979-05-27 07:32:00z", TOML_DATETIME, 1979, 5, 27, 7, 32, 0, 0, 0, true,
+       296638320000000000},
+      {"1979-05-27T00:32:00.999999-07:00", TOML_DATETIME, 1979, 5, 27, 0, 32, 0,
+       999999000, -420, true, 296638320999999000},
+      {"1970-01-01T00:00:00+01:00", TOML_DATETIME, 1970, 1, 1, 0, 0, 0, 0, 60,
+       true, -3600000000000},
+      {"1970-01-01T05:30:00+05:30", TOML_DATETIME, 1970, 1, 1, 5, 30, 0, 0, 330,
+       true, 0},
+      {"1979-05-27T07:32:00+23:59", TOML_DATETIME, 1979, 5, 27, 7, 32, 0, 0,
+       1439, true, 296551980000000000},
+      {"2024-02-29T12:00:00-00:00", TOML_DATETIME, 2024, 2, 29, 12, 0, 0, 0, 0,
+       true, 1709208000000000000},
+      // the first and last instants an int64_t of nanoseconds holds
+      {"2262-04-11T23:47:16.854775807Z", TOML_DATETIME, 2262, 4, 11, 23, 47,
+       16, 854775807, 0, true, INT64_MAX},
+      {"1677-09-21T00:12:43.145224192Z", TOML_DATETIME, 1677, 9, 21, 0, 12, 43,
+       145224192, 0, true, INT64_MIN},
+      {"2262-04-11T23:47:16.854775808Z", TOML_DATETIME, 2262, 4, 11, 23, 47,
+       16, 854775808, 0, false, 0},
+      {"9999-12-31T23:59:59.999999999Z", TOML_DATETIME, 9999, 12, 31, 23, 59,
+       59, 999999999, 0, false, 0},
+      {"1979-05-27T07:32:00", TOML_DATETIMELOCAL, 1979, 5, 27, 7, 32, 0, 0, 0,
+       true, 296638320000000000},
+      {"2000-02-29", TOML_DATELOCAL, 2000, 2, 29, 0, 0, 0, 0, 0, true,
+       951782400000000000},
+      {"0000-01-01", TOML_DATELOCAL, 0, 1, 1, 0, 0, 0, 0, 0, false, 0},
+      {"07:32:00", TOML_TIMELOCAL, 0, 0, 0, 7, 32, 0, 0, 0, true,
+       27120000000000},
+      // past nanoseconds the digits are dropped
+      {"00:00:00.1234567891", TOML_TIMELOCAL, 0, 0, 0, 0, 0, 0, 123456789, 0,
+       true, 123456789},
+  };
+  for (size_t i = 0; i < sizeof(valid) / sizeof(valid[0]); i++)
+  {
+    TomlDatetime dt;
+    CHECK(parse_datetime(valid[i].text, &dt) == valid[i].type);
+    TomlDatetimeFields f;
+    toml_datetime_fields(&dt, &f);
+    CHECK(f.year == valid[i].year);
+    CHECK(f.month == valid[i].month);
+    CHECK(f.day == valid[i].day);
+    CHECK(f.hour == valid[i].hour);
+    CHECK(f.minute == valid[i].minute);
+    CHECK(f.second == valid[i].second);
+    CHECK(f.nanosecond == valid[i].nanosecond);
+    CHECK(f.offset == valid[i].offset);
+    int64_t ns = 0;
+    CHECK(toml_datetime_epoch_ns(&dt, &ns) == valid[i].epoch);
+    if (valid[i].epoch)
+      CHECK(ns == valid[i].ns);
+  }
+
+  // `Z` and a zero offset are the same instant, only the flags differ
+  TomlDatetime zulu, zero;
+  CHECK(parse_datetime("1979-05-27T07:32:00Z", &zulu) == TOML_DATETIME);
+  CHECK(parse_datetime("1979-05-27T07:32:00+00:00", &zero) == TOML_DATETIME);
+  CHECK(zulu.flags & MYTOML_DATETIME_ZULU);
+  CHECK(!(zero.flags & MYTOML_DATETIME_ZULU));
+  CHECK(zero.flags & MYTOML_DATETIME_OFFSET);
+
+  // dumps give back the offset and fraction digits as they were written
+  static const char *kept[] = {
+      "1979-05-27T00:32:00.999999-07:00",
+      "1979-05-27T07:32:00Z",
+      "1979-05-27T07:32:00+00:00",
+      "1979-05-27T07:32:00.100",
+      "07:32:00.5",
+  };
+  for (size_t i = 0; i < sizeof(kept) / sizeof(kept[0]); i++)
+  {
+    char doc[128];
+    snprintf(doc, sizeof(doc), "x = %s\n", kept[i]);
+    TomlKey *root = toml_loads(doc);
+    const char *dump = root ? toml_key_dumps(root) : NULL;
+    char value[64];
+    snprintf(value, sizeof(value), "\"value\": \"%s\"", kept[i]);
+    CHECK(dump && strstr(dump, value) != NULL);
+    free((void *)dump);
+    toml_free(root);
+  }
+
+  return CHECK_RESULT();
+}
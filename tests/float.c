@@ -0,0 +1,128 @@
+/*
+    Floats round to the nearest double whatever their number of
+    digits, like a correctly rounding strtod, and do not depend on
+    the decimal point of the current locale.
+*/
+
+#include "check.h"
+#include "mytoml.h"
+
+#include <locale.h> // for setlocale
+#include <stdint.h> // for uint64_t
+#include <stdio.h>  // for snprintf
+#include <stdlib.h> // for strtod
+#include <string.h> // for memcmp
+
+// parses `x = text`, returns whether it gave a float
+static bool parse_float(const char *text, double *out)
+{
+  char doc[2048];
+  snprintf(doc, sizeof(doc), "x = %s\n", text);
+  TomlKey *root = toml_loads(doc);
+  double *value = root ? toml_get_float(toml_get_key(root, "x")) : NULL;
+  if (value)
+    *out = *value;
+  toml_free(root);
+  return value != NULL;
+}
+
+// whether `text` parses to exactly the double strtod gives in the C locale
+static bool same_as_strtod(const char *text)
+{
+  double value, expected = strtod(text, NULL);
+  return parse_float(text, &value) &&
+         memcmp(&value, &expected, sizeof(double)) == 0;
+}
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static unsigned rng(unsigned n)
+{
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 7;
+  rng_state ^= rng_state << 17;
+  return (unsigned)(rng_state % n);
+}
+
+int main(void)
+{
+  static const char *edges[] = {
+      // subnormals and the normal boundary
+      "4.9406564584124654e-324",
+      "2.4703282292062327e-324",
+      "2.4703282292062328e-324",
+      "2.2250738585072009e-308",
+      "2.2250738585072011e-308",
+      "2.2250738585072014e-308",
+      "1e-320",
+      "1e-400",
+      // the top of the range
+      "1.7976931348623157e308",
+      "1.7976931348623158e308",
+      "1.7976931348623159e308",
+      "1e309",
+      // ties, just below and just above them
+      "9007199254740993.0",
+      "9007199254740993.0000000000000000001",
+      "9007199254740992.9999999999999999999",
+      "1.00000000000000011102230246251565404236316680908203125",
+      "1.00000000000000011102230246251565404236316680908203124",
+      "1.00000000000000011102230246251565404236316680908203126",
+      "0.3000000000000000444089209850062616169452667236328125",
+      // long digit strings
+      "3.14159265358979323846264338327950288419716939937510",
+      "0.000000000000000000000000000000000000000000000001e-280",
+      "123456789012345678901234567890.0",
+      "-0.0",
+  };
+  for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++)
+    CHECK(same_as_strtod(edges[i]));
+
+  // a 1000 digit mantissa, only its first digits can matter
+  char long_text[1100] = "2.";
+  for (int i = 2; i < 1002; i++)
+    long_text[i] = (char)('0' + (i % 7));
+  strcpy(long_text + 1002, "e-310");
+  CHECK(same_as_strtod(long_text));
+
+  // random mantissas of 20 to 40 digits over the whole exponent range
+  char text[64];
+  for (int n = 0; n < 20000; n++)
+  {
+    int digits = 20 + (int)rng(21);
+    int point = 1 + (int)rng((unsigned)digits - 1);
+    int len = 0;
+    for (int i = 0; i < digits; i++)
+    {
+      if (i == point)
+        text[len++] = '.';
+      text[len++] = (char)((i == 0 ? '1' + rng(9) : '0' + rng(10)));
+    }
+    snprintf(text + len, sizeof(text) - (size_t)len, "e%d",
+             (int)rng(660) - 345);
+    CHECK(same_as_strtod(text));
+  }
+
+  // separators are skipped
+  double value = 0;
+  CHECK(parse_float("1_000.000_001", &value) && value == 1000.000001);
+  CHECK(parse_float("1e1_0", &value) && value == 1e10);
+
+  // a locale with a decimal comma changes nothing
+  static const char *comma_locales[] = {"de_DE.UTF-8", "de_DE", "fr_FR.UTF-8",
+                                        "German"};
+  for (size_t i = 0; i < sizeof(comma_locales) / sizeof(comma_locales[0]); i++)
+  {
+    if (!setlocale(LC_NUMERIC, comma_locales[i]))
+      continue;
+    CHECK(parse_float("1.5", &value) && value == 1.5);
+    CHECK(parse_float("2.2250738585072011e-308", &value) &&
+          value == 2.2250738585072011e-308);
+    CHECK(parse_float("3.14159265358979323846264338327950288", &value) &&
+          value == 3.14159265358979323846264338327950288);
+    setlocale(LC_NUMERIC, "C");
+    break;
+  }
+
+  return CHECK_RESULT();
+}
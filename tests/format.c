@@ -0,0 +1,151 @@
+/*
+    Dumps print numbers in their shortest form: integers over the
+    whole int64_t range, and floats with the fewest digits that read
+    back as the same double, the closest of them when there are
+    several.
+*/
+
+#include "check.h"
+#include "mytoml.h"
+
+#include <math.h>   // for isfinite
+#include <stdint.h> // for uint64_t
+#include <stdio.h>  // for snprintf
+#include <stdlib.h> // for strtod
+#include <string.h> // for memcmp strcmp strstr
+
+// dumps the value of `x = text` into `out`, returns false if it did not parse
+static bool format(const char *text, char *out, size_t size)
+{
+  char doc[128];
+  snprintf(doc, sizeof(doc), "x = %s\n", text);
+  TomlKey *root = toml_loads(doc);
+  TomlKey *x = root ? toml_get_key(root, "x") : NULL;
+  const char *dump = x ? toml_value_dumps(x->value) : NULL;
+  if (dump)
+    snprintf(out, size, "%s", dump);
+  free((void *)dump);
+  toml_free(root);
+  return dump != NULL;
+}
+
+// the significant digits of a number as printed, without point or exponent
+static int significant(const char *text, char *digits)
+{
+  int n = 0;
+  for (const char *p = text; *p && *p != 'e'; p++)
+  {
+    if (*p >= '0' && *p <= '9' && (n || *p != '0'))
+      digits[n++] = *p;
+  }
+  while (n > 1 && digits[n - 1] == '0')
+    n--;
+  digits[n] = '\0';
+  return n;
+}
+
+static uint64_t rng_state = 0x2545F4914F6CDD1DULL;
+
+static uint64_t rng(void)
+{
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 7;
+  rng_state ^= rng_state << 17;
+  return rng_state;
+}
+
+int main(void)
+{
+  static const struct
+  {
+    const char *text, *dump;
+  } exact[] = {
+      {"0.1", "{\"type\": \"float\", \"value\": \"0.1\"}"},
+      {"0.3", "{\"type\": \"float\", \"value\": \"0.3\"}"},
+      {"2.5", "{\"type\": \"float\", \"value\": \"2.5\"}"},
+      {"1.0", "{\"type\": \"float\", \"value\": \"1.0\"}"},
+      {"100.0", "{\"type\": \"float\", \"value\": \"100.0\"}"},
+      {"0.0", "{\"type\": \"float\", \"value\": \"0.0\"}"},
+      {"-0.0", "{\"type\": \"float\", \"value\": \"-0.0\"}"},
+      {"0.000001", "{\"type\": \"float\", \"value\": \"0.000001\"}"},
+      {"0.0000012345", "{\"type\": \"float\", \"value\": \"0.0000012345\"}"},
+      {"1e-7", "{\"type\": \"float\", \"value\": \"1e-7\"}"},
+      {"123456789012345680000.0",
+       "{\"type\": \"float\", \"value\": \"123456789012345680000.0\"}"},
+      {"1234567890123456789012.0",
+       "{\"type\": \"float\", \"value\": \"1.2345678901234568e21\"}"},
+      {"9007199254740993.0",
+       "{\"type\": \"float\", \"value\": \"9007199254740992.0\"}"},
+      {"5e-324", "{\"type\": \"float\", \"value\": \"5e-324\"}"},
+      {"1.7976931348623157e308",
+       "{\"type\": \"float\", \"value\": \"1.7976931348623157e308\"}"},
+      {"-2.2250738585072014e-308",
+       "{\"type\": \"float\", \"value\": \"-2.2250738585072014e-308\"}"},
+      {"1e23", "{\"type\": \"float\", \"value\": \"1e23\"}"},
+      // floats written with an exponent keep one
+      {"1.5e3", "{\"type\": \"float\", \"value\": \"1.5e3\"}"},
+      {"3.0e-5", "{\"type\": \"float\", \"value\": \"3e-5\"}"},
+      {"123e-2", "{\"type\": \"float\", \"value\": \"1.23e0\"}"},
+      {"+inf", "{\"type\": \"float\", \"value\": \"inf\"}"},
+      {"-inf", "{\"type\": \"float\", \"value\": \"-inf\"}"},
+      {"nan", "{\"type\": \"float\", \"value\": \"nan\"}"},
+      {"-9223372036854775808",
+       "{\"type\": \"integer\", \"value\": \"-9223372036854775808\"}"},
+      {"9223372036854775807",
+       "{\"type\": \"integer\", \"value\": \"9223372036854775807\"}"},
+      {"0", "{\"type\": \"integer\", \"value\": \"0\"}"},
+      {"-1", "{\"type\": \"integer\", \"value\": \"-1\"}"},
+      {"+42", "{\"type\": \"integer\", \"value\": \"42\"}"},
+      {"0xff", "{\"type\": \"integer\", \"value\": \"255\"}"},
+      {"-0x8000000000000000", NULL},
+  };
+  char out[128];
+  for (size_t i = 0; i < sizeof(exact) / sizeof(exact[0]); i++)
+  {
+    bool parsed = format(exact[i].text, out, sizeof(out));
+    CHECK(parsed == (exact[i].dump != NULL));
+    if (parsed && exact[i].dump)
+      CHECK(strcmp(out, exact[i].dump) == 0);
+  }
+
+  // random doubles read back the same, with no more digits than the
+  // shortest correctly rounded form and the same digits when as many
+  for (int n = 0; n < 20000; n++)
+  {
+    uint64_t bits = rng();
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    if (!isfinite(d))
+      continue;
+    char text[64];
+    snprintf(text, sizeof(text), "%.17g", d);
+    if (!strchr(text, '.') && !strchr(text, 'e'))
+      strcat(text, ".0");
+    CHECK(format(text, out, sizeof(out)));
+    const char *value = strstr(out, "\"value\": \"");
+    CHECK(value);
+    if (!value)
+      continue;
+    value += 10;
+    double back = strtod(value, NULL);
+    CHECK(memcmp(&back, &d, sizeof(d)) == 0);
+
+    int shortest = 1;
+    char reference[64];
+    for (; shortest < 17; shortest++)
+    {
+      snprintf(reference, sizeof(reference), "%.*e", shortest - 1, d);
+      if (strtod(reference, NULL) == d)
+        break;
+    }
+    snprintf(reference, sizeof(reference), "%.*e", shortest - 1, d);
+    char got[32], want[32];
+    int digits = significant(value, got);
+    significant(reference, want);
+    CHECK(digits <= shortest);
+    if (digits == shortest)
+      CHECK(strcmp(got, want) == 0);
+  }
+
+  return CHECK_RESULT();
+}
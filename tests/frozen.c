@@ -0,0 +1,138 @@
+/*
+    A frozen document answers the same lookups as the document it
+    was made from, tables of more than MYTOML_SMALL_TABLE_SIZE keys
+    included, and `toml_frozen_load` refuses bytes that are not a
+    document it wrote.
+*/
+
+#include "check.h"
+#include "mytoml.h"
+
+#include <stdint.h> // for uint64_t
+#include <stdio.h>  // for snprintf
+#include <stdlib.h> // for malloc
+#include <string.h> // for memcpy
+
+#define KEYS 40
+
+// whether every value below `node` can be read, counting them in `count`
+static bool walk(const TomlFrozen *doc, const TomlFrozenNode *node,
+                 size_t *count)
+{
+  (*count)++;
+  switch (node->type)
+  {
+  case TOML_STRING:
+    return toml_frozen_string(doc, node) != NULL;
+  case TOML_DATETIME:
+  case TOML_DATELOCAL:
+  case TOML_TIMELOCAL:
+  case TOML_DATETIMELOCAL:
+    return toml_frozen_datetime(doc, node) != NULL;
+  case TOML_ARRAY:
+  case TOML_INLINETABLE:
+    for (size_t i = 0; i < node->len; i++)
+    {
+      const TomlFrozenNode *sub = toml_frozen_at(doc, node, i);
+      if (!sub || !walk(doc, sub, count))
+        return false;
+      if (node->type == TOML_INLINETABLE &&
+          toml_frozen_get(doc, node, toml_frozen_key_at(doc, node, i)) != sub)
+        return false;
+    }
+    return true;
+  default:
+    return true;
+  }
+}
+
+int main(void)
+{
+  static char text[8192];
+  size_t len = 0;
+  len += (size_t)snprintf(text + len, sizeof(text) - len,
+                          "title = \"frozen\"\nwhen = 1979-05-27T07:32:00Z\n"
+                          "list = [1, 'two', [3.5], {four = 4}]\n[big]\n");
+  for (int i = 0; i < KEYS; i++)
+    len += (size_t)snprintf(text + len, sizeof(text) - len,
+                            "key%d = %d\nname%d = \"n%d\"\n", i, i, i, i);
+  len += (size_t)snprintf(text + len, sizeof(text) - len,
+                          "[[rows]]\nid = 1\n[[rows]]\nid = 2\n");
+  TomlKey *root = toml_loadsn(text, len);
+  CHECK(root);
+  TomlFrozen *frozen = toml_freeze(root);
+  CHECK(frozen);
+  if (!frozen)
+    return CHECK_RESULT();
+
+  // every key of the big table is found with its value, missing ones are not
+  const TomlFrozenNode *top = toml_frozen_root(frozen);
+  const TomlFrozenNode *big = toml_frozen_get(frozen, top, "big");
+  CHECK(big && big->type == TOML_INLINETABLE && big->len == 2 * KEYS);
+  char id[32];
+  for (int i = 0; big && i < KEYS; i++)
+  {
+    snprintf(id, sizeof(id), "key%d", i);
+    const TomlFrozenNode *n = toml_frozen_get(frozen, big, id);
+    CHECK(n && n->type == TOML_INT && n->integer == i);
+    snprintf(id, sizeof(id), "name%d", i);
+    n = toml_frozen_get(frozen, big, id);
+    char expected[32];
+    snprintf(expected, sizeof(expected), "n%d", i);
+    CHECK(n && strcmp(toml_frozen_string(frozen, n), expected) == 0);
+  }
+  CHECK(toml_frozen_get(frozen, big, "key40") == NULL);
+  CHECK(toml_frozen_get(frozen, big, "") == NULL);
+  CHECK(toml_frozen_get(frozen, top, "missing") == NULL);
+
+  const TomlFrozenNode *rows = toml_frozen_get(frozen, top, "rows");
+  CHECK(rows && rows->type == TOML_ARRAY && rows->len == 2);
+  const TomlFrozenNode *row = toml_frozen_at(frozen, rows, 1);
+  const TomlFrozenNode *row_id = toml_frozen_get(frozen, row, "id");
+  CHECK(row_id && row_id->integer == 2);
+  const TomlDatetime *when =
+      toml_frozen_datetime(frozen, toml_frozen_get(frozen, top, "when"));
+  int64_t ns = 0;
+  CHECK(when && toml_datetime_epoch_ns(when, &ns) && ns == 296638320000000000);
+  size_t count = 0;
+  CHECK(walk(frozen, top, &count));
+  toml_free(root);
+
+  // a copy loads and answers the same, 8-byte alignment is all it needs
+  size_t size = toml_frozen_size(frozen);
+  uint64_t *copy = (uint64_t *)malloc(size);
+  CHECK(copy);
+  if (!copy)
+    return CHECK_RESULT();
+  memcpy(copy, frozen, size);
+  const TomlFrozen *loaded = toml_frozen_load(copy, size);
+  CHECK(loaded);
+  size_t loaded_count = 0;
+  CHECK(loaded && walk(loaded, toml_frozen_root(loaded), &loaded_count));
+  CHECK(loaded_count == count);
+  CHECK(toml_frozen_load(copy, size - 1) == NULL);
+  CHECK(toml_frozen_load((const char *)copy + 1, size - 1) == NULL);
+  CHECK(toml_frozen_load(NULL, size) == NULL);
+
+  // a changed magic, version or size is refused outright, any other
+  // changed byte either is refused or still leaves a readable document
+  unsigned char *bytes = (unsigned char *)copy;
+  for (size_t i = 0; i < size; i++)
+  {
+    for (int bit = 0; bit < 8; bit++)
+    {
+      bytes[i] ^= (unsigned char)(1u << bit);
+      const TomlFrozen *changed = toml_frozen_load(copy, size);
+      if (i < 12)
+        CHECK(changed == NULL);
+      size_t changed_count = 0;
+      if (changed)
+        CHECK(walk(changed, toml_frozen_root(changed), &changed_count));
+      bytes[i] ^= (unsigned char)(1u << bit);
+    }
+  }
+  free(copy);
+  toml_frozen_free(frozen);
+
+  return CHECK_RESULT();
+}
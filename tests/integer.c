@@ -0,0 +1,106 @@
+/*
+    Integers are parsed into an int64_t: the whole range is kept
+    exactly in every base, and anything past it is an error
+    rather than a rounded or wrapped value.
+*/
+
+#include "check.h"
+#include "mytoml.h"
+
+#include <stdint.h> // for INT64_MAX
+#include <stdio.h>  // for snprintf
+
+// parses `x = text`, returns whether it gave an integer
+static bool parse_int(const char *text, int64_t *out)
+{
+  char doc[128];
+  snprintf(doc, sizeof(doc), "x = %s\n", text);
+  TomlKey *root = toml_loads(doc);
+  int64_t *value = root ? toml_get_int64(toml_get_key(root, "x")) : NULL;
+  if (value)
+    *out = *value;
+  toml_free(root);
+  return value != NULL;
+}
+
+int main(void)
+{
+  static const struct
+  {
+    const char *text;
+    int64_t value;
+  } valid[] = {
+      {"0", 0},
+      {"+0", 0},
+      {"-0", 0},
+      {"42", 42},
+      {"1_000_000", 1000000},
+      {"9007199254740993", 9007199254740993},
+      {"9223372036854775807", INT64_MAX},
+      {"+9223372036854775807", INT64_MAX},
+      {"-9223372036854775808", INT64_MIN},
+      {"9_223_372_036_854_775_807", INT64_MAX},
+      {"0x7FFFFFFFFFFFFFFF", INT64_MAX},
+      {"0xdead_beef", 0xdeadbeef},
+      {"0o777777777777777777777", INT64_MAX},
+      {"0b111111111111111111111111111111111111111111111111111111111111111",
+       INT64_MAX},
+  };
+  for (size_t i = 0; i < sizeof(valid) / sizeof(valid[0]); i++)
+  {
+    int64_t value = 0;
+    CHECK(parse_int(valid[i].text, &value));
+    CHECK(value == valid[i].value);
+  }
+
+  static const char *invalid[] = {
+      "9223372036854775808",
+      "-9223372036854775809",
+      "+9223372036854775808",
+      "99999999999999999999",
+      "0x8000000000000000",
+      "0xFFFFFFFFFFFFFFFFF",
+      "0o1000000000000000000000",
+      "0b1000000000000000000000000000000000000000000000000000000000000000",
+      "01",
+      "-01",
+      "1__0",
+      "_1",
+      "1_",
+      "0x_1",
+      "-0x1",
+      "0x",
+  };
+  for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+  {
+    int64_t value = 0;
+    CHECK(!parse_int(invalid[i], &value));
+  }
+
+  // the deprecated accessor only hands out values that fit an int
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+  TomlKey *root = toml_loads("a = 2147483647\nb = -2147483648\n"
+                             "c = 2147483648\nd = 'x'\n");
+  CHECK(root);
+  int *a = toml_get_int(toml_get_key(root, "a"));
+  int *b = toml_get_int(toml_get_key(root, "b"));
+  CHECK(a && *a == 2147483647);
+  CHECK(b && *b == -2147483647 - 1);
+  CHECK(toml_get_int(toml_get_key(root, "c")) == NULL);
+  CHECK(toml_get_int(toml_get_key(root, "d")) == NULL);
+  CHECK(*toml_get_int64(toml_get_key(root, "c")) == 2147483648);
+  toml_free(root);
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+  return CHECK_RESULT();
+}
@@ -0,0 +1,92 @@
+/*
+    Key ids are as long as the document makes them, in every form a
+    key can be written in, well past the 255 bytes an id used to be
+    limited to.
+*/
+
+#include "check.h"
+#include "mytoml.h"
+
+#include <stdio.h>  // for snprintf
+#include <stdlib.h> // for malloc
+#include <string.h> // for memset strlen
+
+// whether the key at the end of `path` in `text` has an id of `len` bytes
+// of `fill`
+static bool check_key(const char *text, size_t size, const char *path[],
+                      size_t depth, size_t len, char fill)
+{
+  TomlKey *root = toml_loadsn(text, size);
+  TomlKey *key = root;
+  for (size_t i = 0; key && i < depth; i++)
+    key = toml_get_key(key, path[i]);
+  bool ok = key && key->id.len == len && strlen(key->id.str) == len;
+  for (size_t i = 0; ok && i < len; i++)
+    ok = key->id.str[i] == fill;
+  toml_free(root);
+  return ok;
+}
+
+int main(void)
+{
+  static const size_t lengths[] = {255, 256, 257, 1000, 70000};
+  for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+  {
+    size_t len = lengths[l];
+    char *id = (char *)malloc(len + 1);
+    char *text = (char *)malloc(3 * len + 64);
+    CHECK(id && text);
+    if (!id || !text)
+      return CHECK_RESULT();
+    memset(id, 'k', len);
+    id[len] = '\0';
+
+    // bare, basic and literal keys
+    static const char *forms[] = {"%s = 1\n", "\"%s\" = 1\n", "'%s' = 1\n"};
+    for (size_t f = 0; f < 3; f++)
+    {
+      int size = snprintf(text, 3 * len + 64, forms[f], id);
+      const char *path[] = {id};
+      CHECK(check_key(text, (size_t)size, path, 1, len, 'k'));
+    }
+
+    // dotted keys, table headers and arrays of tables
+    int size = snprintf(text, 3 * len + 64, "a.%s.b = 1\n", id);
+    const char *dotted[] = {"a", id};
+    CHECK(check_key(text, (size_t)size, dotted, 2, len, 'k'));
+    size = snprintf(text, 3 * len + 64, "[%s]\n\"%s\" = 1\n", id, id);
+    const char *table[] = {id, id};
+    CHECK(check_key(text, (size_t)size, table, 2, len, 'k'));
+    size = snprintf(text, 3 * len + 64, "[[%s]]\n[[%s]]\n", id, id);
+    TomlKey *root = toml_loadsn(text, (size_t)size);
+    TomlKey *key = root ? toml_get_key(root, id) : NULL;
+    CHECK(key && key->value->len == 2);
+    toml_free(root);
+
+    // ids that differ only in their last byte are different keys
+    size = snprintf(text, 3 * len + 64, "%s = 1\n", id);
+    id[len - 1] = 'j';
+    size += snprintf(text + size, 3 * len + 64 - (size_t)size, "%s = 2\n", id);
+    root = toml_loadsn(text, (size_t)size);
+    CHECK(root && root->len == 2);
+    key = root ? toml_get_key(root, id) : NULL;
+    CHECK(key && *toml_get_int64(key) == 2);
+    toml_free(root);
+    id[len - 1] = 'k';
+
+    // and the same id twice is still a duplicate
+    size = snprintf(text, 3 * len + 64, "%s = 1\n'%s' = 2\n", id, id);
+    CHECK(toml_loadsn(text, (size_t)size) == NULL);
+
+    free(text);
+    free(id);
+  }
+
+  // escapes are resolved before the id is stored
+  TomlKey *root = toml_loads("\"\\u00e9\\t\\\"\" = 1\n");
+  TomlKey *key = root ? toml_get_key(root, "\xc3\xa9\t\"") : NULL;
+  CHECK(key && key->id.len == 4);
+  toml_free(root);
+
+  return CHECK_RESULT();
+}
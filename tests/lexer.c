@@ -0,0 +1,82 @@
+/*
+    The lexer reads a number-like token whole and its shape decides
+    what it is: `HH:` starts a time, `YYYY-` a date, anything else
+    is an integer or a float. Bare keys made of digits and dashes
+    stay keys.
+*/
+
+#include "check.h"
+#include "mytoml.h"
+
+#include <stdio.h> // for snprintf
+
+// parses `x = text`, returns the type of `x` or -1 if the parse failed
+static int parse_type(const char *text)
+{
+  char doc[128];
+  snprintf(doc, sizeof(doc), "x = %s\n", text);
+  TomlKey *root = toml_loads(doc);
+  TomlKey *key = root ? toml_get_key(root, "x") : NULL;
+  int type = key && key->value ? (int)key->value->type : -1;
+  toml_free(root);
+  return type;
+}
+
+int main(void)
+{
+  static const struct
+  {
+    const char *text;
+    int type;
+  } values[] = {
+      {"123", TOML_INT},
+      {"-123", TOML_INT},
+      {"1_000", TOML_INT},
+      {"0x1f", TOML_INT},
+      {"123e-2", TOML_FLOAT},
+      {"123E-20", TOML_FLOAT},
+      {"-123e-2", TOML_FLOAT},
+      {"+1234e-5", TOML_FLOAT},
+      {"12e-20", TOML_FLOAT},
+      {"1.5", TOML_FLOAT},
+      {"-0.0", TOML_FLOAT},
+      {"+inf", TOML_FLOAT},
+      {"-nan", TOML_FLOAT},
+      {"1979-05-27", TOML_DATELOCAL},
+      {"07:32:00", TOML_TIMELOCAL},
+      {"1979-05-27T07:32:00Z", TOML_DATETIME},
+      {"1234-5", -1},
+      {"12:3", -1},
+      {"12345-01-01", -1},
+      {"-1979-05-27", -1},
+      {"+07:32:00", -1},
+      {"1e", -1},
+      {"1__0", -1},
+  };
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+    CHECK(parse_type(values[i].text) == values[i].type);
+
+  // the same shapes inside arrays and inline tables
+  TomlKey *root = toml_loads("x = [123e-2,1979-05-27,07:32:00]\n"
+                             "y = {a=123e-2,b=1979-05-27}\n");
+  TomlKey *x = root ? toml_get_key(root, "x") : NULL;
+  CHECK(x && x->value->len == 3);
+  CHECK(x && x->value->arr[0]->type == TOML_FLOAT);
+  CHECK(x && x->value->arr[1]->type == TOML_DATELOCAL);
+  CHECK(x && x->value->arr[2]->type == TOML_TIMELOCAL);
+  TomlKey *y = root ? toml_get_key(root, "y") : NULL;
+  CHECK(y && toml_get_float(toml_get_key(y, "a")));
+  toml_free(root);
+
+  // as keys they are names, dotted where they have a dot
+  root = toml_loads("1979-05-27 = 1\n123e-2 = 2\n07 = 3\n3.14159 = 4\n");
+  CHECK(root && root->len == 4);
+  CHECK(root && toml_get_key(root, "1979-05-27"));
+  CHECK(root && toml_get_key(root, "123e-2"));
+  CHECK(root && toml_get_key(root, "07"));
+  TomlKey *three = root ? toml_get_key(root, "3") : NULL;
+  CHECK(three && toml_get_key(three, "14159"));
+  toml_free(root);
+
+  return CHECK_RESULT();
+}
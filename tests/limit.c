@@ -0,0 +1,147 @@
+/*
+    `TomlOptions::max_input_size` is enforced on every kind of
+    input: borrowed buffers, mapped files, buffered `FILE *` reads
+    and pipes. An input of exactly the limit parses, one byte more
+    does not, and 0 means no limit.
+*/
+
+// fdopen, pipe, fork and mkstemp are POSIX, not ISO C
+#define _POSIX_C_SOURCE 200809L
+
+#include "check.h"
+#include "mytoml.h"
+
+#include <stdio.h>  // for fopen
+#include <stdlib.h> // for malloc
+#include <string.h> // for memcpy
+
+#ifndef _WIN32
+#include <signal.h>   // for signal
+#include <sys/wait.h> // for waitpid
+#include <unistd.h>   // for pipe, fork
+#endif
+
+// a document longer than a few stream chunks
+#define SIZE (3 * 65536 + 11)
+
+static char path[] = "limit-XXXXXX";
+
+// whether the first `len` bytes of `text` parse from a file with `limit`
+static bool load_file(const char *text, size_t len, size_t limit, bool mapped)
+{
+  FILE *file = fopen(path, "wb");
+  if (!file)
+    return false;
+  fwrite(text, 1, len, file);
+  fclose(file);
+  TomlOptions options = toml_options_default();
+  options.max_input_size = limit;
+  TomlKey *root = NULL;
+  if (mapped)
+  {
+    root = toml_load_file_name_opts(path, &options);
+  }
+  else if ((file = fopen(path, "rb")))
+  {
+    root = toml_load_file_opts(file, &options);
+    fclose(file);
+  }
+  bool ok = root != NULL;
+  toml_free(root);
+  return ok;
+}
+
+#ifndef _WIN32
+// whether the first `len` bytes of `text` parse from a pipe with `limit`
+static bool load_pipe(const char *text, size_t len, size_t limit)
+{
+  int fds[2];
+  if (pipe(fds) != 0)
+    return false;
+  pid_t child = fork();
+  if (child < 0)
+    return false;
+  if (child == 0)
+  {
+    // the reader stops at the limit and may close its end early
+    signal(SIGPIPE, SIG_IGN);
+    close(fds[0]);
+    for (size_t at = 0; at < len;)
+    {
+      ssize_t n = write(fds[1], text + at, len - at < 4096 ? len - at : 4096);
+      if (n <= 0)
+        break;
+      at += (size_t)n;
+    }
+    _exit(0);
+  }
+  close(fds[1]);
+  TomlOptions options = toml_options_default();
+  options.max_input_size = limit;
+  FILE *file = fdopen(fds[0], "r");
+  TomlKey *root = file ? toml_load_file_opts(file, &options) : NULL;
+  if (file)
+    fclose(file);
+  waitpid(child, NULL, 0);
+  bool ok = root != NULL;
+  toml_free(root);
+  return ok;
+}
+#endif
+
+int main(void)
+{
+  CHECK(toml_options_default().max_input_size == MYTOML_MAX_FILE_SIZE);
+
+  char *text = (char *)malloc(SIZE + 1);
+  CHECK(text);
+  if (!text)
+    return CHECK_RESULT();
+  size_t len = 0;
+  for (int i = 0; len + 32 < SIZE; i++)
+    len += (size_t)snprintf(text + len, SIZE + 1 - len, "k%d = %d\n", i, i);
+  memset(text + len, '\n', SIZE - len);
+  len = SIZE;
+
+  // borrowed buffers
+  TomlOptions options = toml_options_default();
+  static const size_t limits[] = {SIZE, SIZE - 1, 0};
+  static const bool parses[] = {true, false, true};
+  for (size_t i = 0; i < 3; i++)
+  {
+    options.max_input_size = limits[i];
+    TomlKey *root = toml_loadsn_opts(text, len, &options);
+    CHECK((root != NULL) == parses[i]);
+    toml_free(root);
+  }
+  options.max_input_size = 1;
+  TomlKey *root = toml_loadsn_opts("", 0, &options);
+  CHECK(root);
+  toml_free(root);
+
+  // mapped and buffered files
+#ifndef _WIN32
+  int fd = mkstemp(path);
+  CHECK(fd >= 0);
+  if (fd >= 0)
+    close(fd);
+#endif
+  for (int mapped = 0; mapped < 2; mapped++)
+  {
+    for (size_t i = 0; i < 3; i++)
+      CHECK(load_file(text, len, limits[i], mapped) == parses[i]);
+    // and far past the limit
+    CHECK(!load_file(text, len, 100, mapped));
+  }
+  remove(path);
+
+#ifndef _WIN32
+  // pipes, which only learn their size by reading it
+  for (size_t i = 0; i < 3; i++)
+    CHECK(load_pipe(text, len, limits[i]) == parses[i]);
+  CHECK(!load_pipe(text, len, 100));
+#endif
+  free(text);
+
+  return CHECK_RESULT();
+}
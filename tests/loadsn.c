@@ -0,0 +1,93 @@
+/*
+    `toml_loadsn` parses the caller's buffer in place: it reads the
+    `len` bytes it is given and not one more, so the buffer needs
+    no NUL terminator and whatever follows it is ignored.
+*/
+
+// mmap and mprotect are POSIX and MAP_ANONYMOUS is BSD, not ISO C
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
+#include "check.h"
+#include "mytoml.h"
+
+#include <stdio.h>  // for snprintf
+#include <stdlib.h> // for free
+#include <string.h> // for memcpy strcmp strlen
+
+#ifndef _WIN32
+#include <sys/mman.h> // for mmap mprotect
+#include <unistd.h>   // for sysconf
+#endif
+
+static const char *tails[] = {
+    "x = 123456789", "x = 'str'", "x = \"esc\\t\"", "x = 1.5e3", "x = true",
+    "x = 1979-05-27T07:32:00Z", "x = 07:32:00", "x = [1, 2]", "x = {a = 1}",
+    "x.y = 1", "[x]", "[[x]]", "x = 'str", "x = [1, 2", "x = \"\"\"a", "x =",
+    "x = 1 # comment", "x", "\"x", "x = 1\r"};
+
+// the document `x`, or NULL, as a dump to compare parses by
+static const char *dump(const char *text, size_t len)
+{
+  TomlKey *root = toml_loadsn(text, len);
+  const char *d = root ? toml_key_dumps(root) : NULL;
+  toml_free(root);
+  return d;
+}
+
+static bool same(const char *a, const char *b)
+{
+  return a == b || (a && b && strcmp(a, b) == 0);
+}
+
+int main(void)
+{
+  // a prefix of a longer string parses as if the string ended there
+  for (size_t t = 0; t < sizeof(tails) / sizeof(tails[0]); t++)
+  {
+    char text[64], longer[128];
+    size_t len = strlen(tails[t]);
+    memcpy(text, tails[t], len + 1);
+    snprintf(longer, sizeof(longer), "%s9 = 'more'\n]}\"", tails[t]);
+    const char *expected = dump(text, len);
+    const char *got = dump(longer, len);
+    CHECK(same(got, expected));
+    free((void *)expected);
+    free((void *)got);
+  }
+  TomlKey *root = toml_loadsn("", 0);
+  CHECK(root && root->len == 0);
+  toml_free(root);
+  root = toml_loadsn("a = 1b = 2", 5);
+  CHECK(root && root->len == 1 && *toml_get_int64(toml_get_key(root, "a")) == 1);
+  toml_free(root);
+
+#ifndef _WIN32
+  // documents that end right before a page that cannot be read
+  size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  char *map = (char *)mmap(NULL, 2 * page, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  CHECK(map != MAP_FAILED);
+  if (map == MAP_FAILED)
+    return CHECK_RESULT();
+  CHECK(mprotect(map + page, page, PROT_NONE) == 0);
+  for (size_t t = 0; t < sizeof(tails) / sizeof(tails[0]); t++)
+  {
+    size_t len = strlen(tails[t]);
+    char *text = map + page - len;
+    memcpy(text, tails[t], len);
+    const char *expected = dump(tails[t], len);
+    const char *got = dump(text, len);
+    CHECK(same(got, expected));
+    free((void *)expected);
+    free((void *)got);
+  }
+  root = toml_loadsn(map + page, 0);
+  CHECK(root && root->len == 0);
+  toml_free(root);
+  munmap(map, 2 * page);
+#endif
+
+  return CHECK_RESULT();
+}
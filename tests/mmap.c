@@ -0,0 +1,142 @@
+/*
+    `toml_load_file_name` maps regular files and parses them in
+    place. Files that end exactly on a page boundary, with no byte
+    after the last token, must not be read past, and the document
+    must not point into the mapping once the load returns.
+*/
+
+// mkstemp, mkfifo and fork are POSIX, not ISO C
+#define _POSIX_C_SOURCE 200809L
+
+#include "check.h"
+#include "mytoml.h"
+
+#ifdef _WIN32
+
+int main(void)
+{
+  return 0;
+}
+
+#else
+
+#include <stdio.h>     // for fopen
+#include <stdlib.h>    // for free
+#include <string.h>    // for strcmp
+#include <sys/stat.h>  // for mkfifo
+#include <sys/wait.h>  // for waitpid
+#include <unistd.h>    // for unlink, fork
+
+static char path[] = "mmap-XXXXXX";
+
+// replaces the file at `path` with `len` bytes of `text`
+static bool write_file(const char *text, size_t len)
+{
+  FILE *file = fopen(path, "wb");
+  if (!file)
+    return false;
+  bool ok = fwrite(text, 1, len, file) == len;
+  return fclose(file) == 0 && ok;
+}
+
+// whether the file at `path` loads to the same document as `text` in memory
+static bool same_as_memory(const char *text, size_t len)
+{
+  TomlKey *mapped = toml_load_file_name(path);
+  TomlKey *memory = toml_loadsn(text, len);
+  if (!mapped || !memory)
+  {
+    toml_free(mapped);
+    toml_free(memory);
+    return !mapped && !memory;
+  }
+  const char *a = toml_key_dumps(mapped);
+  const char *b = toml_key_dumps(memory);
+  bool same = a && b && strcmp(a, b) == 0;
+  free((void *)a);
+  free((void *)b);
+  toml_free(mapped);
+  toml_free(memory);
+  return same;
+}
+
+int main(void)
+{
+  int fd = mkstemp(path);
+  CHECK(fd >= 0);
+  if (fd < 0)
+    return CHECK_RESULT();
+  close(fd);
+
+  // files a page long or a few pages long, so the last token ends
+  // right where the mapping does
+  static char text[3 * 16384];
+  static const char *tails[] = {"x = 123456789", "x = 'str'", "x = 1.5e3",
+                                "x = true", "x = 1979-05-27T07:32:00Z",
+                                "x = [1, 2]", "x = {a = 1}", "x.y = 1",
+                                // and ones that are cut off
+                                "x = 'str", "x = [1, 2", "x = \"\"\"a", "x ="};
+  static const size_t sizes[] = {4096, 8192, 16384, 3 * 16384};
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+  {
+    for (size_t t = 0; t < sizeof(tails) / sizeof(tails[0]); t++)
+    {
+      size_t tail = strlen(tails[t]);
+      size_t len = sizes[s];
+      memset(text, ' ', len - tail);
+      for (size_t i = 60; i < len - tail; i += 61)
+        text[i] = '\n';
+      text[0] = '#';
+      text[len - tail - 1] = '\n';
+      memcpy(text + len - tail, tails[t], tail);
+      CHECK(write_file(text, len));
+      CHECK(same_as_memory(text, len));
+    }
+  }
+
+  // the document keeps its own copy of everything it read
+  const char *doc = "name = \"mapped\"\nlong = \""
+                    "0123456789012345678901234567890123456789\"\n[t]\nk = 1\n";
+  CHECK(write_file(doc, strlen(doc)));
+  TomlKey *root = toml_load_file_name(path);
+  CHECK(root);
+  CHECK(write_file("name = \"other\"\n", 15));
+  CHECK(unlink(path) == 0);
+  TomlKey *name = root ? toml_get_key(root, "name") : NULL;
+  CHECK(name && strcmp(name->value->string, "mapped") == 0);
+  TomlKey *t = root ? toml_get_key(root, "t") : NULL;
+  CHECK(t && toml_get_key(t, "k"));
+  toml_free(root);
+
+  // empty files, missing files and fifos are not mapped
+  CHECK(write_file("", 0));
+  root = toml_load_file_name(path);
+  CHECK(root && root->len == 0);
+  toml_free(root);
+  CHECK(unlink(path) == 0);
+  CHECK(toml_load_file_name(path) == NULL);
+
+  CHECK(mkfifo(path, 0600) == 0);
+  pid_t child = fork();
+  CHECK(child >= 0);
+  if (child == 0)
+  {
+    FILE *file = fopen(path, "w");
+    if (!file)
+      _exit(1);
+    fputs(doc, file);
+    _exit(fclose(file) == 0 ? 0 : 1);
+  }
+  root = toml_load_file_name(path);
+  name = root ? toml_get_key(root, "name") : NULL;
+  CHECK(name && strcmp(name->value->string, "mapped") == 0);
+  toml_free(root);
+  int status = 0;
+  CHECK(waitpid(child, &status, 0) == child && WIFEXITED(status) &&
+        WEXITSTATUS(status) == 0);
+  unlink(path);
+
+  return CHECK_RESULT();
+}
+
+#endif
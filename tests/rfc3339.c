@@ -0,0 +1,72 @@
+/*
+    The fixed-position RFC 3339 scanner: each of the four TOML
+    datetime kinds is told apart by its layout, and dates, times
+    and offsets out of range or of the wrong width are refused.
+*/
+
+#include "check.h"
+#include "mytoml.h"
+
+#include <stdio.h> // for snprintf
+
+// parses `x = text`, returns the type of `x` or -1 if the parse failed
+static int parse_type(const char *text)
+{
+  char doc[128];
+  snprintf(doc, sizeof(doc), "x = %s\n", text);
+  TomlKey *root = toml_loads(doc);
+  TomlKey *key = root ? toml_get_key(root, "x") : NULL;
+  int type = key && key->value ? (int)key->value->type : -1;
+  toml_free(root);
+  return type;
+}
+
+int main(void)
+{
+  static const struct
+  {
+    const char *text;
+    int type;
+  } valid[] = {
+      {"1979-05-27T07:32:00Z", TOML_DATETIME},
+      {"1979-05-27t07:32:00z", TOML_DATETIME},
+      {"1979-05-27 07:32:00Z", TOML_DATETIME},
+      {"1979-05-27T07:32:00-07:00", TOML_DATETIME},
+      {"1979-05-27T07:32:00.999999+05:30", TOML_DATETIME},
+      {"1979-05-27T07:32:00", TOML_DATETIMELOCAL},
+      {"1979-05-27T07:32:00.5", TOML_DATETIMELOCAL},
+      {"1979-05-27", TOML_DATELOCAL},
+      {"2000-02-29", TOML_DATELOCAL},
+      {"07:32:00", TOML_TIMELOCAL},
+      {"23:59:59.999999999", TOML_TIMELOCAL},
+      // a date then a comment, not a space separated datetime
+      {"1979-05-27 # comment", TOML_DATELOCAL},
+  };
+  for (size_t i = 0; i < sizeof(valid) / sizeof(valid[0]); i++)
+    CHECK(parse_type(valid[i].text) == valid[i].type);
+
+  static const char *invalid[] = {
+      "1900-02-29",
+      "2023-02-29",
+      "1979-04-31",
+      "1979-13-01",
+      "1979-00-10",
+      "1979-05-00",
+      "24:00:00",
+      "07:60:00",
+      "07:32:60",
+      "1979-05-27T07:32:00+24:00",
+      "1979-05-27T07:32:00+07:60",
+      "1979-05-27T07:32:00+0700",
+      "1979-05-27T07:32",
+      "1979-05-27T07:32:00.Z",
+      "1979-05-27T",
+      "1979-5-27",
+      "7:32:00",
+      "19790-05-27",
+  };
+  for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+    CHECK(parse_type(invalid[i]) == -1);
+
+  return CHECK_RESULT();
+}
@@ -0,0 +1,131 @@
+/*
+    A document read from a pipe, a few bytes at a time, parses the
+    same as the whole document in memory, keys, strings and numbers
+    far longer than the 64 bytes the stream keeps behind the cursor
+    included.
+*/
+
+// fdopen, pipe and fork are POSIX, not ISO C
+#define _POSIX_C_SOURCE 200809L
+
+#include "check.h"
+#include "mytoml.h"
+
+#ifdef _WIN32
+
+int main(void)
+{
+  return 0;
+}
+
+#else
+
+#include <stdio.h>     // for fdopen
+#include <stdlib.h>    // for malloc
+#include <string.h>    // for strcmp
+#include <sys/wait.h>  // for waitpid
+#include <unistd.h>    // for pipe, fork
+
+// writes a document of long tokens in varied layouts, returns its length
+static size_t write_document(char *doc, size_t size)
+{
+  size_t len = 0;
+  char word[512];
+  for (int i = 0; len + 2048 < size; i++)
+  {
+    int n = 70 + (i * 37) % 300;
+    for (int j = 0; j < n; j++)
+      word[j] = (char)('a' + (i + j) % 26);
+    word[n] = '\0';
+    const char *pad = i % 3 == 0 ? "" : i % 3 == 1 ? "   " : "\t";
+    switch (i % 6)
+    {
+    case 0:
+      len += (size_t)snprintf(doc + len, size - len, "%.*s%d%s=%s\"%s\"\n",
+                              100, word, i, pad, pad, word);
+      break;
+    case 1:
+      len += (size_t)snprintf(doc + len, size - len,
+                              "f%d = 3.%.*s1e-%d # %s\n", i, 60,
+                              "1415926535897932384626433832795028841971693993"
+                              "75105820974944592307816406286208998628034825",
+                              i % 300, word);
+      break;
+    case 2:
+      len += (size_t)snprintf(doc + len, size - len,
+                              "m%d = \"\"\"\n%s\\\n  %s\"\"\"\n", i, word, word);
+      break;
+    case 3:
+      len += (size_t)snprintf(doc + len, size - len, "[t%d.%.*s]%s\n", i, 90,
+                              word, pad);
+      break;
+    case 4:
+      len += (size_t)snprintf(doc + len, size - len,
+                              "a%d = [%s'%s',%s'''%s''' ]\n", i, pad, word,
+                              pad, word);
+      break;
+    default:
+      len += (size_t)snprintf(doc + len, size - len,
+                              "\"%s%d\" = 123_456_789_012_345_678\n", word, i);
+      break;
+    }
+  }
+  return len;
+}
+
+int main(void)
+{
+  size_t size = 256 * 1024;
+  char *doc = (char *)malloc(size);
+  CHECK(doc);
+  if (!doc)
+    return CHECK_RESULT();
+  size_t len = write_document(doc, size);
+
+  TomlKey *expected = toml_loadsn(doc, len);
+  CHECK(expected);
+  const char *expected_dump = expected ? toml_key_dumps(expected) : NULL;
+  CHECK(expected_dump);
+
+  int fds[2];
+  CHECK(pipe(fds) == 0);
+  pid_t child = fork();
+  CHECK(child >= 0);
+  if (child == 0)
+  {
+    // short writes keep the reader's buffer from ever holding a token
+    close(fds[0]);
+    for (size_t at = 0; at < len;)
+    {
+      size_t n = len - at < 7 ? len - at : 7;
+      ssize_t written = write(fds[1], doc + at, n);
+      if (written <= 0)
+        _exit(1);
+      at += (size_t)written;
+    }
+    close(fds[1]);
+    _exit(0);
+  }
+  close(fds[1]);
+  FILE *file = fdopen(fds[0], "r");
+  CHECK(file);
+  TomlKey *streamed = file ? toml_load_file(file) : NULL;
+  CHECK(streamed);
+  const char *dump = streamed ? toml_key_dumps(streamed) : NULL;
+  CHECK(dump && expected_dump && strcmp(dump, expected_dump) == 0);
+  if (file)
+    fclose(file);
+  int status = 0;
+  CHECK(waitpid(child, &status, 0) == child && WIFEXITED(status) &&
+        WEXITSTATUS(status) == 0);
+
+  free((void *)dump);
+  free((void *)expected_dump);
+  toml_free(streamed);
+  toml_free(expected);
+  free(doc);
+
+  return CHECK_RESULT();
+}
+
+#endif
@@ -0,0 +1,128 @@
+/*
+    String values are as long as the document makes them, in all
+    four string forms, escapes included, well past the 4 KB a string
+    used to be limited to, and whether they are read from memory or
+    through a `FILE *`.
+*/
+
+#include "check.h"
+#include "mytoml.h"
+
+#include <stdio.h>  // for tmpfile
+#include <stdlib.h> // for malloc
+#include <string.h> // for memcmp strlen
+
+// parses `text` from memory, or from a temporary file, and returns whether
+// `x` holds the `len` bytes of `expected`
+static bool check_string(const char *text, size_t size, const char *expected,
+                         size_t len, bool file)
+{
+  TomlKey *root = NULL;
+  if (file)
+  {
+    FILE *tmp = tmpfile();
+    if (!tmp)
+      return false;
+    fwrite(text, 1, size, tmp);
+    rewind(tmp);
+    root = toml_load_file(tmp);
+    fclose(tmp);
+  }
+  else
+  {
+    root = toml_loadsn(text, size);
+  }
+  TomlKey *x = root ? toml_get_key(root, "x") : NULL;
+  bool ok = x && x->value->type == TOML_STRING && x->value->len == len &&
+            memcmp(x->value->string, expected, len) == 0 &&
+            x->value->string[len] == '\0';
+  toml_free(root);
+  return ok;
+}
+
+int main(void)
+{
+  static const size_t lengths[] = {4095, 4096, 4097, 70000, 1 << 20};
+  for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+  {
+    size_t len = lengths[l];
+    char *expected = (char *)malloc(len);
+    char *text = (char *)malloc(2 * len + 64);
+    CHECK(expected && text);
+    if (!expected || !text)
+      return CHECK_RESULT();
+    for (size_t i = 0; i < len; i++)
+      expected[i] = (char)('a' + i % 26);
+
+    for (int file = 0; file < 2; file++)
+    {
+      // literal and multi-line literal strings are copied as they are
+      size_t size = (size_t)sprintf(text, "x = '");
+      memcpy(text + size, expected, len);
+      size += len;
+      size += (size_t)sprintf(text + size, "'\n");
+      CHECK(check_string(text, size, expected, len, file));
+      size = (size_t)sprintf(text, "x = '''\n");
+      memcpy(text + size, expected, len);
+      size += len;
+      size += (size_t)sprintf(text + size, "'''\n");
+      CHECK(check_string(text, size, expected, len, file));
+
+      // basic strings with an escape every so often
+      size = (size_t)sprintf(text, "x = \"");
+      for (size_t i = 0; i < len; i++)
+      {
+        if (i % 100 == 99)
+          size += (size_t)sprintf(text + size, "\\u%04x", expected[i]);
+        else
+          text[size++] = expected[i];
+      }
+      size += (size_t)sprintf(text + size, "\"\n");
+      CHECK(check_string(text, size, expected, len, file));
+
+      // multi-line basic strings with escaped line ends
+      size = (size_t)sprintf(text, "x = \"\"\"\n");
+      for (size_t i = 0; i < len; i++)
+      {
+        if (i % 1000 == 999)
+          size += (size_t)sprintf(text + size, "\\\n   ");
+        text[size++] = expected[i];
+      }
+      size += (size_t)sprintf(text + size, "\"\"\"\n");
+      CHECK(check_string(text, size, expected, len, file));
+    }
+    free(text);
+    free(expected);
+  }
+
+  // \u and \U take exactly 4 and 8 digits, hex digits after them included
+  static const struct
+  {
+    const char *text, *value;
+  } escapes[] = {
+      {"x = \"\\u0063d\"", "cd"},
+      {"x = \"\\u00e9f\"", "\xc3\xa9" "f"},
+      {"x = \"\\u20AC\"", "\xe2\x82\xac"},
+      {"x = \"\\U0001F600a\"", "\xf0\x9f\x98\x80" "a"},
+      {"x = \"\\u12\"", NULL},
+      {"x = \"\\U0000004\"", NULL},
+      {"x = \"\\uD800\"", NULL},
+      {"x = \"\\U00110000\"", NULL},
+  };
+  for (size_t i = 0; i < sizeof(escapes) / sizeof(escapes[0]); i++)
+  {
+    const char *value = escapes[i].value;
+    const char *text = escapes[i].text;
+    if (value)
+      CHECK(check_string(text, strlen(text), value, strlen(value), false));
+    else
+      CHECK(toml_loads(text) == NULL);
+  }
+
+  // a long string still has to be closed
+  static char open[8192] = "x = \"";
+  memset(open + 5, 'a', sizeof(open) - 6);
+  CHECK(toml_loadsn(open, sizeof(open) - 1) == NULL);
+
+  return CHECK_RESULT();
+}
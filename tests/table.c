@@ -0,0 +1,137 @@
+/*
+    A key keeps its first MYTOML_SMALL_TABLE_SIZE subkeys in a
+    small array and moves them into a hash table with the next
+    one. Lookups, iteration and duplicate detection have to work
+    the same on both sides of the move, for every way of adding
+    keys. Nothing caps how many subkeys a key holds.
+*/
+
+#include "check.h"
+#include "mytoml.h"
+
+#include <stdio.h>  // for snprintf
+#include <stdlib.h> // for malloc, free
+#include <string.h> // for strcmp, strstr
+
+#define KEYS (4 * MYTOML_SMALL_TABLE_SIZE + 3)
+
+// number of subkeys `toml_key_next` visits, each checked to be found by id
+static size_t visit(TomlKey *key)
+{
+  size_t n = 0, it = 0;
+  for (TomlKey *sub; (sub = toml_key_next(key, &it));)
+  {
+    CHECK(toml_get_key(key, sub->id.str) == sub);
+    n++;
+  }
+  return n;
+}
+
+// appends key `i` in the `style` given, returns the length it adds
+static size_t write_key(char *doc, size_t size, const char *style, int i)
+{
+  if (strcmp(style, "inline") == 0)
+    return (size_t)snprintf(doc, size, "%sk%d = %d", i ? ", " : "", i, i);
+  if (strcmp(style, "dotted") == 0)
+    return (size_t)snprintf(doc, size, "t.k%d = %d\n", i, i);
+  if (strcmp(style, "headers") == 0)
+    return (size_t)snprintf(doc, size, "[t.k%d]\nv = %d\n", i, i);
+  return (size_t)snprintf(doc, size, "k%d = %d\n", i, i);
+}
+
+// writes a table `t` of `n` keys in the `style` given, returns the length
+static size_t write_keys(char *doc, size_t size, int n, const char *style)
+{
+  size_t len = 0;
+  if (strcmp(style, "inline") == 0)
+    len += (size_t)snprintf(doc, size, "t = {");
+  else if (strcmp(style, "table") == 0)
+    len += (size_t)snprintf(doc, size, "[t]\n");
+  for (int i = 0; i < n; i++)
+    len += write_key(doc + len, size - len, style, i);
+  if (strcmp(style, "inline") == 0)
+    len += (size_t)snprintf(doc + len, size - len, "}\n");
+  return len;
+}
+
+int main(void)
+{
+  static const char *styles[] = {"table", "dotted", "headers", "inline"};
+  char doc[4096];
+  char id[16];
+  for (size_t s = 0; s < sizeof(styles) / sizeof(styles[0]); s++)
+  {
+    // every size up to well past the move, so each side is covered
+    for (int n = 1; n <= KEYS; n++)
+    {
+      size_t len = write_keys(doc, sizeof(doc), n, styles[s]);
+      TomlKey *root = toml_loadsn(doc, len);
+      CHECK(root);
+      TomlKey *t = root ? toml_get_key(root, "t") : NULL;
+      CHECK(t);
+      if (!t)
+      {
+        toml_free(root);
+        continue;
+      }
+      CHECK(visit(t) == (size_t)n);
+      for (int i = 0; i < n; i++)
+      {
+        snprintf(id, sizeof(id), "k%d", i);
+        CHECK(toml_get_key(t, id) != NULL);
+      }
+      snprintf(id, sizeof(id), "k%d", n);
+      CHECK(toml_get_key(t, id) == NULL);
+      CHECK(toml_get_key(t, "k") == NULL);
+      toml_free(root);
+
+      // the same key once more is an error, in the small table or the hash
+      if (strcmp(styles[s], "inline") != 0)
+      {
+        len += write_key(doc + len, sizeof(doc) - len, styles[s], n / 2);
+        root = toml_loadsn(doc, len);
+        CHECK(root == NULL);
+        toml_free(root);
+      }
+    }
+  }
+
+  // the move keeps the document intact, dumps included
+  size_t len = write_keys(doc, sizeof(doc), KEYS, "table");
+  TomlKey *root = toml_loadsn(doc, len);
+  CHECK(root);
+  TomlMemoryStats stats = toml_memory_stats(root);
+  CHECK(stats.key_count == KEYS + 2);
+  const char *dump = toml_key_dumps(root);
+  CHECK(dump);
+  for (int i = 0; dump && i < KEYS; i++)
+  {
+    snprintf(id, sizeof(id), "\"k%d\": ", i);
+    CHECK(strstr(dump, id) != NULL);
+  }
+  free((void *)dump);
+  toml_free(root);
+
+  // well past the 131072 subkeys a key used to be limited to
+  enum { MANY = 140000 };
+  char *many = (char *)malloc((size_t)MANY * 24);
+  CHECK(many);
+  if (!many)
+    return CHECK_RESULT();
+  len = 0;
+  for (int i = 0; i < MANY; i++)
+    len += (size_t)sprintf(many + len, "k%d = %d\n", i, i);
+  root = toml_loadsn(many, len);
+  CHECK(root && root->len == MANY);
+  for (int i = 0; root && i < MANY; i += 997)
+  {
+    snprintf(id, sizeof(id), "k%d", i);
+    TomlKey *k = toml_get_key(root, id);
+    CHECK(k && *toml_get_int64(k) == i);
+  }
+  CHECK(root && visit(root) == MANY);
+  toml_free(root);
+  free(many);
+
+  return CHECK_RESULT();
+}